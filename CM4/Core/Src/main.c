@@ -18,15 +18,47 @@
 /* USER CODE END Header */
 /* Includes ------------------------------------------------------------------*/
 #include "main.h"
+#include "dma.h"
+#include "i2c.h"
+#include "tim.h"
+#include "usart.h"
+#include "gpio.h"
 
 /* Private includes ----------------------------------------------------------*/
 /* USER CODE BEGIN Includes */
-
+#include "pwm.h"
+#include "pid.h"
+#include "i2c_lcd.h"
+#include "scheduler.h"
+#include "probe.h"
+#include "fmt.h"
+#include "serial.h"
+#include "telemetry.h"
+#include "cmd.h"
+#include "param.h"
+#include "mbox.h"
+#include "ipc.h"
+#include "hil.h"
+#include "clock.h"
+#include "utils.h"
 /* USER CODE END Includes */
 
 /* Private typedef -----------------------------------------------------------*/
 /* USER CODE BEGIN PTD */
-
+typedef enum {
+	TASK_SNAPSHOT = 0,
+	TASK_HMI,
+	TASK_TELEMETRY,
+	TASK_COMMAND
+} Task_IdTypeDef;
+
+typedef enum {
+	PROBE_LCD = 0,
+	PROBE_FORMAT,
+	PROBE_UART,
+	PROBE_MAILBOX,
+	PROBE_COUNT
+} Probe_IdTypeDef;
 /* USER CODE END PTD */
 
 /* Private define ------------------------------------------------------------*/
@@ -36,6 +68,13 @@
 #define HSEM_ID_0 (0U) /* HW semaphore 0*/
 #endif
 
+#define MBOX_TIMEOUT_MS   50U // the CM7 answers between two control periods
+#define SAMPLE_HSEM_ID    5U  // after the MBOX_HSEM_x semaphores, as in the CM7 image
+#define SAMPLE_RING_SIZE  16U // must match the CM7 image, checked at start
+#define HIL_STEP_S        0.05f // [s], plant integration step, the shortest control period
+#define LCD_TICK_HZ       1000000U // TIM7 counter clock, LCD waits are given in microseconds
+#define CLOCK_DRAIN_MS    250U  // longest wait for the UART and I2C to go idle before a profile switch
+
 /* USER CODE END PD */
 
 /* Private macro -------------------------------------------------------------*/
@@ -46,17 +85,483 @@
 /* Private variables ---------------------------------------------------------*/
 
 /* USER CODE BEGIN PV */
-
+I2C_LCD_HandleTypeDef hi2c_lcd1 = I2C_LCD_INIT_HANDLE(&hi2c1, &htim7, 0x27, 16, 2);
+uint8_t tx_buffer[256];
+uint8_t serial_tx_ring[2048] __attribute__((section(".dma_buffer"), aligned(32)));
+uint8_t serial_rx_ring[256] __attribute__((section(".dma_buffer"), aligned(32)));
+SERIAL_HandleTypeDef hserial3 = SERIAL_INIT_HANDLE(&huart3, serial_tx_ring, sizeof(serial_tx_ring),
+                                                   serial_rx_ring, sizeof(serial_rx_ring));
+CMD_HandleTypeDef hcmd1 = CMD_INIT_HANDLE();
+MBOX_SharedTypeDef hmbox1 __attribute__((section(".shared"), aligned(32)));
+HIL_SharedTypeDef hil1 __attribute__((section(".shared.hil"), aligned(32)));
+#ifdef HIL_MODE
+/* Estimates for the bare 5 W resistor, the defaults of the host simulator */
+PLANT_HandleTypeDef hplant1 = {
+	.Gain = 0.37f,
+	.Tau = 90.0f,
+	.DeadTime = 4.0f,
+	.Ambient = 22.0f,
+	.Ts = HIL_STEP_S
+};
+HIL_HandleTypeDef hhil1 = HIL_INIT_HANDLE(&hil1, &hplant1, 0.25f); // 2 mV rms over 64x oversampling
+uint32_t HilTimeMs = 0;
+int32_t HilDuty = 0;
+#endif
+MBOX_SnapshotTypeDef snapshot1;
+IPC_RING_DEFINE(sample_ring, sizeof(MBOX_SnapshotTypeDef), SAMPLE_RING_SIZE);
+IPC_HandleTypeDef hipc1 = IPC_INIT_HANDLE(sample_ring, sizeof(MBOX_SnapshotTypeDef), SAMPLE_HSEM_ID);
+int cnt = 1;
+int Edit = 0;
+volatile int SetPointConfirm = 0;
+float NewSetPoint = 0;
+int JitterReport = 0;
+int ProbeReport = 0;
+int TelemetryBinary = 0;
+PROBE_HandleTypeDef probes[PROBE_COUNT] = {
+	[PROBE_LCD]     = PROBE_INIT_HANDLE("lcd"),
+	[PROBE_FORMAT]  = PROBE_INIT_HANDLE("format"),
+	[PROBE_UART]    = PROBE_INIT_HANDLE("uart"),
+	[PROBE_MAILBOX] = PROBE_INIT_HANDLE("mailbox")
+};
+const PARAM_EntryTypeDef params[MBOX_PARAM_COUNT] = {
+	[MBOX_PARAM_PID_SP]     = PARAM_ENTRY("pid.sp",     PARAM_TYPE_FLOAT, 0, 100),      // [degC]
+	[MBOX_PARAM_PID_KP]     = PARAM_ENTRY("pid.kp",     PARAM_TYPE_FLOAT, 0, 1000),
+	[MBOX_PARAM_PID_KI]     = PARAM_ENTRY("pid.ki",     PARAM_TYPE_FLOAT, 0, 1000),     // [1/s]
+	[MBOX_PARAM_PID_KD]     = PARAM_ENTRY("pid.kd",     PARAM_TYPE_FLOAT, 0, 100),      // [s]
+	[MBOX_PARAM_PID_B]      = PARAM_ENTRY("pid.b",      PARAM_TYPE_FLOAT, 0, 1),
+	[MBOX_PARAM_PID_C]      = PARAM_ENTRY("pid.c",      PARAM_TYPE_FLOAT, 0, 1),
+	[MBOX_PARAM_PID_TF]     = PARAM_ENTRY("pid.tf",     PARAM_TYPE_FLOAT, 0, 10),       // [s] derivative filter
+	[MBOX_PARAM_PID_AW]     = PARAM_ENTRY("pid.aw",     PARAM_TYPE_INT,   0, PID_ANTIWINDUP_BACKCALC),
+	[MBOX_PARAM_PID_KT]     = PARAM_ENTRY("pid.kt",     PARAM_TYPE_FLOAT, 0, 100),      // [1/s]
+	[MBOX_PARAM_PID_IMAX]   = PARAM_ENTRY("pid.imax",   PARAM_TYPE_FLOAT, -100, 100),   // [%]
+	[MBOX_PARAM_PID_IMIN]   = PARAM_ENTRY("pid.imin",   PARAM_TYPE_FLOAT, -100, 100),   // [%]
+	[MBOX_PARAM_LM35_ALPHA] = PARAM_ENTRY("lm35.alpha", PARAM_TYPE_FLOAT, 0.01f, 1),
+	[MBOX_PARAM_PWM_MIN]    = PARAM_ENTRY("pwm.min",    PARAM_TYPE_INT,   0, PWM_DUTY_MAX), // [%]
+	[MBOX_PARAM_PWM_MAX]    = PARAM_ENTRY("pwm.max",    PARAM_TYPE_INT,   0, PWM_DUTY_MAX), // [%]
+	[MBOX_PARAM_LOOP_MS]    = PARAM_ENTRY("loop.ms",    PARAM_TYPE_INT,   50, 1000),    // control period, ADC rate limits the minimum
+	[MBOX_PARAM_CLK_PROFILE] = PARAM_ENTRY("clk.profile", PARAM_TYPE_INT, 0, CLK_PROFILE_COUNT - 1) // 0 nominal, 1 performance, 2 low power
+};
 /* USER CODE END PV */
 
 /* Private function prototypes -----------------------------------------------*/
 /* USER CODE BEGIN PFP */
-
+static void Snapshot_Task(void);
+static void HMI_Task(void);
+static void Telemetry_Task(void);
+static void Command_Task(void);
+static float Param_Get(uint8_t Id);
+static uint8_t Param_Set(uint8_t Id, float Value);
+static void Clock_Retime(void);
 /* USER CODE END PFP */
 
 /* Private user code ---------------------------------------------------------*/
 /* USER CODE BEGIN 0 */
+SCHED_TaskTypeDef tasks[] = {
+	[TASK_SNAPSHOT]  = SCHED_TASK_INIT(Snapshot_Task),
+	[TASK_HMI]       = SCHED_TASK_INIT(HMI_Task),
+	[TASK_TELEMETRY] = SCHED_TASK_INIT(Telemetry_Task),
+	[TASK_COMMAND]   = SCHED_TASK_INIT(Command_Task)
+};
+PARAM_HandleTypeDef hparam1 = PARAM_INIT_HANDLE(params, MBOX_PARAM_COUNT, Param_Get, Param_Set);
+SCHED_HandleTypeDef hsched1 = SCHED_INIT_HANDLE(tasks);
+
+void HAL_GPIO_EXTI_Callback(uint16_t GPIO_Pin)
+{
+	if (GPIO_Pin == Button_Pin)
+	{
+		if (Edit == 0)
+		{
+			Edit = 1;
+			HAL_GPIO_WritePin(LED1_GPIO_Port, LED1_Pin, GPIO_PIN_SET);
+		}
+		else
+		{
+			Edit = 0;
+			// The mailbox call waits for the CM7, so the new reference is written from the command task
+			SetPointConfirm = 1;
+			SCHED_Release(&hsched1, TASK_COMMAND);
+			HAL_GPIO_WritePin(LED1_GPIO_Port, LED1_Pin, GPIO_PIN_RESET);
+		}
+	}
+}
+void HAL_UARTEx_RxEventCallback(UART_HandleTypeDef *huart, uint16_t Size)
+{
+	if (huart == hserial3.huart)
+	{
+		SERIAL_RxEventCallback(&hserial3, Size);
+		SCHED_Release(&hsched1, TASK_COMMAND);
+	}
+}
+void HAL_UART_TxCpltCallback(UART_HandleTypeDef *huart)
+{
+	if (huart == hserial3.huart)
+	{
+		SERIAL_TxCpltCallback(&hserial3);
+	}
+}
+void HAL_UART_ErrorCallback(UART_HandleTypeDef *huart)
+{
+	if (huart == hserial3.huart)
+	{
+		SERIAL_ErrorCallback(&hserial3);
+		SCHED_Release(&hsched1, TASK_COMMAND); // restarts a stopped reception
+	}
+}
+
+void HAL_I2C_MasterTxCpltCallback(I2C_HandleTypeDef *hi2c)
+{
+	if (hi2c == hi2c_lcd1.hi2c)
+	{
+		I2C_LCD_TxCpltCallback(&hi2c_lcd1);
+	}
+}
+
+void HAL_I2C_MasterRxCpltCallback(I2C_HandleTypeDef *hi2c)
+{
+	if (hi2c == hi2c_lcd1.hi2c)
+	{
+		I2C_LCD_RxCpltCallback(&hi2c_lcd1);
+	}
+}
+
+void HAL_I2C_ErrorCallback(I2C_HandleTypeDef *hi2c)
+{
+	if (hi2c == hi2c_lcd1.hi2c)
+	{
+		I2C_LCD_ErrorCallback(&hi2c_lcd1);
+	}
+}
+
+void HAL_TIM_PeriodElapsedCallback(TIM_HandleTypeDef *htim)
+{
+	if (htim == hi2c_lcd1.htim)
+	{
+		I2C_LCD_WaitElapsedCallback(&hi2c_lcd1);
+	}
+}
+
+void HAL_HSEM_FreeCallback(uint32_t SemMask)
+{
+	if (SemMask & MBOX_SEM_MASK(MBOX_HSEM_SNAPSHOT))
+	{
+		// The interrupt handler disables the notification, it has to be armed again
+		HAL_HSEM_ActivateNotification(MBOX_SEM_MASK(MBOX_HSEM_SNAPSHOT));
+		SCHED_Release(&hsched1, TASK_SNAPSHOT);
+	}
+	if (SemMask & MBOX_SEM_MASK(SAMPLE_HSEM_ID))
+	{
+		HAL_HSEM_ActivateNotification(MBOX_SEM_MASK(SAMPLE_HSEM_ID));
+		SCHED_Release(&hsched1, TASK_TELEMETRY);
+	}
+}
+
+static void Snapshot_Task(void)
+{
+	// A snapshot that kept changing under the copy is skipped, the next notification follows
+	if (!MBOX_Read(&hmbox1, &snapshot1)) return;
+
+#ifdef HIL_MODE
+	// The plant runs in the CM7 time: the duty of the previous snapshot heated it until this one
+	if (!HIL_IsActive(&hil1)) HIL_Init(&hhil1);
+	else HIL_Update(&hhil1, (float)HilDuty, (float)(snapshot1.TimeMs - HilTimeMs) / 1000.0f);
+	HilTimeMs = snapshot1.TimeMs;
+	HilDuty = snapshot1.Duty;
+#endif
 
+	NewSetPoint = (float)snapshot1.PotRaw/1000;
+
+	if (cnt%3 == 0)
+	{
+		cnt = 1;
+		SCHED_Release(&hsched1, TASK_HMI);
+	}
+	else cnt++;
+}
+
+static void HMI_Task(void)
+{
+	char result[17];
+	FMT_HandleTypeDef hfmt;
+	PROBE_START(&probes[PROBE_LCD]);
+	FMT_Init(&hfmt, result, sizeof(result));
+	FMT_String(&hfmt, "TEMP: ");
+	FMT_Float(&hfmt, snapshot1.Temperature, 1, 0, ' ');
+	FMT_String(&hfmt, "   ");
+	I2C_LCD_Print(&hi2c_lcd1, 0, 0, result);
+	FMT_Init(&hfmt, result, sizeof(result));
+	FMT_String(&hfmt, "PWM:  ");
+	FMT_Int(&hfmt, snapshot1.Duty, 0, ' ');
+	FMT_String(&hfmt, "%   ");
+	I2C_LCD_Print(&hi2c_lcd1, 0, 1, result);
+	FMT_Init(&hfmt, result, sizeof(result));
+	FMT_Float(&hfmt, snapshot1.SetPoint, 1, 0, ' ');
+	FMT_String(&hfmt, "   ");
+	I2C_LCD_Print(&hi2c_lcd1, 12, 0, result);
+	if (Edit == 1)
+	{
+		FMT_Init(&hfmt, result, sizeof(result));
+		FMT_Float(&hfmt, NewSetPoint, 1, 0, ' ');
+		FMT_Char(&hfmt, ' ');
+		I2C_LCD_Print(&hi2c_lcd1, 12, 1, result);
+	}
+	else
+	{
+		I2C_LCD_Print(&hi2c_lcd1, 12, 1, "    ");
+	}
+	// Only the cells that changed since the last update go out on the bus
+	I2C_LCD_Flush(&hi2c_lcd1);
+	PROBE_STOP(&probes[PROBE_LCD]);
+}
+
+static void Mailbox_Report(uint8_t Report)
+{
+	MBOX_MessageTypeDef message = { .Request = MBOX_REQUEST_REPORT, .Id = Report };
+
+	PROBE_START(&probes[PROBE_MAILBOX]);
+	HAL_StatusTypeDef status = MBOX_Call(&hmbox1, &message, MBOX_TIMEOUT_MS);
+	PROBE_STOP(&probes[PROBE_MAILBOX]);
+	if (status == HAL_OK && message.Status)
+	{
+		// Copied into the ring before the next call can overwrite the shared text
+		SERIAL_Write(&hserial3, (const uint8_t*)hmbox1.Report, message.Length);
+	}
+	else
+	{
+		SERIAL_Write(&hserial3, (const uint8_t*)"err mailbox\n", 12);
+	}
+}
+
+static void Telemetry_Send(const MBOX_SnapshotTypeDef* Sample)
+{
+	FMT_HandleTypeDef hfmt;
+	int tx_n;
+
+	PROBE_START(&probes[PROBE_FORMAT]);
+	if (TelemetryBinary)
+	{
+		TELEMETRY_SampleTypeDef frame = {
+			.Sequence = (uint16_t)Sample->Period, // a sample lost anywhere shows as a gap
+			.TimeMs = Sample->TimeMs,
+			.AdcRaw = Sample->AdcRaw,
+			.Duty = (uint16_t)Sample->Duty,
+			.Temperature = Sample->Temperature,
+			.SetPoint = Sample->SetPoint,
+			.P = Sample->P,
+			.I = Sample->I,
+			.D = Sample->D
+		};
+		tx_n = TELEMETRY_Encode(&frame, tx_buffer);
+	}
+	else
+	{
+		FMT_Init(&hfmt, (char*)tx_buffer, sizeof(tx_buffer));
+		FMT_String(&hfmt, "T: ");
+		FMT_Float(&hfmt, Sample->Temperature, 1, 0, ' ');
+		FMT_String(&hfmt, ", PWM: ");
+		FMT_Int(&hfmt, Sample->Duty, 0, ' ');
+		FMT_String(&hfmt, ", S: ");
+		FMT_Float(&hfmt, Sample->SetPoint, 1, 0, ' ');
+		FMT_String(&hfmt, ", P: ");
+		FMT_Float(&hfmt, Sample->Params[MBOX_PARAM_PID_KP], 3, 0, ' ');
+		FMT_String(&hfmt, ", I: ");
+		FMT_Float(&hfmt, Sample->Params[MBOX_PARAM_PID_KI], 3, 0, ' ');
+		FMT_String(&hfmt, ", D: ");
+		FMT_Float(&hfmt, Sample->Params[MBOX_PARAM_PID_KD], 3, 0, ' ');
+		tx_n = FMT_String(&hfmt, "   \n");
+	}
+	PROBE_STOP(&probes[PROBE_FORMAT]);
+
+	// Queued for the DMA, the line goes out while the next periods run
+	PROBE_START(&probes[PROBE_UART]);
+	SERIAL_Write(&hserial3, tx_buffer, tx_n);
+	PROBE_STOP(&probes[PROBE_UART]);
+}
+
+static void Telemetry_Task(void)
+{
+	MBOX_SnapshotTypeDef sample;
+	FMT_HandleTypeDef hfmt;
+	int tx_n;
+	uint16_t budget = hipc1.Count; // one ring per release, the next push releases again
+
+	// Every control period is sent, even when the CM4 was late for some of them
+	while (budget > 0 && IPC_Pop(&hipc1, &sample))
+	{
+		budget--;
+		Telemetry_Send(&sample);
+	}
+
+	if (JitterReport == 1)
+	{
+		JitterReport = 0;
+		Mailbox_Report(MBOX_REPORT_JITTER);
+	}
+
+	if (ProbeReport != 0)
+	{
+		// CM7 probes first, then the local ones
+		Mailbox_Report((ProbeReport == 2) ? MBOX_REPORT_PROBES_RESET : MBOX_REPORT_PROBES);
+		for (int i = 0; i < PROBE_COUNT; i++)
+		{
+			tx_n = PROBE_Format(&probes[i], (char*)tx_buffer, sizeof(tx_buffer));
+			SERIAL_Write(&hserial3, tx_buffer, tx_n);
+			if (ProbeReport == 2) PROBE_Reset(&probes[i]);
+		}
+		FMT_Init(&hfmt, (char*)tx_buffer, sizeof(tx_buffer));
+		FMT_String(&hfmt, "serial: DROPPED: ");
+		FMT_UInt(&hfmt, hserial3.TxDroppedBytes, 0, ' ');
+		FMT_String(&hfmt, " B in ");
+		FMT_UInt(&hfmt, hserial3.TxDroppedWrites, 0, ' ');
+		FMT_String(&hfmt, ", HIGH: ");
+		FMT_UInt(&hfmt, hserial3.TxHighWater, 0, ' ');
+		FMT_String(&hfmt, "/");
+		FMT_UInt(&hfmt, hserial3.TxSize, 0, ' ');
+		tx_n = FMT_String(&hfmt, " B\n");
+		SERIAL_Write(&hserial3, tx_buffer, tx_n);
+		FMT_Init(&hfmt, (char*)tx_buffer, sizeof(tx_buffer));
+		FMT_String(&hfmt, "ipc: DROPPED: ");
+		FMT_UInt(&hfmt, hipc1.Ring->Dropped, 0, ' ');
+		FMT_String(&hfmt, " samples of ");
+		FMT_UInt(&hfmt, hipc1.Count, 0, ' ');
+		tx_n = FMT_String(&hfmt, " slots\n");
+		SERIAL_Write(&hserial3, tx_buffer, tx_n);
+		ProbeReport = 0;
+	}
+}
+
+static float Param_Get(uint8_t Id)
+{
+	// Values of the last snapshot, a set below also updates its entry with the value read back
+	return snapshot1.Params[Id];
+}
+
+static uint8_t Clock_Drain(void)
+{
+	uint32_t start = HAL_GetTick();
+
+	// Runs from the command task, so no task queues anything new; the interrupts finish the transfers
+	while (hserial3.TxBusy || hserial3.TxHead != hserial3.TxTail || I2C_LCD_IsBusy(&hi2c_lcd1))
+	{
+		if (HAL_GetTick() - start > CLOCK_DRAIN_MS) return 0;
+	}
+	return 1;
+}
+
+static void Clock_Retime(void)
+{
+	uint32_t pclk1;
+
+	// HAL_Init read the clocks at start, a profile switch by the CM7 changes them under this core
+	SystemCoreClockUpdate();
+	HAL_InitTick(uwTickPrio);
+	pclk1 = HAL_RCC_GetPCLK1Freq();
+
+	if (CLK_SetTimerTick(&htim7, LCD_TICK_HZ) != HAL_OK)
+	{
+		Error_Handler();
+	}
+	// The one-pulse timer is idle: load the prescaler now, URS keeps the wait callback out of it
+	SET_BIT(htim7.Instance->CR1, TIM_CR1_URS);
+	HAL_TIM_GenerateEvent(&htim7, TIM_EVENTSOURCE_UPDATE);
+	CLEAR_BIT(htim7.Instance->CR1, TIM_CR1_URS);
+
+	hi2c1.Init.Timing = CLK_GetI2CTiming(pclk1);
+	if (HAL_I2C_Init(&hi2c1) != HAL_OK || SERIAL_Retime(&hserial3, pclk1) != HAL_OK)
+	{
+		Error_Handler();
+	}
+	for (int i = 0; i < PROBE_COUNT; i++) PROBE_Reset(&probes[i]);
+}
+
+static uint8_t Param_Set(uint8_t Id, float Value)
+{
+	MBOX_MessageTypeDef message = { .Request = MBOX_REQUEST_SET, .Id = Id, .Value = Value };
+
+	// The kernel clocks of the UART and I2C change with the profile, nothing may be on the wire
+	if (Id == MBOX_PARAM_CLK_PROFILE && !Clock_Drain()) return 0;
+
+	// The handles live on the CM7, which applies the value between two control periods
+	PROBE_START(&probes[PROBE_MAILBOX]);
+	HAL_StatusTypeDef status = MBOX_Call(&hmbox1, &message, MBOX_TIMEOUT_MS);
+	PROBE_STOP(&probes[PROBE_MAILBOX]);
+	// Also after a timeout: the clocks are read back, retiming for an unchanged profile is harmless
+	if (Id == MBOX_PARAM_CLK_PROFILE) Clock_Retime();
+	if (status != HAL_OK) return 0;
+	snapshot1.Params[Id] = message.Value;
+	return message.Status;
+}
+
+static void Command_Reply(const char* Line, size_t Length)
+{
+	SERIAL_Write(&hserial3, (const uint8_t*)Line, (uint16_t)Length);
+}
+
+static void Command_Execute(void)
+{
+	CMD_ArgTypeDef args[CMD_ARGS_MAX];
+	uint8_t n = CMD_Tokenize(&hcmd1, args, CMD_ARGS_MAX);
+	PARAM_StatusTypeDef status = PARAM_OK;
+	char reply[32];
+	FMT_HandleTypeDef hfmt;
+	uint8_t i;
+
+	// get, set and list reply themselves
+	if (PARAM_Command(&hparam1, args, n, Command_Reply)) return;
+
+	// Short commands, executed in order up to the first failure
+	for (i = 0; i < n; i++)
+	{
+		float value = 0;
+		uint8_t id = PARAM_NOT_FOUND;
+		if (args[i].Value[0] != '\0' && !CMD_ParseFloat(args[i].Value, &value)) status = PARAM_ERROR_VALUE;
+		else if (CMD_IsName(&args[i], "s")) id = MBOX_PARAM_PID_SP;
+		else if (CMD_IsName(&args[i], "p")) id = MBOX_PARAM_PID_KP;
+		else if (CMD_IsName(&args[i], "i")) id = MBOX_PARAM_PID_KI;
+		else if (CMD_IsName(&args[i], "d")) id = MBOX_PARAM_PID_KD;
+		else if (CMD_IsName(&args[i], "j")) JitterReport = 1;
+		else if (CMD_IsName(&args[i], "m")) ProbeReport = (value > 0) ? 2 : 1; // m dumps, m1 also resets the probes
+		else if (CMD_IsName(&args[i], "t")) TelemetryBinary = (value > 0);  // t0 text lines, t1 COBS frames
+		else status = PARAM_ERROR_UNKNOWN;
+
+		if (id != PARAM_NOT_FOUND)
+		{
+			status = (args[i].Value[0] != '\0') ? PARAM_Set(&hparam1, id, value) : PARAM_ERROR_VALUE;
+		}
+		if (status != PARAM_OK) break;
+	}
+
+	FMT_Init(&hfmt, reply, sizeof(reply));
+	FMT_String(&hfmt, (status == PARAM_OK) ? "ok" : "err ");
+	if (status != PARAM_OK)
+	{
+		FMT_String(&hfmt, PARAM_StatusName(status));
+		FMT_Char(&hfmt, ' ');
+		for (uint8_t k = 0; k < args[i].NameLength && k < 16U; k++) FMT_Char(&hfmt, args[i].Name[k]);
+	}
+	Command_Reply(reply, FMT_Char(&hfmt, '\n'));
+}
+
+static void Command_Task(void)
+{
+	uint8_t rx[32];
+	uint16_t n;
+	uint16_t budget = hserial3.RxSize; // one ring per release, the next receive event releases again
+
+	if (SetPointConfirm)
+	{
+		SetPointConfirm = 0;
+		PARAM_Set(&hparam1, MBOX_PARAM_PID_SP, NewSetPoint);
+	}
+
+	while (budget > 0 && (n = SERIAL_Read(&hserial3, rx, (budget < sizeof(rx)) ? budget : sizeof(rx))) > 0)
+	{
+		budget -= n;
+		for (uint16_t i = 0; i < n; i++)
+		{
+			if (CMD_Feed(&hcmd1, (char)rx[i])) Command_Execute();
+		}
+	}
+}
 /* USER CODE END 0 */
 
 /**
@@ -99,8 +604,26 @@ int main(void)
   /* USER CODE END SysInit */
 
   /* Initialize all configured peripherals */
+  MX_GPIO_Init();
+  MX_DMA_Init();
+  MX_USART3_UART_Init();
+  MX_I2C1_Init();
+  MX_TIM7_Init();
   /* USER CODE BEGIN 2 */
-
+  DWT_Init();
+  /* CubeMX timings assume 64 MHz, the CM7 may have started another profile */
+  Clock_Retime();
+  /* The CM7 prepares the mailbox before it releases this core */
+  if (!MBOX_IsReady(&hmbox1) || !IPC_IsReady(&hipc1))
+  {
+    Error_Handler();
+  }
+  /* Each published snapshot drives the display, each queued sample the telemetry */
+  HAL_HSEM_ActivateNotification(MBOX_SEM_MASK(MBOX_HSEM_SNAPSHOT));
+  HAL_HSEM_ActivateNotification(MBOX_SEM_MASK(SAMPLE_HSEM_ID));
+  I2C_LCD_Init(&hi2c_lcd1);
+  I2C_LCD_SetBusyPolling(&hi2c_lcd1, 1);
+  SERIAL_StartReceive(&hserial3);
   /* USER CODE END 2 */
 
   /* Infinite loop */
@@ -110,6 +633,7 @@ int main(void)
     /* USER CODE END WHILE */
 
     /* USER CODE BEGIN 3 */
+	  SCHED_Dispatch(&hsched1);
   }
   /* USER CODE END 3 */
 }
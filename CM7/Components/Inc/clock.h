@@ -0,0 +1,97 @@
+/**
+  ******************************************************************************
+  * @file     : clock.h
+  * @author   : MS    Mateusz.Stasiak@student.put.poznan.pl
+  * @version  : 1.0.0
+  * @date     : Oct 17, 2026
+  * @brief    : System clock profiles and the peripheral timings derived from them.
+  *
+  ******************************************************************************
+  */
+
+#ifndef INC_CLOCK_H_
+#define INC_CLOCK_H_
+
+/*
+ * A profile sets SYSCLK, the bus dividers, the regulator scale and the flash
+ * latency in one go. HSI (64 MHz) stays on in every profile and stays the
+ * PLL source, so PLL2 and the ADC kernel clock never change.
+ *
+ *  Profile      CM7      HCLK, CM4  APBx     VOS   Flash
+ *  NOMINAL      64 MHz   64 MHz     32/64    3     1 WS  HSI, as generated by CubeMX
+ *  PERFORMANCE  400 MHz  200 MHz    100 MHz  1     2 WS  PLL1P
+ *  LOW_POWER    16 MHz   16 MHz     16 MHz   3     0 WS  HSI / 4 (D1CPRE)
+ *
+ * The board runs from the SMPS alone (PWR_DIRECT_SMPS_SUPPLY), which rules
+ * out VOS0 and with it the 480 MHz of the device.
+ *
+ * SystemCoreClock and the SysTick of the switching core follow the change
+ * (HAL_RCC_ClockConfig); everything else that counts bus or kernel clocks is
+ * retimed by its owner: CLK_SetTimerTick for the timers, CLK_GetI2CTiming
+ * for I2C, SERIAL_Retime for the UART, SystemCoreClockUpdate and
+ * HAL_InitTick on the other core.
+ */
+
+/* Public includes -----------------------------------------------------------*/
+#include "stdint.h"
+#ifdef USE_HAL_DRIVER
+#include "stm32h7xx_hal.h"
+#endif
+
+/* Public typedef ------------------------------------------------------------*/
+typedef enum {
+	CLK_PROFILE_NOMINAL = 0,
+	CLK_PROFILE_PERFORMANCE,
+	CLK_PROFILE_LOW_POWER,
+	CLK_PROFILE_COUNT
+} CLK_ProfileTypeDef;
+
+/* Public define -------------------------------------------------------------*/
+#define CLK_I2C_STANDARD_HZ  100000U // bus speed CLK_GetI2CTiming is computed for
+
+/* Public macro --------------------------------------------------------------*/
+
+/* Public variables ----------------------------------------------------------*/
+
+/* Public function prototypes ------------------------------------------------*/
+/**
+ * @brief Switches the system clock to a profile.
+ * @param Profile One of CLK_ProfileTypeDef.
+ * @return HAL_OK, HAL_ERROR for an unknown profile or a failed switch (SYSCLK is then HSI).
+ * @note CM7 only. Passes through the nominal HSI configuration, the clock stops for
+ *       the PLL lock (under 0.1 ms). The caller retimes the peripherals afterwards.
+ */
+HAL_StatusTypeDef CLK_SetProfile(CLK_ProfileTypeDef Profile);
+
+/**
+ * @brief Returns the profile the system clock runs in.
+ * @return One of CLK_ProfileTypeDef, CLK_PROFILE_COUNT if the configuration matches none.
+ * @note Read back from the RCC, so the other core gets the same answer.
+ */
+CLK_ProfileTypeDef CLK_GetProfile(void);
+
+/**
+ * @brief Returns the counter clock of a timer before its prescaler.
+ * @param htim Pointer to the TIM_HandleTypeDef structure.
+ * @return Timer kernel clock [Hz].
+ */
+uint32_t CLK_GetTimerFreq(const TIM_HandleTypeDef* htim);
+
+/**
+ * @brief Sets the prescaler so that the timer counts at TickHz.
+ * @param htim Pointer to the TIM_HandleTypeDef structure.
+ * @param TickHz Counter clock [Hz], a divisor of the timer kernel clock.
+ * @return HAL_OK, or HAL_ERROR if the ratio does not fit the 16-bit prescaler.
+ * @note The prescaler is buffered: it takes effect at the next update event, the
+ *       period in progress still runs at the old rate. htim->Init.Prescaler follows.
+ */
+HAL_StatusTypeDef CLK_SetTimerTick(TIM_HandleTypeDef* htim, uint32_t TickHz);
+
+/**
+ * @brief Computes the I2C TIMINGR value for a standard-mode bus.
+ * @param KernelHz I2C kernel clock [Hz].
+ * @return Value for hi2c->Init.Timing (CLK_I2C_STANDARD_HZ at most, analog filter on).
+ */
+uint32_t CLK_GetI2CTiming(uint32_t KernelHz);
+
+#endif /* INC_CLOCK_H_ */
@@ -0,0 +1,97 @@
+/**
+  ******************************************************************************
+  * @file     : cmd.h
+  * @author   : MS    Mateusz.Stasiak@student.put.poznan.pl
+  * @version  : 1.0.0
+  * @date     : Oct 17, 2026
+  * @brief    : Line assembler and bounded-time tokenizer for text commands.
+  *
+  ******************************************************************************
+  */
+
+#ifndef INC_CMD_H_
+#define INC_CMD_H_
+
+/*
+ * A command line ends with '\n' or '\r' and holds one or more arguments
+ * separated by spaces, tabs, ',' or ';':
+ *
+ *   s=35.5 p=60 i=40.25     name=value pairs
+ *   s35.5                   a single letter followed directly by a number
+ *   j                       a name without a value
+ *
+ * Lines longer than CMD_LINE_MAX-1 and lines with control characters are
+ * discarded up to the next terminator, so a corrupted or partial line never
+ * merges with the one that follows.
+ */
+
+/* Public includes -----------------------------------------------------------*/
+#include "stdint.h"
+
+/* Public typedef ------------------------------------------------------------*/
+#define CMD_LINE_MAX  96 // including the terminating null
+
+typedef struct {
+	const char *Name;    // not null-terminated, see NameLength
+	uint8_t NameLength;
+	const char *Value;   // null-terminated, empty when the argument has no value
+} CMD_ArgTypeDef;
+
+typedef struct {
+	char Line[CMD_LINE_MAX];
+	uint8_t Length;
+	uint8_t Ready;       // Line holds a complete line, the next byte starts a new one
+	uint8_t Discard;     // skipping the rest of a rejected line
+	uint32_t Lines;      // complete lines returned
+	uint32_t Rejected;   // lines dropped as too long or corrupted
+} CMD_HandleTypeDef;
+
+/* Public define -------------------------------------------------------------*/
+#define CMD_ARGS_MAX  8
+
+/* Public macro --------------------------------------------------------------*/
+#define CMD_INIT_HANDLE() \
+  {                       \
+    .Length = 0           \
+  }
+
+/* Public variables ----------------------------------------------------------*/
+
+/* Public function prototypes ------------------------------------------------*/
+/**
+ * @brief Adds one received character to the line being assembled.
+ * @param hcmd Pointer to the CMD_HandleTypeDef structure.
+ * @param Ch Received character.
+ * @return 1 when a non-empty line is complete in hcmd->Line, 0 otherwise.
+ * @note Constant time. The line stays valid until the next call.
+ */
+uint8_t CMD_Feed(CMD_HandleTypeDef* hcmd, char Ch);
+
+/**
+ * @brief Splits the complete line into arguments, in place.
+ * @param hcmd Pointer to the CMD_HandleTypeDef structure.
+ * @param Args Output array.
+ * @param MaxArgs Capacity of Args.
+ * @return Number of arguments; arguments beyond MaxArgs are ignored.
+ * @note Linear in the line length, at most CMD_LINE_MAX steps.
+ */
+uint8_t CMD_Tokenize(CMD_HandleTypeDef* hcmd, CMD_ArgTypeDef* Args, uint8_t MaxArgs);
+
+/**
+ * @brief Checks the name of an argument.
+ * @param Arg Pointer to the argument.
+ * @param Name Null-terminated name to compare with.
+ * @return 1 if the names are equal, 0 otherwise.
+ */
+uint8_t CMD_IsName(const CMD_ArgTypeDef* Arg, const char* Name);
+
+/**
+ * @brief Parses a decimal number such as "-12", "35.5" or ".25".
+ * @param Str Null-terminated string, the whole string must be the number.
+ * @param Value Output, written only on success.
+ * @return 1 on success, 0 if the string is not a number.
+ * @note No exponent, no locale; digits past the 18th significant one only count for the scale.
+ */
+uint8_t CMD_ParseFloat(const char* Str, float* Value);
+
+#endif /* INC_CMD_H_ */
@@ -0,0 +1,67 @@
+/**
+  ******************************************************************************
+  * @file     : control.h
+  * @author   : MS    Mateusz.Stasiak@student.put.poznan.pl
+  * @version  : 1.0.0
+  * @date     : Oct 17, 2026
+  * @brief    : One control period: LM35 reading, PID and PWM with saturation feedback.
+  *
+  ******************************************************************************
+  */
+
+#ifndef INC_CONTROL_H_
+#define INC_CONTROL_H_
+
+/*
+ * The step is shared by Control_Task on the CM7 and the host simulator, so
+ * the simulated loop is the one the target runs. Publishing the result is left
+ * to the caller. The probes time the sensor, controller and output stages on
+ * the target; the simulator leaves them NULL.
+ */
+
+/* Public includes -----------------------------------------------------------*/
+#include "stdint.h"
+#include "stm32h7xx_hal.h"
+#include "lm35.h"
+#include "pid.h"
+#include "pwm.h"
+#include "probe.h"
+
+/* Public typedef ------------------------------------------------------------*/
+typedef struct {
+	ADC_HandleTypeDef *Adc;            // LM35 converter
+	LM35_Filter_HandleTypeDef *Filter;
+	PID_HandleTypeDef *Pid;
+	PWM_HandleTypeDef *Pwm;
+	PROBE_HandleTypeDef *ProbeLm35;    // optional, NULL when not profiled
+	PROBE_HandleTypeDef *ProbePid;
+	PROBE_HandleTypeDef *ProbePwm;
+} CONTROL_HandleTypeDef;
+
+/* Public define -------------------------------------------------------------*/
+
+/* Public macro --------------------------------------------------------------*/
+#define CONTROL_INIT_HANDLE(ADC, FILTER, PID, PWM) \
+  {                                                \
+    .Adc = ADC,                                    \
+    .Filter = FILTER,                              \
+    .Pid = PID,                                    \
+    .Pwm = PWM                                     \
+  }
+
+/* Public variables ----------------------------------------------------------*/
+
+/* Public function prototypes ------------------------------------------------*/
+/**
+ * @brief Runs one control period from the latest LM35 reading to the PWM compare value.
+ * @param hcontrol Pointer to the CONTROL_HandleTypeDef structure.
+ * @param Timestamp PID_TIMESTAMP() value of the DMA event that completed the samples.
+ * @param AdcRaw Output, the raw LM35 code the temperature was converted from.
+ * @param Temperature Output, filtered temperature the controller used [degC].
+ * @return Applied PWM duty [%], after saturation to the PWM limits.
+ * @note The applied duty is fed back to the PID as its output, so saturation does not wind
+ *       the integrator up; truncation to a whole percent is not treated as saturation.
+ */
+int CONTROL_Step(CONTROL_HandleTypeDef* hcontrol, uint32_t Timestamp, uint16_t* AdcRaw, float* Temperature);
+
+#endif /* INC_CONTROL_H_ */
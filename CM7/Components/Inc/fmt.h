@@ -0,0 +1,99 @@
+/**
+  ******************************************************************************
+  * @file     : fmt.h
+  * @author   : MS    Mateusz.Stasiak@student.put.poznan.pl
+  * @version  : 1.0.0
+  * @date     : Oct 17, 2026
+  * @brief    : Allocation-free text formatting of integers and fixed-point floats.
+  *
+  ******************************************************************************
+  */
+
+#ifndef INC_FMT_H_
+#define INC_FMT_H_
+
+/* Public includes -----------------------------------------------------------*/
+#include "stdint.h"
+#include "stddef.h"
+
+/* Public typedef ------------------------------------------------------------*/
+typedef struct {
+	char *Buffer;
+	size_t Size;   // capacity including the terminating null
+	size_t Length; // characters written so far, excluding the terminating null
+} FMT_HandleTypeDef;
+
+/* Public define -------------------------------------------------------------*/
+#define FMT_MAX_DECIMALS  6             // more is below the float resolution
+#define FMT_FLOAT_LIMIT   4294967296.0  // 2^32, |Value| from here on is printed as '#'
+
+/* Public macro --------------------------------------------------------------*/
+#define FMT_INIT_HANDLE(BUFFER, SIZE) \
+  {                                   \
+    .Buffer = BUFFER,                 \
+    .Size = SIZE                      \
+  }
+
+/* Public variables ----------------------------------------------------------*/
+
+/* Public function prototypes ------------------------------------------------*/
+/**
+ * @brief Starts a new text in the buffer.
+ * @param hfmt Pointer to the FMT_HandleTypeDef structure.
+ * @param Buffer Destination buffer.
+ * @param Size Size of the destination buffer in bytes, at least 1.
+ */
+void FMT_Init(FMT_HandleTypeDef* hfmt, char* Buffer, size_t Size);
+
+/**
+ * @brief Appends a null-terminated string.
+ * @param hfmt Pointer to the FMT_HandleTypeDef structure.
+ * @param Str String to append.
+ * @return Length of the text after appending.
+ * @note All FMT functions truncate at the end of the buffer and keep the text null-terminated.
+ */
+size_t FMT_String(FMT_HandleTypeDef* hfmt, const char* Str);
+
+/**
+ * @brief Appends a single character.
+ * @param hfmt Pointer to the FMT_HandleTypeDef structure.
+ * @param Ch Character to append.
+ * @return Length of the text after appending.
+ */
+size_t FMT_Char(FMT_HandleTypeDef* hfmt, char Ch);
+
+/**
+ * @brief Appends a signed integer, like printf("%*d").
+ * @param hfmt Pointer to the FMT_HandleTypeDef structure.
+ * @param Value Value to append.
+ * @param Width Minimum field width, right-aligned; 0 for none.
+ * @param Pad Fill character, ' ' or '0' (zeros go after the sign).
+ * @return Length of the text after appending.
+ */
+size_t FMT_Int(FMT_HandleTypeDef* hfmt, int32_t Value, uint8_t Width, char Pad);
+
+/**
+ * @brief Appends an unsigned integer, like printf("%*u").
+ * @param hfmt Pointer to the FMT_HandleTypeDef structure.
+ * @param Value Value to append.
+ * @param Width Minimum field width, right-aligned; 0 for none.
+ * @param Pad Fill character, ' ' or '0'.
+ * @return Length of the text after appending.
+ */
+size_t FMT_UInt(FMT_HandleTypeDef* hfmt, uint32_t Value, uint8_t Width, char Pad);
+
+/**
+ * @brief Appends a float with a fixed number of decimals, like printf("%*.*f").
+ * @param hfmt Pointer to the FMT_HandleTypeDef structure.
+ * @param Value Value to append.
+ * @param Decimals Digits after the decimal point, limited to FMT_MAX_DECIMALS.
+ * @param Width Minimum field width, right-aligned; 0 for none.
+ * @param Pad Fill character, ' ' or '0' (zeros go after the sign).
+ * @return Length of the text after appending.
+ * @note Rounds half to even on the exact binary value, so the digits match printf.
+ *       Values with |Value| >= FMT_FLOAT_LIMIT fill the field (at least one cell) with '#',
+ *       NaN and infinities are printed as "nan", "inf" and "-inf".
+ */
+size_t FMT_Float(FMT_HandleTypeDef* hfmt, float Value, uint8_t Decimals, uint8_t Width, char Pad);
+
+#endif /* INC_FMT_H_ */
@@ -0,0 +1,97 @@
+/**
+  ******************************************************************************
+  * @file     : hil.h
+  * @author   : MS    Mateusz.Stasiak@student.put.poznan.pl
+  * @version  : 1.0.0
+  * @date     : Oct 17, 2026
+  * @brief    : Hardware-in-the-loop glue: thermal plant model driving emulated LM35 readings.
+  *
+  ******************************************************************************
+  */
+
+#ifndef INC_HIL_H_
+#define INC_HIL_H_
+
+/*
+ * The emulator (CM4 built with HIL_MODE, or the host simulator) advances a
+ * PLANT_HandleTypeDef with the duty the controller applied and publishes the
+ * ADC1 code an LM35 at the plant temperature would give. The controller side
+ * reads it through LM35_SetSource, so the whole control path runs unchanged.
+ *
+ * HIL_SharedTypeDef lives in ".shared" (section ".shared.hil", after the
+ * mailbox) in both images; every field is a single aligned word, so no lock
+ * is needed. Magic is set only while an emulator feeds the readings.
+ */
+
+/* Public includes -----------------------------------------------------------*/
+#include "stdint.h"
+#include "plant.h"
+
+/* Public typedef ------------------------------------------------------------*/
+typedef struct {
+	volatile uint32_t Magic;       // HIL_MAGIC while the emulator runs
+	volatile uint32_t AdcRaw;      // emulated LM35 ADC1 code, emulator -> controller
+	volatile uint32_t Steps;       // plant integration steps so far
+	volatile float Temperature;    // true plant temperature [degC], without sensor noise
+} HIL_SharedTypeDef;
+
+typedef struct {
+	HIL_SharedTypeDef *Shared;
+	PLANT_HandleTypeDef *Plant;
+	float NoiseMv;                 // [mV rms] on the emulated reading, after oversampling
+	float Elapsed;                 // [s] received but shorter than one plant step
+	uint64_t Seed;                 // noise generator state, not 0
+} HIL_HandleTypeDef;
+
+/* Public define -------------------------------------------------------------*/
+#define HIL_MAGIC  0x4C494855U // "UHIL"
+
+/* Public macro --------------------------------------------------------------*/
+#define HIL_INIT_HANDLE(SHARED, PLANT, NOISE_MV) \
+  {                                              \
+    .Shared = SHARED,                            \
+    .Plant = PLANT,                              \
+    .NoiseMv = NOISE_MV,                         \
+    .Seed = 0x123456789ABCDEF1ULL                \
+  }
+
+/* Public variables ----------------------------------------------------------*/
+
+/* Public function prototypes ------------------------------------------------*/
+/**
+ * @brief Starts the plant at the ambient temperature and marks the emulator active.
+ * @param hhil Pointer to the HIL_HandleTypeDef structure, the plant parameters set.
+ */
+void HIL_Init(HIL_HandleTypeDef* hhil);
+
+/**
+ * @brief Advances the plant and publishes the new reading.
+ * @param hhil Pointer to the HIL_HandleTypeDef structure.
+ * @param Duty Heater duty applied during the elapsed time [%].
+ * @param Elapsed Time since the previous call [s].
+ * @note Integrates whole plant steps of Plant->Ts; the remainder carries over to the next call.
+ */
+void HIL_Update(HIL_HandleTypeDef* hhil, float Duty, float Elapsed);
+
+/**
+ * @brief Marks the emulator inactive, the controller falls back to the real ADC.
+ * @param hhil Pointer to the HIL_HandleTypeDef structure.
+ */
+void HIL_Stop(HIL_HandleTypeDef* hhil);
+
+/**
+ * @brief Checks whether an emulator feeds the readings.
+ * @param Shared Pointer to the shared HIL_SharedTypeDef structure.
+ * @return 1 if active, 0 otherwise.
+ */
+uint8_t HIL_IsActive(const HIL_SharedTypeDef* Shared);
+
+/**
+ * @brief Converts a temperature to the ADC1 code LM35_GetTemp turns back into it.
+ * @param Temperature Sensor temperature [degC].
+ * @param NoiseMv Noise added to the sensor voltage [mV].
+ * @return ADC1 code, saturated to the converter range.
+ */
+uint16_t HIL_TempToReg(float Temperature, float NoiseMv);
+
+#endif /* INC_HIL_H_ */
@@ -21,27 +21,60 @@
 
 //------------------[ Public  typedef ]-------------------
 
+#define I2C_LCD_MAX_COLS    20
+#define I2C_LCD_MAX_ROWS    4
+#define I2C_LCD_QUEUE_SIZE  64 // transfer queue length in entries, must be a power of two
+#define I2C_LCD_FRAME_SIZE  6  // expander bytes per HD44780 byte: two nibbles, each with an EN strobe
+#define I2C_LCD_BURST_MAX   20 // queue entries packed into one I2C transfer
+
+typedef struct {
+	uint8_t Val;                                           // HD44780 byte, or the raw expander byte
+	uint8_t Ctrl;                                          // RS and backlight bits sent with it
+	uint16_t WaitUs;                                       // execution time to wait for after the transfer
+} I2C_LCD_QueueEntryTypeDef;
+
 typedef struct {
 	I2C_HandleTypeDef *hi2c;
+	TIM_HandleTypeDef *htim;                               // one-pulse timer counting in microseconds, for long waits
 	uint8_t I2C_LCD_Address;
 	uint8_t I2C_LCD_nCol;
 	uint8_t I2C_LCD_nRow;
 	uint8_t DisplayCtrl;
 	uint8_t BacklightVal;
+	uint8_t CursorCol, CursorRow;                          // DDRAM address counter, I2C_LCD_CURSOR_UNKNOWN if not on screen
+	char Shadow[I2C_LCD_MAX_ROWS][I2C_LCD_MAX_COLS];       // frame requested by I2C_LCD_Print
+	char Ddram[I2C_LCD_MAX_ROWS][I2C_LCD_MAX_COLS];        // frame shown by the display once the queue drains
+	I2C_LCD_QueueEntryTypeDef Queue[I2C_LCD_QUEUE_SIZE];
+	volatile uint16_t QueueHead;                           // free-running, written by the caller only
+	volatile uint16_t QueueTail;                           // free-running, written by the interrupt side only
+	volatile uint8_t Busy;                                 // a transfer or a wait is in progress
+	uint8_t BurstLen;                                      // entries from QueueTail carried by the current transfer
+	uint8_t Hold;                                          // queued entries are not started until released
+	uint8_t BusyPolling;                                   // wait for long commands by reading the busy flag
+	uint8_t PollState;                                     // step of the busy flag read in progress
+	uint8_t PollCount;                                     // busy reads so far for the current command
+	uint8_t RxByte;                                        // expander pins read back, BF in bit 7
+	uint16_t PollWaitUs;                                   // timed wait to fall back to if polling fails
+	uint8_t TxBuf[I2C_LCD_BURST_MAX * I2C_LCD_FRAME_SIZE]; // frames of the current transfer, read by the I2C interrupt
+	uint32_t Dropped;                                      // entries rejected because the queue was full
+	uint32_t Errors;                                       // transfers that failed and were skipped
 } I2C_LCD_HandleTypeDef;
 
 //-------------------[ Public define ]--------------------
 
+#define I2C_LCD_CURSOR_UNKNOWN  0xFF
+
 
 //-------------------[ Public macro ]---------------------
 
 #ifdef USE_HAL_DRIVER
-#define I2C_LCD_INIT_HANDLE(I2C_HANDLE, ADDRESS, NCOL, NROW) \
-  {                                                          \
-    .hi2c = I2C_HANDLE,                                      \
-    .I2C_LCD_Address = ADDRESS,                              \
-    .I2C_LCD_nCol = NCOL,                                    \
-	.I2C_LCD_nRow = NROW                                     \
+#define I2C_LCD_INIT_HANDLE(I2C_HANDLE, TIM_HANDLE, ADDRESS, NCOL, NROW) \
+  {                                                                      \
+    .hi2c = I2C_HANDLE,                                                  \
+    .htim = TIM_HANDLE,                                                  \
+    .I2C_LCD_Address = ADDRESS,                                          \
+    .I2C_LCD_nCol = NCOL,                                                \
+	.I2C_LCD_nRow = NROW                                                 \
   }
 #endif
 
@@ -51,6 +84,9 @@ typedef struct {
  * @brief Initializes the LCD display using the I2C protocol.
  * @param hi2c Pointer to the I2C_LCD_HandleTypeDef structure containing the LCD configuration.
  * @note This function sets up the LCD display with the appropriate parameters such as 4-bit mode, number of lines, and other settings.
+ * @note All functions of this driver only queue the transfers and return at once. The queue is
+ *       drained by the I2C interrupt; the I2C event/error interrupts and the timer update interrupt
+ *       must be enabled and forwarded with the I2C_LCD_xxxCallback functions below.
  */
 void I2C_LCD_Init(I2C_LCD_HandleTypeDef* hi2c);
 
@@ -91,6 +127,78 @@ void I2C_LCD_WriteChar(I2C_LCD_HandleTypeDef* hi2c, char Ch);
  */
 void I2C_LCD_WriteString(I2C_LCD_HandleTypeDef* hi2c, char* Str);
 
+/**
+ * @brief Writes a string into the shadow framebuffer without touching the bus.
+ * @param hi2c Pointer to the I2C_LCD_HandleTypeDef structure.
+ * @param Col Column of the first character.
+ * @param Row Row of the string.
+ * @param Str Pointer to the null-terminated string, clipped at the end of the row.
+ * @note Call I2C_LCD_Flush to send the changes to the display.
+ */
+void I2C_LCD_Print(I2C_LCD_HandleTypeDef* hi2c, uint8_t Col, uint8_t Row, const char* Str);
+
+/**
+ * @brief Sends the cells that differ between the shadow framebuffer and the display.
+ * @param hi2c Pointer to the I2C_LCD_HandleTypeDef structure.
+ * @return Number of characters queued for the display.
+ * @note Runs of changed cells are written with one cursor move, which is skipped
+ *       when the display address counter already points at the run. A run that does
+ *       not fit into the free queue space is left for the next flush.
+ */
+uint16_t I2C_LCD_Flush(I2C_LCD_HandleTypeDef* hi2c);
+
+/**
+ * @brief Selects busy flag polling or timed waits for clear, home and similar long commands.
+ * @param hi2c Pointer to the I2C_LCD_HandleTypeDef structure.
+ * @param Enable 1 to read the busy flag back through the expander, 0 for the datasheet delays.
+ * @note Requires the expander P1 pin wired to RW. Polling switches itself off if the busy
+ *       flag never clears.
+ */
+void I2C_LCD_SetBusyPolling(I2C_LCD_HandleTypeDef* hi2c, uint8_t Enable);
+
+/**
+ * @brief Checks whether queued transfers are still being sent.
+ * @param hi2c Pointer to the I2C_LCD_HandleTypeDef structure.
+ * @return 1 while the queue is draining, 0 when the display is up to date.
+ */
+uint8_t I2C_LCD_IsBusy(I2C_LCD_HandleTypeDef* hi2c);
+
+/**
+ * @brief Must be called from HAL_I2C_MasterTxCpltCallback for the LCD bus.
+ * @param hi2c Pointer to the I2C_LCD_HandleTypeDef structure.
+ * @note Starts the execution wait of the last sent entry or the next transfer.
+ */
+void I2C_LCD_TxCpltCallback(I2C_LCD_HandleTypeDef* hi2c);
+
+/**
+ * @brief Must be called from HAL_I2C_MasterRxCpltCallback for the LCD bus.
+ * @param hi2c Pointer to the I2C_LCD_HandleTypeDef structure.
+ * @note Only used by busy flag polling.
+ */
+void I2C_LCD_RxCpltCallback(I2C_LCD_HandleTypeDef* hi2c);
+
+/**
+ * @brief Must be called from HAL_I2C_ErrorCallback for the LCD bus.
+ * @param hi2c Pointer to the I2C_LCD_HandleTypeDef structure.
+ * @note The failed transfer is counted in Errors and its entries are skipped.
+ *       A failed busy flag read falls back to the timed wait, after the read cycle is
+ *       completed to keep the 4-bit interface in step.
+ */
+void I2C_LCD_ErrorCallback(I2C_LCD_HandleTypeDef* hi2c);
+
+/**
+ * @brief Must be called from HAL_TIM_PeriodElapsedCallback for the LCD wait timer.
+ * @param hi2c Pointer to the I2C_LCD_HandleTypeDef structure.
+ */
+void I2C_LCD_WaitElapsedCallback(I2C_LCD_HandleTypeDef* hi2c);
+
+/**
+ * @brief Called from interrupt context when the queue has been drained.
+ * @param hi2c Pointer to the I2C_LCD_HandleTypeDef structure.
+ * @note Weak, empty by default; override it to be notified that the display is up to date.
+ */
+void I2C_LCD_IdleCallback(I2C_LCD_HandleTypeDef* hi2c);
+
 /**
  * @brief Shifts the display content to the left.
  * @param hi2c Pointer to the I2C_LCD_HandleTypeDef structure.
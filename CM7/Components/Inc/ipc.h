@@ -0,0 +1,130 @@
+/**
+  ******************************************************************************
+  * @file     : ipc.h
+  * @author   : MS    Mateusz.Stasiak@student.put.poznan.pl
+  * @version  : 1.0.0
+  * @date     : Oct 17, 2026
+  * @brief    : Lock-free single-producer single-consumer ring between the cores.
+  *
+  ******************************************************************************
+  */
+
+#ifndef INC_IPC_H_
+#define INC_IPC_H_
+
+/*
+ * A ring carries fixed-size items from one core to the other, e.g. every
+ * control sample from the CM7 to the CM4 without losing any to a busy reader.
+ *
+ * The ring is defined with IPC_RING_DEFINE in both images. Its section
+ * ".ipc.<name>" goes to the ".ipc" output section (SRAM4), sorted by name,
+ * so both images must define the same rings for the addresses to agree;
+ * IPC_IsReady on the consumer checks the magic and the geometry.
+ *
+ *  Head   written by the producer only, free-running
+ *  Tail   written by the consumer only, free-running
+ *
+ * Each index and each item slot occupies whole cache lines, so on the CM7
+ * a slot is cleaned or invalidated without touching anything the other core
+ * writes. The maintenance runs only while the D-cache is on and costs nothing
+ * on the CM4 or when the MPU maps the region non-cacheable.
+ * A push that does not fit is dropped and counted; the consumer is woken by
+ * a release of the ring's hardware semaphore (HSEM interrupt of its core).
+ */
+
+/* Public includes -----------------------------------------------------------*/
+#include "stdint.h"
+#include "stddef.h"
+#ifdef USE_HAL_DRIVER
+#include "stm32h7xx_hal.h"
+#endif
+
+/* Public typedef ------------------------------------------------------------*/
+#define IPC_CACHE_LINE  32U // Cortex-M7 L1 D-cache line [B]
+
+typedef struct {
+	uint32_t Magic;
+	uint16_t ItemSize;        // bytes per slot, a multiple of IPC_CACHE_LINE
+	uint16_t Count;           // slots, a power of two
+	uint8_t Reserved0[IPC_CACHE_LINE - 8U];
+	volatile uint32_t Head;   // free-running, written by the producer only
+	volatile uint32_t Dropped; // pushes refused by a full ring, producer only
+	uint8_t Reserved1[IPC_CACHE_LINE - 8U];
+	volatile uint32_t Tail;   // free-running, written by the consumer only
+	uint8_t Reserved2[IPC_CACHE_LINE - 4U];
+} IPC_RingTypeDef;
+
+typedef struct {
+	IPC_RingTypeDef *Ring;    // shared control block
+	uint8_t *Data;            // shared slots, Count * Stride bytes
+	uint16_t ItemSize;        // bytes copied per item
+	uint16_t Stride;          // ItemSize rounded up to IPC_CACHE_LINE
+	uint16_t Count;           // slots, a power of two
+	uint32_t SemId;           // hardware semaphore released after a push, 0 for none
+} IPC_HandleTypeDef;
+
+/* Public define -------------------------------------------------------------*/
+#define IPC_MAGIC  0x52435049U // "IPCR"
+
+/* Public macro --------------------------------------------------------------*/
+#define IPC_STRIDE(ITEM_SIZE)  ((((ITEM_SIZE) + IPC_CACHE_LINE - 1U) / IPC_CACHE_LINE) * IPC_CACHE_LINE)
+
+/* COUNT must be a power of two */
+#define IPC_RING_DEFINE(NAME, ITEM_SIZE, COUNT)                             \
+  struct {                                                                  \
+    IPC_RingTypeDef Ring;                                                   \
+    uint8_t Data[(COUNT) * IPC_STRIDE(ITEM_SIZE)];                          \
+  } NAME __attribute__((section(".ipc." #NAME), aligned(IPC_CACHE_LINE)))
+
+#define IPC_INIT_HANDLE(RING, ITEM_SIZE, SEM_ID)                            \
+  {                                                                         \
+    .Ring = &(RING).Ring,                                                   \
+    .Data = (RING).Data,                                                    \
+    .ItemSize = ITEM_SIZE,                                                  \
+    .Stride = IPC_STRIDE(ITEM_SIZE),                                        \
+    .Count = sizeof((RING).Data) / IPC_STRIDE(ITEM_SIZE),                   \
+    .SemId = SEM_ID                                                         \
+  }
+
+/* Public variables ----------------------------------------------------------*/
+
+/* Public function prototypes ------------------------------------------------*/
+/**
+ * @brief Empties the ring and writes its geometry for the other core.
+ * @param hipc Pointer to the IPC_HandleTypeDef structure.
+ * @note Called by one core before the other one is released from the boot semaphore.
+ */
+void IPC_Init(IPC_HandleTypeDef* hipc);
+
+/**
+ * @brief Checks that the ring was initialised with the geometry of this image.
+ * @param hipc Pointer to the IPC_HandleTypeDef structure.
+ * @return 1 if magic, item size and count agree, 0 otherwise.
+ */
+uint8_t IPC_IsReady(const IPC_HandleTypeDef* hipc);
+
+/**
+ * @brief Copies an item into the ring and notifies the consumer.
+ * @param hipc Pointer to the IPC_HandleTypeDef structure.
+ * @param Item ItemSize bytes to copy.
+ * @return HAL_OK, or HAL_BUSY if the ring is full and the item was dropped.
+ * @note Producer core only, never waits. Calls must not preempt each other.
+ */
+HAL_StatusTypeDef IPC_Push(IPC_HandleTypeDef* hipc, const void* Item);
+
+/**
+ * @brief Copies the oldest item out of the ring.
+ * @param hipc Pointer to the IPC_HandleTypeDef structure.
+ * @param Item Output, ItemSize bytes.
+ * @return 1 if an item was copied, 0 if the ring is empty.
+ * @note Consumer core only. Calls must not preempt each other.
+ */
+uint8_t IPC_Pop(IPC_HandleTypeDef* hipc, void* Item);
+
+/**
+ * @brief Returns the number of items waiting in the ring.
+ * @param hipc Pointer to the IPC_HandleTypeDef structure.
+ */
+uint16_t IPC_Pending(const IPC_HandleTypeDef* hipc);
+
+#endif /* INC_IPC_H_ */
@@ -0,0 +1,75 @@
+/**
+  ******************************************************************************
+  * @file     : jitter.h
+  * @author   : MS    Mateusz.Stasiak@student.put.poznan.pl
+  * @version  : 1.0.0
+  * @date     : Oct 17, 2026
+  * @brief    : Sampling interval (jitter) statistics.
+  *
+  ******************************************************************************
+  */
+
+#ifndef INC_JITTER_H_
+#define INC_JITTER_H_
+
+/* Public includes -----------------------------------------------------------*/
+#include "stdint.h"
+
+/* Public typedef ------------------------------------------------------------*/
+typedef struct {
+	uint8_t Started;
+	uint32_t LastTimestamp;
+	uint32_t Reference;          // first interval, the sums below hold deviations from it
+	uint32_t Count;
+	uint32_t Min, Max;
+	int64_t Sum;                 // sum of (interval - Reference), exact
+	uint64_t SumSq;              // sum of (interval - Reference)^2, exact
+	volatile uint32_t Sequence;  // odd while JITTER_Update writes, for JITTER_GetStats
+} JITTER_HandleTypeDef;
+
+typedef struct {
+	uint32_t Count;
+	uint32_t Min, Max;           // [ticks]
+	double Mean;                 // [ticks]
+	double StdDev;               // [ticks]
+} JITTER_StatsTypeDef;
+
+/* Public define -------------------------------------------------------------*/
+
+/* Public macro --------------------------------------------------------------*/
+#define JITTER_INIT_HANDLE() \
+  {                          \
+    .Min = UINT32_MAX        \
+  }
+
+/* Public variables ----------------------------------------------------------*/
+
+/* Public function prototypes ------------------------------------------------*/
+/**
+ * @brief Clears the collected interval statistics.
+ * @param hjitter Pointer to the JITTER_HandleTypeDef structure that holds the statistics.
+ * @note Masks interrupts for the few stores it takes, so it may be called while JITTER_Update
+ *       keeps running from an interrupt.
+ */
+void JITTER_Reset(JITTER_HandleTypeDef* hjitter);
+
+/**
+ * @brief Adds a new event timestamp and updates the interval statistics.
+ * @param hjitter Pointer to the JITTER_HandleTypeDef structure that holds the statistics.
+ * @param Timestamp Event time in timer ticks (e.g. DWT cycles), may wrap around.
+ * @note Integer sums of the deviations from the first interval, so intervals above 2^24 ticks
+ *       (6.4M cycles per 100 ms at 64 MHz) lose nothing however long the run; constant cost per event.
+ *       SumSq holds 2^64 / d^2 events of deviation d: over 4e9 events at 1 ms of jitter and 64 MHz.
+ */
+void JITTER_Update(JITTER_HandleTypeDef* hjitter, uint32_t Timestamp);
+
+/**
+ * @brief Returns a consistent copy of the statistics.
+ * @param hjitter Pointer to the JITTER_HandleTypeDef structure that holds the statistics.
+ * @param Stats Output: count, extremes, mean and standard deviation in timer ticks.
+ * @note Safe against JITTER_Update in an interrupt: the copy is retried until no update ran
+ *       during it, without masking interrupts.
+ */
+void JITTER_GetStats(const JITTER_HandleTypeDef* hjitter, JITTER_StatsTypeDef* Stats);
+
+#endif /* INC_JITTER_H_ */
@@ -16,6 +16,7 @@
 #ifdef USE_HAL_DRIVER
 #include "stm32h7xx_hal.h"
 #endif
+#include "utils.h"
 
 /* Public typedef ------------------------------------------------------------*/
 typedef struct {
@@ -23,18 +24,21 @@ typedef struct {
     float filtered_value;
 } LM35_Filter_HandleTypeDef;
 
+typedef uint16_t (*LM35_SourceTypeDef)(ADC_HandleTypeDef *hadc); // latest raw ADC code
+
 /* Public define -------------------------------------------------------------*/
 #define ADC_BIT_RES      16      // [bits]
 #define ADC_REG_MAX      (float)((1ul << ADC_BIT_RES) - 1)
 #define ADC_VOLTAGE_MAX  3.3f    // [V]
 #define ADC1_TIMEOUT     1 		 // [ms]
+#define LM35_DMA_BUFFER_LENGTH  200  // [samples], each half is one control period at the TIM6 TRGO rate
+#define LM35_OFFSET      2.0f    // [degC], subtracted from the converted reading
 
 /* Public macro --------------------------------------------------------------*/
 
 #define __LINEAR_TRANSFORM(x,amin,amax,bmin,bmax) (((x-amin)/(amax-amin))*(bmax-bmin)+bmin)
-#define ADC_REG2VOLTAGE(reg) (1000.0f*__LINEAR_TRANSFORM((float)reg,         \
-                                                       0.0f, ADC_REG_MAX,    \
-                                                       0.0f, ADC_VOLTAGE_MAX))
+/* [mV]; one constant factor, so the conversion is a single multiplication */
+#define ADC_REG2VOLTAGE(reg) ((float)(reg) * (1000.0f * ADC_VOLTAGE_MAX / ADC_REG_MAX))
 
 #ifdef USE_HAL_DRIVER
 #define LM35_FILTER_INIT_HANDLE(ALPHA) \
@@ -47,6 +51,56 @@ typedef struct {
 /* Public variables ----------------------------------------------------------*/
 
 /* Public function prototypes ------------------------------------------------*/
+/**
+ * @brief Starts ADC acquisition of the LM35 into a circular DMA buffer.
+ * @param hadc Pointer to the ADC_HandleTypeDef structure containing ADC configuration.
+ * @return HAL status of the ADC start.
+ * @note The ADC must be configured with circular DMA data management; conversions are started by
+ *       its trigger (timer TRGO or continuous mode). After this call the buffer is refreshed by hardware
+ *       and never has to be polled. Half and full buffer events arrive through the HAL ADC callbacks.
+ */
+HAL_StatusTypeDef LM35_Start(ADC_HandleTypeDef *hadc);
+
+/**
+ * @brief Changes the sampling time and hardware oversampling of the LM35 ADC at run time.
+ * @param hadc Pointer to the ADC_HandleTypeDef structure containing ADC configuration.
+ * @param Config Pointer to the ADC_SamplingConfigTypeDef structure with the new settings.
+ * @return HAL status; on HAL_ERROR the acquisition is left stopped.
+ * @note Acquisition is stopped, reconfigured and restarted, so the DMA buffer starts over.
+ */
+HAL_StatusTypeDef LM35_ConfigADC(ADC_HandleTypeDef *hadc, const ADC_SamplingConfigTypeDef *Config);
+
+/**
+ * @brief Returns the most recent raw ADC sample written by the DMA.
+ * @param hadc Pointer to the ADC_HandleTypeDef structure containing ADC configuration.
+ * @return The latest ADC register value.
+ * @note Constant time, does not block.
+ */
+uint16_t LM35_GetLatestReg(ADC_HandleTypeDef *hadc);
+
+/**
+ * @brief Copies the most recent raw ADC samples written by the DMA.
+ * @param hadc Pointer to the ADC_HandleTypeDef structure containing ADC configuration.
+ * @param Block Destination buffer, oldest sample first.
+ * @param Length Number of samples requested.
+ * @return Number of samples copied (limited to LM35_DMA_BUFFER_LENGTH).
+ */
+uint16_t LM35_ReadBlock(ADC_HandleTypeDef *hadc, uint16_t *Block, uint16_t Length);
+
+/**
+ * @brief Selects where LM35_GetReg and LM35_GetTemp take the raw reading from.
+ * @param Source Function returning the latest raw ADC code, NULL for the DMA buffer (LM35_GetLatestReg).
+ * @note Lets a hardware-in-the-loop emulator inject readings without changing the control path.
+ */
+void LM35_SetSource(LM35_SourceTypeDef Source);
+
+/**
+ * @brief Returns the latest raw reading from the selected source.
+ * @param hadc Pointer to the ADC_HandleTypeDef structure containing ADC configuration.
+ * @return The latest ADC register value, real or injected.
+ */
+uint16_t LM35_GetReg(ADC_HandleTypeDef *hadc);
+
 /**
  * @brief Converts the input voltage to temperature based on LM35 sensor characteristics.
  * @param voltage The input voltage measured from the LM35 sensor.
@@ -60,10 +114,19 @@ float LM35_VOLTAGE2TEMP(float voltage);
  * @param hadc Pointer to the ADC_HandleTypeDef structure containing ADC configuration.
  * @param hfilter Pointer to the LM35_Filter_HandleTypeDef structure for filtering temperature readings.
  * @return The current temperature in Celsius after applying filtering.
- * @note This function reads the ADC value, converts it to voltage, and then applies a filter to smooth the temperature reading.
+ * @note This function takes the latest sample of the selected source, converts it to voltage, and then applies a filter to smooth the temperature reading.
  */
 float LM35_GetTemp(ADC_HandleTypeDef *hadc, LM35_Filter_HandleTypeDef *hfilter);
 
+/**
+ * @brief Converts a raw reading to temperature and passes it through the filter.
+ * @param reg Raw ADC code, e.g. from LM35_GetReg.
+ * @param hfilter Pointer to the LM35_Filter_HandleTypeDef structure for filtering temperature readings.
+ * @return The filtered temperature in Celsius.
+ * @note Lets a caller that also publishes the raw code convert the very reading it publishes.
+ */
+float LM35_ConvertTemp(uint16_t reg, LM35_Filter_HandleTypeDef *hfilter);
+
 /**
  * @brief Updates the temperature filter with a new value.
  * @param hfilter Pointer to the LM35_Filter_HandleTypeDef structure that holds the filter state.
@@ -0,0 +1,183 @@
+/**
+  ******************************************************************************
+  * @file     : mbox.h
+  * @author   : MS    Mateusz.Stasiak@student.put.poznan.pl
+  * @version  : 1.0.0
+  * @date     : Oct 17, 2026
+  * @brief    : Inter-core mailbox in shared SRAM: control snapshot and request slot.
+  *
+  ******************************************************************************
+  */
+
+#ifndef INC_MBOX_H_
+#define INC_MBOX_H_
+
+/*
+ * One MBOX_SharedTypeDef lives in the ".shared" section (SRAM4, D3 domain),
+ * linked at the same address into both images. The CM7 clears it before it
+ * releases the CM4 from the boot semaphore.
+ *
+ *  Snapshot  CM7 -> CM4  written every control period under a sequence lock,
+ *                        so the control loop never waits for the reader;
+ *                        MBOX_HSEM_SNAPSHOT notifies the CM4.
+ *  Request   CM4 -> CM7  one message at a time, MBOX_HSEM_REQUEST notifies
+ *                        the CM7, MBOX_HSEM_REPLY notifies the CM4 when the
+ *                        reply is in place. MBOX_HSEM_LOCK guards the slot.
+ *
+ * Notifications are hardware semaphore releases: the sender takes and frees
+ * the semaphore, the receiver gets the HSEM interrupt of its core.
+ * The CM7 D-cache must not cache ".shared" (MPU region, non-cacheable).
+ */
+
+/* Public includes -----------------------------------------------------------*/
+#include "stdint.h"
+#include "stddef.h"
+#ifdef USE_HAL_DRIVER
+#include "stm32h7xx_hal.h"
+#endif
+
+/* Public typedef ------------------------------------------------------------*/
+#define MBOX_REPORT_MAX  1536 // text of the longest report, probe dump included
+
+typedef enum {
+	MBOX_PARAM_PID_SP = 0,
+	MBOX_PARAM_PID_KP,
+	MBOX_PARAM_PID_KI,
+	MBOX_PARAM_PID_KD,
+	MBOX_PARAM_PID_B,
+	MBOX_PARAM_PID_C,
+	MBOX_PARAM_PID_TF,
+	MBOX_PARAM_PID_AW,
+	MBOX_PARAM_PID_KT,
+	MBOX_PARAM_PID_IMAX,
+	MBOX_PARAM_PID_IMIN,
+	MBOX_PARAM_LM35_ALPHA,
+	MBOX_PARAM_PWM_MIN,
+	MBOX_PARAM_PWM_MAX,
+	MBOX_PARAM_LOOP_MS,
+	MBOX_PARAM_CLK_PROFILE,
+	MBOX_PARAM_COUNT
+} MBOX_ParamTypeDef;
+
+typedef enum {
+	MBOX_REQUEST_SET = 1,     // Id, Value -> Status 1 if accepted, Value read back
+	MBOX_REQUEST_REPORT       // Id is a MBOX_ReportTypeDef -> Length characters in Report
+} MBOX_RequestTypeDef;
+
+typedef enum {
+	MBOX_REPORT_JITTER = 0,   // control period statistics
+	MBOX_REPORT_PROBES,       // CM7 probes, one line each
+	MBOX_REPORT_PROBES_RESET  // the same, then the probes are cleared
+} MBOX_ReportTypeDef;
+
+typedef struct {
+	uint32_t Period;          // control periods since start
+	uint32_t TimeMs;          // HAL tick of the CM7 [ms]
+	uint16_t AdcRaw;          // raw LM35 ADC code
+	uint16_t PotRaw;          // raw potentiometer ADC code
+	int32_t Duty;             // applied PWM duty [%]
+	float Temperature;        // filtered temperature [degC]
+	float SetPoint;           // [degC]
+	float P, I, D;            // terms of the last PID output
+	float Params[MBOX_PARAM_COUNT]; // registry values as read back by the CM7
+} MBOX_SnapshotTypeDef;
+
+typedef struct {
+	uint8_t Request;          // MBOX_RequestTypeDef
+	uint8_t Id;
+	uint8_t Status;           // reply only
+	float Value;
+	uint16_t Length;          // reply only
+} MBOX_MessageTypeDef;
+
+typedef struct {
+	uint32_t Magic;
+	volatile uint32_t Sequence;        // odd while the snapshot is being written
+	MBOX_SnapshotTypeDef Snapshot;
+	volatile uint32_t RequestSequence; // advanced by the CM4 for each request
+	volatile uint32_t ReplySequence;   // sequence of the request the CM7 answered last
+	MBOX_MessageTypeDef Message;
+	char Report[MBOX_REPORT_MAX];
+} MBOX_SharedTypeDef;
+
+/* Public define -------------------------------------------------------------*/
+#define MBOX_MAGIC          0x584F424DU // "MBOX"
+#define MBOX_HSEM_SNAPSHOT  1U          // HSEM_ID_0 is the boot handshake
+#define MBOX_HSEM_REQUEST   2U
+#define MBOX_HSEM_REPLY     3U
+#define MBOX_HSEM_LOCK      4U
+#define MBOX_READ_RETRIES   8U
+
+/* Public macro --------------------------------------------------------------*/
+#define MBOX_SEM_MASK(SEM_ID)  (1UL << (SEM_ID))
+
+/* Public variables ----------------------------------------------------------*/
+
+/* Public function prototypes ------------------------------------------------*/
+/**
+ * @brief Clears the shared area and marks it valid.
+ * @param hmbox Pointer to the shared MBOX_SharedTypeDef structure.
+ * @note CM7 only, before the CM4 is released from the boot semaphore.
+ */
+void MBOX_Init(MBOX_SharedTypeDef* hmbox);
+
+/**
+ * @brief Checks that the shared area was initialised by the CM7.
+ * @param hmbox Pointer to the shared MBOX_SharedTypeDef structure.
+ * @return 1 if the area is valid, 0 otherwise.
+ */
+uint8_t MBOX_IsReady(const MBOX_SharedTypeDef* hmbox);
+
+/**
+ * @brief Publishes a new snapshot and notifies the other core.
+ * @param hmbox Pointer to the shared MBOX_SharedTypeDef structure.
+ * @param Snapshot Snapshot to copy.
+ * @note CM7 only. Never waits; a reader that overlaps the write retries.
+ */
+void MBOX_Publish(MBOX_SharedTypeDef* hmbox, const MBOX_SnapshotTypeDef* Snapshot);
+
+/**
+ * @brief Copies the latest consistent snapshot.
+ * @param hmbox Pointer to the shared MBOX_SharedTypeDef structure.
+ * @param Snapshot Output.
+ * @return 1 on success, 0 if every one of MBOX_READ_RETRIES attempts overlapped a write.
+ */
+uint8_t MBOX_Read(const MBOX_SharedTypeDef* hmbox, MBOX_SnapshotTypeDef* Snapshot);
+
+/**
+ * @brief Sends a request to the CM7 and waits for its reply.
+ * @param hmbox Pointer to the shared MBOX_SharedTypeDef structure.
+ * @param Message Request on input, reply on output.
+ * @param Timeout Maximum wait [ms].
+ * @return HAL_OK, or HAL_TIMEOUT if the CM7 did not answer in time.
+ * @note CM4 only, from task context. Report text stays valid until the next call.
+ */
+HAL_StatusTypeDef MBOX_Call(MBOX_SharedTypeDef* hmbox, MBOX_MessageTypeDef* Message, uint32_t Timeout);
+
+/**
+ * @brief Fetches the pending request, if any.
+ * @param hmbox Pointer to the shared MBOX_SharedTypeDef structure.
+ * @param Message Output, valid when 1 is returned.
+ * @param Sequence Output, sequence of the request to pass to MBOX_Reply, valid when 1 is returned.
+ * @return 1 if a request waits for MBOX_Reply, 0 otherwise.
+ * @note CM7 only.
+ */
+uint8_t MBOX_GetRequest(MBOX_SharedTypeDef* hmbox, MBOX_MessageTypeDef* Message, uint32_t* Sequence);
+
+/**
+ * @brief Answers a request and notifies the CM4.
+ * @param hmbox Pointer to the shared MBOX_SharedTypeDef structure.
+ * @param Message Reply; report text, if any, is already in hmbox->Report.
+ * @param Sequence Sequence MBOX_GetRequest returned with the request.
+ * @note CM7 only. A reply to a request the CM4 has replaced after a timeout is dropped,
+ *       so it can never be taken for the answer to the newer one.
+ */
+void MBOX_Reply(MBOX_SharedTypeDef* hmbox, const MBOX_MessageTypeDef* Message, uint32_t Sequence);
+
+/**
+ * @brief Notifies the other core by taking and freeing a hardware semaphore.
+ * @param SemId One of the MBOX_HSEM_x notification semaphores.
+ */
+void MBOX_Notify(uint32_t SemId);
+
+#endif /* INC_MBOX_H_ */
@@ -0,0 +1,150 @@
+/**
+  ******************************************************************************
+  * @file     : param.h
+  * @author   : MS    Mateusz.Stasiak@student.put.poznan.pl
+  * @version  : 1.0.0
+  * @date     : Oct 17, 2026
+  * @brief    : Registry of named, typed and range-checked runtime parameters.
+  *
+  ******************************************************************************
+  */
+
+#ifndef INC_PARAM_H_
+#define INC_PARAM_H_
+
+/*
+ * The registry only knows names, types and ranges; the application reads and
+ * writes the values through two callbacks selected by the entry index, so
+ * parameters can live in any handle and changes can have side effects.
+ *
+ * Commands, one per line, every line is answered with a single reply line:
+ *
+ *   get pid.kp pid.ki          ok pid.kp=60 pid.ki=40
+ *   set pid.kp=55 pid.kd=0.5   ok pid.kp=55 pid.kd=0.5    (values read back)
+ *   list                       pid.kp=60 float 0..1000    (one line per entry)
+ *                              ok 15
+ *
+ * Failures are answered with "err <reason> <argument>", reasons:
+ *   unknown   no such parameter
+ *   value     missing value or not a number
+ *   type      fraction given for an int parameter
+ *   range     outside the min..max of the entry
+ *   refused   rejected by the application, e.g. a lower limit above the upper one
+ *
+ * A set is checked as a whole before anything is written, so a line with an
+ * unknown name, a malformed value or an out-of-range value changes nothing.
+ * Only a refusal can stop a set half way; the arguments before it stay applied.
+ */
+
+/* Public includes -----------------------------------------------------------*/
+#include "stdint.h"
+#include "stddef.h"
+#include "cmd.h"
+#include "fmt.h"
+
+/* Public typedef ------------------------------------------------------------*/
+typedef enum {
+	PARAM_TYPE_FLOAT = 0,
+	PARAM_TYPE_INT            // whole numbers only
+} PARAM_TypeTypeDef;
+
+typedef enum {
+	PARAM_OK = 0,
+	PARAM_ERROR_UNKNOWN,
+	PARAM_ERROR_VALUE,
+	PARAM_ERROR_TYPE,
+	PARAM_ERROR_RANGE,
+	PARAM_ERROR_REFUSED
+} PARAM_StatusTypeDef;
+
+typedef struct {
+	const char *Name;
+	PARAM_TypeTypeDef Type;
+	float Min, Max;           // inclusive
+} PARAM_EntryTypeDef;
+
+typedef struct {
+	const PARAM_EntryTypeDef *Entries;
+	uint8_t Count;
+	float (*Get)(uint8_t Id);              // Id is the index in Entries
+	uint8_t (*Set)(uint8_t Id, float Value); // 0 refuses the value
+} PARAM_HandleTypeDef;
+
+/* Public define -------------------------------------------------------------*/
+#define PARAM_NOT_FOUND  0xFFU
+
+/* Public macro --------------------------------------------------------------*/
+#define PARAM_ENTRY(NAME, TYPE, MIN, MAX) \
+  {                                       \
+    .Name = NAME,                         \
+    .Type = TYPE,                         \
+    .Min = MIN,                           \
+    .Max = MAX                            \
+  }
+
+#define PARAM_INIT_HANDLE(ENTRIES, COUNT, GET, SET) \
+  {                                                 \
+    .Entries = ENTRIES,                             \
+    .Count = COUNT,                                 \
+    .Get = GET,                                     \
+    .Set = SET                                      \
+  }
+
+/* Public variables ----------------------------------------------------------*/
+
+/* Public function prototypes ------------------------------------------------*/
+/**
+ * @brief Looks up a parameter by the name of a command argument.
+ * @param hparam Pointer to the PARAM_HandleTypeDef structure.
+ * @param Arg Argument whose name is looked up.
+ * @return Index of the entry, PARAM_NOT_FOUND if there is none.
+ */
+uint8_t PARAM_Find(const PARAM_HandleTypeDef* hparam, const CMD_ArgTypeDef* Arg);
+
+/**
+ * @brief Checks a value against the type and range of a parameter.
+ * @param hparam Pointer to the PARAM_HandleTypeDef structure.
+ * @param Id Index of the entry.
+ * @param Value Value to check.
+ * @return PARAM_OK, PARAM_ERROR_TYPE or PARAM_ERROR_RANGE.
+ */
+PARAM_StatusTypeDef PARAM_Check(const PARAM_HandleTypeDef* hparam, uint8_t Id, float Value);
+
+/**
+ * @brief Checks and writes a value.
+ * @param hparam Pointer to the PARAM_HandleTypeDef structure.
+ * @param Id Index of the entry.
+ * @param Value New value.
+ * @return PARAM_OK, or the reason the value was not written.
+ */
+PARAM_StatusTypeDef PARAM_Set(const PARAM_HandleTypeDef* hparam, uint8_t Id, float Value);
+
+/**
+ * @brief Appends "name=value" with the current value of a parameter.
+ * @param hparam Pointer to the PARAM_HandleTypeDef structure.
+ * @param Id Index of the entry.
+ * @param hfmt Destination text.
+ * @return Length of the text after appending.
+ * @note Floats are printed with up to FMT_MAX_DECIMALS decimals, trailing zeros removed.
+ */
+size_t PARAM_Format(const PARAM_HandleTypeDef* hparam, uint8_t Id, FMT_HandleTypeDef* hfmt);
+
+/**
+ * @brief Executes a get, set or list command.
+ * @param hparam Pointer to the PARAM_HandleTypeDef structure.
+ * @param Args Tokenized command line, Args[0] is the command.
+ * @param Count Number of arguments.
+ * @param Write Sink for the reply lines, each passed complete with its '\n'.
+ * @return 1 if Args[0] is a registry command and a reply was written, 0 otherwise.
+ */
+uint8_t PARAM_Command(const PARAM_HandleTypeDef* hparam, const CMD_ArgTypeDef* Args, uint8_t Count,
+                      void (*Write)(const char* Line, size_t Length));
+
+/**
+ * @brief Returns the reply keyword of a status.
+ * @param Status Status to describe.
+ * @return "ok", "unknown", "value", "type", "range" or "refused".
+ */
+const char* PARAM_StatusName(PARAM_StatusTypeDef Status);
+
+#endif /* INC_PARAM_H_ */
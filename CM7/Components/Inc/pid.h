@@ -12,29 +12,103 @@
 #ifndef INC_PID_H_
 #define INC_PID_H_
 
+/*
+ * Define PID_USE_FIXED_POINT in the compiler symbols to build the controller
+ * with Q16.16 saturating arithmetic instead of single precision float.
+ * The API stays the same; only the handle contents differ.
+ *
+ * The controller is a 2-DOF PID: u = Kp*(b*r - y) + I + D, where the
+ * integral acts on r - y and the filtered derivative on c*r - y.
+ * With the default c = 0 the derivative sees only the measurement, so
+ * setpoint steps do not kick the output. The derivative is low-pass filtered
+ * with a time constant Tf set on its own, so it stays filtered whatever the
+ * gains, including I+D and pure D tunings with Kp = 0.
+ *
+ * Gains are in engineering units per second: Ki acts on the time integral of
+ * the error [1/s] and Kd on its time derivative [s], so retuning is not needed
+ * when the loop rate changes.
+ */
+
 /* Public includes -----------------------------------------------------------*/
+#include "stdint.h"
+#ifdef USE_HAL_DRIVER
+#include "utils.h"
+#endif
 
 /* Public typedef ------------------------------------------------------------*/
+typedef enum {
+	PID_ANTIWINDUP_CLAMP = 0,   // integrator state clamped to the anti-windup limits
+	PID_ANTIWINDUP_CONDITIONAL, // + no integration while the actuator saturates in the error direction
+	PID_ANTIWINDUP_BACKCALC     // + integrator bled off by Kt*(applied - computed output)
+} PID_AntiWindupTypeDef;
+
+#ifdef PID_USE_FIXED_POINT
+typedef int32_t PID_Q16TypeDef; // signed Q16.16, range [-32768, 32768)
+
 typedef struct {
-	float SetPoint, y, u;
-	float sumError, lastError;
-	float Kp, Ki, Kd;
+	PID_Q16TypeDef SetPoint, y, u, uApplied;
+	PID_Q16TypeDef integral, dTerm, lastError;
+	PID_Q16TypeDef Kp, Ki, Kd, Kt;
+	PID_Q16TypeDef b, c, Tf;
+	PID_Q16TypeDef anti_windup_upperLimit, anti_windup_lowerLimit;
+	PID_AntiWindupTypeDef AntiWindup;
+	PID_Q16TypeDef dt;
+	uint32_t lastTime;
+	uint8_t timeValid;
+} PID_HandleTypeDef;
+#else
+typedef struct {
+	float SetPoint, y, u, uApplied;
+	float integral, dTerm, lastError;
+	float Kp, Ki, Kd, Kt;
+	float b, c, Tf;
 	float anti_windup_upperLimit, anti_windup_lowerLimit;
-	unsigned long long lastTime;
+	PID_AntiWindupTypeDef AntiWindup;
+	float dt;
+	uint32_t lastTime;
+	uint8_t timeValid;
 } PID_HandleTypeDef;
+#endif
 
 /* Public define -------------------------------------------------------------*/
+/* Timestamp source for PID_Calculate, override from the build to use another timer */
+#ifndef PID_TIMESTAMP
+#ifdef USE_HAL_DRIVER
+#define PID_TIMESTAMP()     DWT_GET_CYCLES()
+#define PID_TIMESTAMP_FREQ  SystemCoreClock
+#endif
+#endif
+#define PID_DEFAULT_TF  0.1f // derivative filter time constant [s]
+
+#ifdef PID_USE_FIXED_POINT
+#define PID_Q16_ONE  ((PID_Q16TypeDef)0x00010000)
+#define PID_Q16_MAX  ((PID_Q16TypeDef)INT32_MAX)
+#define PID_Q16_MIN  ((PID_Q16TypeDef)INT32_MIN)
+#endif
 
 /* Public macro --------------------------------------------------------------*/
+#ifdef PID_USE_FIXED_POINT
+/* Round-to-nearest conversions, usable in static initializers */
+#define PID_FLOAT2Q16(x) ((PID_Q16TypeDef)((x) * 65536.0f + (((x) >= 0) ? 0.5f : -0.5f)))
+#define PID_Q162FLOAT(q) ((float)(q) * (1.0f / 65536.0f))
+#define PID_PARAM(x)     PID_FLOAT2Q16(x)
+#else
+#define PID_PARAM(x)     (x)
+#endif
+
 #ifdef USE_HAL_DRIVER
 #define PID_INIT_HANDLE(KP, KI, KD, SETPOINT, ANTIWINDUP_UPPERLIMIT, ANTIWINDUP_LOWERLIMIT) \
   {                                                                                         \
-    .Kp = KP,                                                                               \
-	.Ki = KI,                                                                               \
-	.Kd = KD,                                                                               \
-	.SetPoint = SETPOINT,                                                                   \
-	.anti_windup_upperLimit = ANTIWINDUP_UPPERLIMIT,                                        \
-    .anti_windup_lowerLimit = ANTIWINDUP_LOWERLIMIT                                         \
+    .Kp = PID_PARAM(KP),                                                                    \
+	.Ki = PID_PARAM(KI),                                                                    \
+	.Kd = PID_PARAM(KD),                                                                    \
+	.SetPoint = PID_PARAM(SETPOINT),                                                        \
+	.anti_windup_upperLimit = PID_PARAM(ANTIWINDUP_UPPERLIMIT),                             \
+    .anti_windup_lowerLimit = PID_PARAM(ANTIWINDUP_LOWERLIMIT),                             \
+    .AntiWindup = PID_ANTIWINDUP_CLAMP,                                                     \
+    .b = PID_PARAM(1.0f),                                                                   \
+    .c = PID_PARAM(0.0f),                                                                   \
+    .Tf = PID_PARAM(PID_DEFAULT_TF)                                                         \
   }
 #endif
 
@@ -45,11 +119,11 @@ typedef struct {
  * @brief Initializes the PID controller with given parameters.
  * @param hpid Pointer to the PID_HandleTypeDef structure that holds the PID controller state.
  * @param Kp Proportional gain constant.
- * @param Ki Integral gain constant.
- * @param Kd Derivative gain constant.
+ * @param Ki Integral gain constant [1/s].
+ * @param Kd Derivative gain constant [s].
  * @param SetPoint The desired target value for the PID controller.
- * @param anti_windup_upperLimit The upper limit for anti-windup to prevent integral windup.
- * @param anti_windup_lowerLimit The lower limit for anti-windup to prevent integral windup.
+ * @param anti_windup_upperLimit The upper limit of the integral term state.
+ * @param anti_windup_lowerLimit The lower limit of the integral term state.
  * @note This function sets the initial tuning parameters and anti-windup limits for the PID controller.
  */
 void PID_Init(PID_HandleTypeDef* hpid, float Kp, float Ki, float Kd, float SetPoint, float anti_windup_upperLimit, float anti_windup_lowerLimit);
@@ -61,12 +135,21 @@ void PID_Init(PID_HandleTypeDef* hpid, float Kp, float Ki, float Kd, float SetPo
  */
 void PID_Reset(PID_HandleTypeDef* hpid);
 
+/**
+ * @brief Drops the time reference of PID_Calculate and PID_CalculateAt, keeping the controller state.
+ * @param hpid Pointer to the PID_HandleTypeDef structure that holds the PID controller state.
+ * @note The next step uses a zero time step, so the integral and the derivative filter are kept
+ *       but not advanced. Use it when the timestamps before and after are not comparable,
+ *       e.g. after the timestamp clock changed.
+ */
+void PID_ResetTime(PID_HandleTypeDef* hpid);
+
 /**
  * @brief Sets the PID controller's tuning parameters.
  * @param hpid Pointer to the PID_HandleTypeDef structure that holds the PID controller state.
  * @param Kp Proportional gain constant.
- * @param Ki Integral gain constant.
- * @param Kd Derivative gain constant.
+ * @param Ki Integral gain constant [1/s].
+ * @param Kd Derivative gain constant [s].
  * @note This function allows updating the PID tuning parameters (Kp, Ki, Kd) during operation.
  */
 void PID_SetTunings(PID_HandleTypeDef* hpid, float Kp, float Ki, float Kd);
@@ -79,15 +162,151 @@ void PID_SetTunings(PID_HandleTypeDef* hpid, float Kp, float Ki, float Kd);
  */
 void PID_SetReference(PID_HandleTypeDef* hpid, float SetPoint);
 
+/**
+ * @brief Sets the setpoint weights of the proportional and derivative terms.
+ * @param hpid Pointer to the PID_HandleTypeDef structure that holds the PID controller state.
+ * @param b Setpoint weight of the proportional term (1 = classic error feedback).
+ * @param c Setpoint weight of the derivative term (0 = derivative on measurement).
+ */
+void PID_SetWeighting(PID_HandleTypeDef* hpid, float b, float c);
+
+/**
+ * @brief Sets the time constant of the first-order derivative filter.
+ * @param hpid Pointer to the PID_HandleTypeDef structure that holds the PID controller state.
+ * @param Tf Filter time constant [s], independent of Kp and Kd. 0 disables the filter.
+ * @note Negative values are taken as 0. A fraction of Kd/Kp (Td/N, N = 5..20) is the usual choice,
+ *       one or two loop periods when Kp is 0.
+ */
+void PID_SetDerivativeFilter(PID_HandleTypeDef* hpid, float Tf);
+
+/**
+ * @brief Selects the anti-windup strategy of the PID controller.
+ * @param hpid Pointer to the PID_HandleTypeDef structure that holds the PID controller state.
+ * @param Mode One of PID_AntiWindupTypeDef.
+ * @param Kt Tracking gain used by PID_ANTIWINDUP_BACKCALC [1/s], Kt*dt should stay below 1.
+ * @note The integral state is clamped to the anti-windup limits in every mode.
+ */
+void PID_SetAntiWindup(PID_HandleTypeDef* hpid, PID_AntiWindupTypeDef Mode, float Kt);
+
+/**
+ * @brief Sets the anti-windup limits of the integral term state.
+ * @param hpid Pointer to the PID_HandleTypeDef structure that holds the PID controller state.
+ * @param anti_windup_upperLimit The upper limit of the integral term state.
+ * @param anti_windup_lowerLimit The lower limit of the integral term state.
+ * @note The integral state is clamped to the new limits at the next step.
+ */
+void PID_SetLimits(PID_HandleTypeDef* hpid, float anti_windup_upperLimit, float anti_windup_lowerLimit);
+
+/**
+ * @brief Reports the actuator value that was actually applied for the last output.
+ * @param hpid Pointer to the PID_HandleTypeDef structure that holds the PID controller state.
+ * @param Applied The applied actuator value, after saturation by the output stage.
+ * @note Call after each PID_Calculate; without it the output is assumed to be applied unchanged.
+ */
+void PID_TrackOutput(PID_HandleTypeDef* hpid, float Applied);
+
 /**
  * @brief Calculates the new control output based on the current error.
  * @param hpid Pointer to the PID_HandleTypeDef structure that holds the PID controller state.
  * @param y The current process variable (measured value) to compare with the setpoint.
  * @return The control output that the PID controller generates.
- * @note This function computes the PID control output based on the current error between the setpoint and the measured value (y).
+ * @note The time step is measured with PID_TIMESTAMP() since the previous call.
+ *       The first call after PID_Reset() uses a zero time step (proportional action only).
+ *       A NaN measurement is replaced by the previous one.
  */
 float PID_Calculate(PID_HandleTypeDef* hpid, float y);
 
+/**
+ * @brief Calculates the new control output for a measurement taken at a given time.
+ * @param hpid Pointer to the PID_HandleTypeDef structure that holds the PID controller state.
+ * @param y The current process variable (measured value) to compare with the setpoint.
+ * @param Timestamp PID_TIMESTAMP() value of the instant y belongs to.
+ * @return The control output that the PID controller generates.
+ * @note As PID_Calculate, with the time step measured between the given timestamps, so the
+ *       delay between sampling and the call does not enter the integral and derivative terms.
+ */
+float PID_CalculateAt(PID_HandleTypeDef* hpid, float y, uint32_t Timestamp);
+
+/**
+ * @brief Calculates the new control output for an explicit time step.
+ * @param hpid Pointer to the PID_HandleTypeDef structure that holds the PID controller state.
+ * @param y The current process variable (measured value) to compare with the setpoint.
+ * @param dt Time elapsed since the previous step [s].
+ * @return The control output that the PID controller generates.
+ * @note A non-positive dt freezes the integrator and zeroes the derivative term for this step;
+ *       the next step differentiates against this one.
+ */
+float PID_CalculateDt(PID_HandleTypeDef* hpid, float y, float dt);
+
+/**
+ * @brief Returns the current reference (setpoint) value of the PID controller.
+ * @param hpid Pointer to the PID_HandleTypeDef structure that holds the PID controller state.
+ * @return The setpoint in engineering units.
+ */
+float PID_GetReference(const PID_HandleTypeDef* hpid);
+
+/**
+ * @brief Returns the current tuning parameters of the PID controller.
+ * @param hpid Pointer to the PID_HandleTypeDef structure that holds the PID controller state.
+ * @param Kp Output for the proportional gain constant.
+ * @param Ki Output for the integral gain constant.
+ * @param Kd Output for the derivative gain constant.
+ */
+void PID_GetTunings(const PID_HandleTypeDef* hpid, float* Kp, float* Ki, float* Kd);
+
+/**
+ * @brief Returns the setpoint weights of the proportional and derivative terms.
+ * @param hpid Pointer to the PID_HandleTypeDef structure that holds the PID controller state.
+ * @param b Output for the setpoint weight of the proportional term.
+ * @param c Output for the setpoint weight of the derivative term.
+ */
+void PID_GetWeighting(const PID_HandleTypeDef* hpid, float* b, float* c);
+
+/**
+ * @brief Returns the time constant of the derivative filter.
+ * @param hpid Pointer to the PID_HandleTypeDef structure that holds the PID controller state.
+ * @return The filter time constant Tf [s], 0 when the filter is disabled.
+ */
+float PID_GetDerivativeFilter(const PID_HandleTypeDef* hpid);
+
+/**
+ * @brief Returns the anti-windup strategy of the PID controller.
+ * @param hpid Pointer to the PID_HandleTypeDef structure that holds the PID controller state.
+ * @param Mode Output for the strategy.
+ * @param Kt Output for the tracking gain [1/s].
+ */
+void PID_GetAntiWindup(const PID_HandleTypeDef* hpid, PID_AntiWindupTypeDef* Mode, float* Kt);
+
+/**
+ * @brief Returns the anti-windup limits of the integral term state.
+ * @param hpid Pointer to the PID_HandleTypeDef structure that holds the PID controller state.
+ * @param anti_windup_upperLimit Output for the upper limit.
+ * @param anti_windup_lowerLimit Output for the lower limit.
+ */
+void PID_GetLimits(const PID_HandleTypeDef* hpid, float* anti_windup_upperLimit, float* anti_windup_lowerLimit);
+
+/**
+ * @brief Returns the contributions of the last computed output.
+ * @param hpid Pointer to the PID_HandleTypeDef structure that holds the PID controller state.
+ * @param P Output for the proportional term.
+ * @param I Output for the integral term.
+ * @param D Output for the derivative term.
+ * @note P + I + D equals the last output returned by PID_Calculate.
+ */
+void PID_GetTerms(const PID_HandleTypeDef* hpid, float* P, float* I, float* D);
+
+#ifdef PID_USE_FIXED_POINT
+/**
+ * @brief Calculates the new control output using Q16.16 saturating arithmetic only.
+ * @param hpid Pointer to the PID_HandleTypeDef structure that holds the PID controller state.
+ * @param y The current process variable in Q16.16.
+ * @param dt Time elapsed since the previous step in Q16.16 seconds.
+ * @return The control output in Q16.16.
+ * @note Bit-exact and FPU free, so it can be called from interrupt context without lazy FPU stacking.
+ *       A non-positive dt freezes the integrator and zeroes the derivative term, as in PID_CalculateDt.
+ */
+PID_Q16TypeDef PID_CalculateQ16(PID_HandleTypeDef* hpid, PID_Q16TypeDef y, PID_Q16TypeDef dt);
+#endif
 
 
 #endif /* INC_PID_H_ */
@@ -0,0 +1,59 @@
+/**
+  ******************************************************************************
+  * @file     : plant.h
+  * @author   : MS    Mateusz.Stasiak@student.put.poznan.pl
+  * @version  : 1.0.0
+  * @date     : Oct 17, 2026
+  * @brief    : First-order-plus-dead-time model of the heated resistor and LM35.
+  *
+  *             T(s) - Tamb = K * exp(-L*s) / (tau*s + 1) * Duty(s)
+  *
+  ******************************************************************************
+  */
+
+#ifndef INC_PLANT_H_
+#define INC_PLANT_H_
+
+/* Public includes -----------------------------------------------------------*/
+#include <stdint.h>
+
+/* Public typedef ------------------------------------------------------------*/
+#define PLANT_MAX_DELAY_STEPS  512 // dead-time buffer length [steps]
+
+typedef struct {
+	float Gain;        // [degC/%], steady-state rise per percent of duty
+	float Tau;         // [s], dominant thermal time constant
+	float DeadTime;    // [s], transport delay from resistor to sensor
+	float Ambient;     // [degC]
+	float Ts;          // [s], integration step
+	float Temperature; // [degC], sensor temperature
+	float a;           // exp(-Ts/Tau), precomputed by PLANT_Init
+	uint16_t DelayLength;
+	uint16_t DelayIndex;
+	float Delay[PLANT_MAX_DELAY_STEPS];
+} PLANT_HandleTypeDef;
+
+/* Public define -------------------------------------------------------------*/
+
+/* Public macro --------------------------------------------------------------*/
+
+/* Public variables ----------------------------------------------------------*/
+
+/* Public function prototypes ------------------------------------------------*/
+/**
+ * @brief Initializes the plant model at thermal equilibrium with the ambient.
+ * @param hplant Pointer to the PLANT_HandleTypeDef structure with Gain, Tau, DeadTime, Ambient and Ts set.
+ * @note DeadTime is rounded to whole steps and limited to PLANT_MAX_DELAY_STEPS.
+ */
+void PLANT_Init(PLANT_HandleTypeDef *hplant);
+
+/**
+ * @brief Advances the plant by one integration step.
+ * @param hplant Pointer to the PLANT_HandleTypeDef structure.
+ * @param Duty Heater duty applied during the step [%].
+ * @return The sensor temperature at the end of the step [degC].
+ * @note Uses the exact zero-order-hold discretisation, so it is stable for any Ts.
+ */
+float PLANT_Step(PLANT_HandleTypeDef *hplant, float Duty);
+
+#endif /* INC_PLANT_H_ */
@@ -16,6 +16,7 @@
 #ifdef USE_HAL_DRIVER
 #include "stm32h7xx_hal.h"
 #endif
+#include "utils.h"
 
 /* Public typedef ------------------------------------------------------------*/
 
@@ -37,11 +38,26 @@
 
 /* Public function prototypes ------------------------------------------------*/
 
+/**
+ * @brief Arms the potentiometer ADC so that conversions follow its hardware trigger.
+ * @param hadc Pointer to the ADC_HandleTypeDef structure containing the ADC configuration.
+ * @return HAL status of the ADC start.
+ */
+HAL_StatusTypeDef POT_Start(ADC_HandleTypeDef *hadc);
+
+/**
+ * @brief Changes the sampling time and hardware oversampling of the potentiometer ADC at run time.
+ * @param hadc Pointer to the ADC_HandleTypeDef structure containing the ADC configuration.
+ * @param Config Pointer to the ADC_SamplingConfigTypeDef structure with the new settings.
+ * @return HAL status; on HAL_ERROR the ADC is left stopped.
+ */
+HAL_StatusTypeDef POT_ConfigADC(ADC_HandleTypeDef *hadc, const ADC_SamplingConfigTypeDef *Config);
+
 /**
  * @brief Retrieves the raw ADC register value for the potentiometer.
  * @param hadc Pointer to the ADC_HandleTypeDef structure containing the ADC configuration.
  * @return The raw ADC register value corresponding to the potentiometer reading.
- * @note This function reads the ADC register value from the potentiometer, which is used to determine its analog position.
+ * @note This function returns the result of the last triggered conversion without waiting, which is used to determine its analog position.
  */
 uint16_t POT_GetReg(ADC_HandleTypeDef *hadc);
 
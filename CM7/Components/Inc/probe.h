@@ -0,0 +1,80 @@
+/**
+  ******************************************************************************
+  * @file     : probe.h
+  * @author   : MS    Mateusz.Stasiak@student.put.poznan.pl
+  * @version  : 1.0.0
+  * @date     : Oct 17, 2026
+  * @brief    : Named DWT cycle counter probes for execution time profiling.
+  *
+  ******************************************************************************
+  */
+
+#ifndef INC_PROBE_H_
+#define INC_PROBE_H_
+
+/* Public includes -----------------------------------------------------------*/
+#include "stdint.h"
+#include "stddef.h"
+#include "utils.h"
+
+/* Public typedef ------------------------------------------------------------*/
+#define PROBE_HIST_BINS  24 // log2 bins, the last one also holds everything >= 2^22 cycles
+
+typedef struct {
+	const char *Name;
+	uint32_t Start;
+	uint32_t Count;
+	uint32_t Min, Max;
+	uint64_t Sum;
+	uint32_t Histogram[PROBE_HIST_BINS];
+} PROBE_HandleTypeDef;
+
+/* Public define -------------------------------------------------------------*/
+/* Set to 0 from the build to compile all probe macros out */
+#ifndef PROBE_ENABLE
+#define PROBE_ENABLE 1
+#endif
+
+/* Public macro --------------------------------------------------------------*/
+#define PROBE_INIT_HANDLE(NAME) \
+  {                             \
+    .Name = NAME,               \
+    .Min = UINT32_MAX           \
+  }
+
+#if PROBE_ENABLE
+#define PROBE_START(hprobe) ((hprobe)->Start = DWT_GET_CYCLES())
+#define PROBE_STOP(hprobe)  PROBE_Record((hprobe), DWT_GET_CYCLES() - (hprobe)->Start)
+#else
+#define PROBE_START(hprobe) ((void)0)
+#define PROBE_STOP(hprobe)  ((void)0)
+#endif
+
+/* Public variables ----------------------------------------------------------*/
+
+/* Public function prototypes ------------------------------------------------*/
+/**
+ * @brief Clears the collected statistics of a probe.
+ * @param hprobe Pointer to the PROBE_HandleTypeDef structure that holds the statistics.
+ */
+void PROBE_Reset(PROBE_HandleTypeDef* hprobe);
+
+/**
+ * @brief Adds one measured duration to the probe statistics.
+ * @param hprobe Pointer to the PROBE_HandleTypeDef structure that holds the statistics.
+ * @param Cycles Measured duration in DWT cycles.
+ * @note Histogram bin k counts durations in [2^(k-1), 2^k) cycles, bin 0 counts zero-length runs.
+ */
+void PROBE_Record(PROBE_HandleTypeDef* hprobe, uint32_t Cycles);
+
+/**
+ * @brief Formats the probe statistics as one text line for the UART.
+ * @param hprobe Pointer to the PROBE_HandleTypeDef structure that holds the statistics.
+ * @param Buffer Destination buffer.
+ * @param Size Size of the destination buffer in bytes.
+ * @return Number of characters written, excluding the terminating null.
+ * @note Times are in microseconds; only non-empty histogram bins are listed as "bin:count".
+ */
+int PROBE_Format(const PROBE_HandleTypeDef* hprobe, char* Buffer, size_t Size);
+
+#endif /* INC_PROBE_H_ */
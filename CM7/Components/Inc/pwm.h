@@ -22,9 +22,11 @@ typedef struct {
 	TIM_HandleTypeDef *htim;
 	uint32_t Channel;
 	int Duty;
+	int Min, Max;  // output limits [%], PWM_WriteDuty saturates to them
 } PWM_HandleTypeDef;
 
 /* Public define -------------------------------------------------------------*/
+#define PWM_DUTY_MAX  100
 
 /* Public macro --------------------------------------------------------------*/
 #ifdef USE_HAL_DRIVER
@@ -32,7 +34,9 @@ typedef struct {
   {                                            \
     .htim = TIMER_HANDLE,                      \
     .Channel = CHANNEL,                        \
-    .Duty = 0                                  \
+    .Duty = 0,                                 \
+    .Min = 0,                                  \
+    .Max = PWM_DUTY_MAX                        \
   }
 #endif
 
@@ -51,9 +55,20 @@ void PWM_Init(PWM_HandleTypeDef* hpwm);
  * @param hpwm Pointer to the PWM_HandleTypeDef structure containing the PWM configuration.
  * @param duty The duty cycle value to set (0-100).
  * @note This function adjusts the duty cycle of the PWM signal, controlling the signal's high time relative to the total period.
+ *       The value is saturated to the output limits, see PWM_SetLimits.
  */
 void PWM_WriteDuty(PWM_HandleTypeDef* hpwm, int duty);
 
+/**
+ * @brief Sets the output limits of the PWM signal.
+ * @param hpwm Pointer to the PWM_HandleTypeDef structure containing the PWM configuration.
+ * @param Min Lowest duty cycle that is ever written [%].
+ * @param Max Highest duty cycle that is ever written [%].
+ * @return HAL_OK, or HAL_ERROR without any change unless 0 <= Min <= Max <= PWM_DUTY_MAX.
+ * @note The new limits apply from the next PWM_WriteDuty.
+ */
+HAL_StatusTypeDef PWM_SetLimits(PWM_HandleTypeDef* hpwm, int Min, int Max);
+
 /**
  * @brief Reads the current duty cycle of the PWM signal.
  * @param hpwm Pointer to the PWM_HandleTypeDef structure containing the PWM configuration.
@@ -0,0 +1,85 @@
+/**
+  ******************************************************************************
+  * @file     : scheduler.h
+  * @author   : MS    Mateusz.Stasiak@student.put.poznan.pl
+  * @version  : 1.0.0
+  * @date     : Oct 17, 2026
+  * @brief    : Cooperative run-to-completion task scheduler.
+  *
+  ******************************************************************************
+  */
+
+#ifndef INC_SCHEDULER_H_
+#define INC_SCHEDULER_H_
+
+/*
+ * Tasks run to completion from the main loop and never preempt each other.
+ * SCHED_Release records a release at once, but the released task starts only
+ * when the task running at that moment returns, so its start may be late by
+ * the longest run of any task. Anything that must happen at a fixed instant
+ * (ADC sampling) belongs in a hardware trigger or the releasing interrupt,
+ * not in a task, and every task has to stay short and bounded.
+ */
+
+/* Public includes -----------------------------------------------------------*/
+#include "stdint.h"
+
+/* Public typedef ------------------------------------------------------------*/
+typedef void (*SCHED_TaskFunction)(void);
+
+typedef struct {
+	SCHED_TaskFunction Function;
+	volatile uint32_t Released;
+	uint32_t Taken;
+	uint32_t Runs;
+	uint32_t Overruns;
+} SCHED_TaskTypeDef;
+
+typedef struct {
+	SCHED_TaskTypeDef *Tasks;
+	uint8_t nTasks;
+} SCHED_HandleTypeDef;
+
+/* Public define -------------------------------------------------------------*/
+
+/* Public macro --------------------------------------------------------------*/
+#define SCHED_TASK_INIT(FUNCTION) \
+  {                               \
+    .Function = FUNCTION          \
+  }
+
+#define SCHED_INIT_HANDLE(TASKS)                       \
+  {                                                    \
+    .Tasks = TASKS,                                    \
+    .nTasks = (uint8_t)(sizeof(TASKS)/sizeof(TASKS[0])) \
+  }
+
+/* Public variables ----------------------------------------------------------*/
+
+/* Public function prototypes ------------------------------------------------*/
+/**
+ * @brief Releases a task so that it runs on the next dispatch.
+ * @param hsched Pointer to the SCHED_HandleTypeDef structure that holds the task table.
+ * @param TaskId Index of the task in the task table (0 is the highest priority).
+ * @note Safe to call from interrupt context as long as each task has a single releasing context.
+ *       A release that arrives before the previous one was dispatched is counted as an overrun.
+ */
+void SCHED_Release(SCHED_HandleTypeDef* hsched, uint8_t TaskId);
+
+/**
+ * @brief Runs the highest priority released task to completion.
+ * @param hsched Pointer to the SCHED_HandleTypeDef structure that holds the task table.
+ * @return 1 if a task was run, 0 if no task was pending.
+ * @note Intended to be called repeatedly from the main loop.
+ */
+uint8_t SCHED_Dispatch(SCHED_HandleTypeDef* hsched);
+
+/**
+ * @brief Returns the number of releases of a task that were lost because it had not run yet.
+ * @param hsched Pointer to the SCHED_HandleTypeDef structure that holds the task table.
+ * @param TaskId Index of the task in the task table.
+ * @return Overrun count of the task.
+ */
+uint32_t SCHED_GetOverruns(const SCHED_HandleTypeDef* hsched, uint8_t TaskId);
+
+#endif /* INC_SCHEDULER_H_ */
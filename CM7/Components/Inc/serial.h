@@ -0,0 +1,133 @@
+/**
+  ******************************************************************************
+  * @file     : serial.h
+  * @author   : MS    Mateusz.Stasiak@student.put.poznan.pl
+  * @version  : 1.0.0
+  * @date     : Oct 17, 2026
+  * @brief    : Non-blocking UART transmit and receive through DMA ring buffers.
+  *
+  ******************************************************************************
+  */
+
+#ifndef INC_SERIAL_H_
+#define INC_SERIAL_H_
+
+/* Public includes -----------------------------------------------------------*/
+#ifdef USE_HAL_DRIVER
+#include "stm32h7xx_hal.h"
+#endif
+#include "stdint.h"
+
+/* Public typedef ------------------------------------------------------------*/
+typedef enum {
+	SERIAL_DROP_WRITE = 0,   // a write that does not fit is dropped whole, lines stay intact
+	SERIAL_DROP_TRUNCATE     // the part of a write that fits is sent, the rest is dropped
+} SERIAL_DropPolicyTypeDef;
+
+typedef struct {
+	UART_HandleTypeDef *huart;
+	uint8_t *TxBuffer;                 // ring storage, must be reachable by the DMA (.dma_buffer)
+	uint16_t TxSize;                   // ring size in bytes, a power of two
+	volatile uint16_t TxHead;          // free-running, written by the producer only
+	volatile uint16_t TxTail;          // free-running, written by the DMA completion only
+	uint16_t TxChunk;                  // bytes in the DMA transfer in progress
+	volatile uint8_t TxBusy;           // a DMA transfer is in progress
+	SERIAL_DropPolicyTypeDef DropPolicy;
+	uint32_t TxDroppedBytes;           // bytes lost to a full ring
+	uint32_t TxDroppedWrites;          // writes that lost at least one byte
+	uint16_t TxHighWater;              // largest ring fill seen by a write
+	uint8_t *RxBuffer;                 // circular DMA target, reachable by the DMA (.dma_buffer)
+	uint16_t RxSize;                   // ring size in bytes, a power of two
+	volatile uint16_t RxHead;          // free-running, advanced by the receive events only
+	uint16_t RxTail;                   // free-running, advanced by the reader only
+	uint16_t RxDmaPos;                 // DMA write index at the last receive event
+	uint32_t RxOverruns;               // bytes overwritten by the DMA before they were read
+	uint32_t RxErrors;                 // UART errors that restarted the reception
+	volatile uint8_t RxRestart;        // reception stopped by an error, restarted by the reader
+} SERIAL_HandleTypeDef;
+
+/* Public define -------------------------------------------------------------*/
+
+/* Public macro --------------------------------------------------------------*/
+#define SERIAL_INIT_HANDLE(UART_HANDLE, TX_BUFFER, TX_SIZE, RX_BUFFER, RX_SIZE) \
+  {                                                                          \
+    .huart = UART_HANDLE,                                                    \
+    .TxBuffer = TX_BUFFER,                                                   \
+    .TxSize = TX_SIZE,                                                       \
+    .DropPolicy = SERIAL_DROP_WRITE,                                         \
+    .RxBuffer = RX_BUFFER,                                                   \
+    .RxSize = RX_SIZE                                                        \
+  }
+
+/* Public variables ----------------------------------------------------------*/
+
+/* Public function prototypes ------------------------------------------------*/
+/**
+ * @brief Queues bytes for transmission and starts the DMA if it is idle.
+ * @param hserial Pointer to the SERIAL_HandleTypeDef structure.
+ * @param Data Bytes to send; they are copied, the caller may reuse the buffer at once.
+ * @param Length Number of bytes.
+ * @return HAL_OK if all bytes were queued, HAL_BUSY if some or all were dropped.
+ * @note Never waits for the UART. There must be a single producer: calls must not
+ *       preempt each other (e.g. write from tasks only, or from one interrupt only).
+ */
+HAL_StatusTypeDef SERIAL_Write(SERIAL_HandleTypeDef* hserial, const uint8_t* Data, uint16_t Length);
+
+/**
+ * @brief Returns the number of bytes that can be queued without dropping.
+ * @param hserial Pointer to the SERIAL_HandleTypeDef structure.
+ */
+uint16_t SERIAL_TxFree(const SERIAL_HandleTypeDef* hserial);
+
+/**
+ * @brief Starts the circular DMA reception with the idle-line event.
+ * @param hserial Pointer to the SERIAL_HandleTypeDef structure.
+ * @return HAL status of the UART.
+ * @note Discards anything not read yet; call only while the reception is stopped.
+ */
+HAL_StatusTypeDef SERIAL_StartReceive(SERIAL_HandleTypeDef* hserial);
+
+/**
+ * @brief Copies received bytes out of the ring.
+ * @param hserial Pointer to the SERIAL_HandleTypeDef structure.
+ * @param Data Destination.
+ * @param Length Maximum number of bytes.
+ * @return Number of bytes copied, 0 if nothing is pending.
+ * @note Single reader. Bytes the DMA overwrote before they were read are skipped and counted.
+ */
+uint16_t SERIAL_Read(SERIAL_HandleTypeDef* hserial, uint8_t* Data, uint16_t Length);
+
+/**
+ * @brief Recomputes the baud rate divider after the UART kernel clock changed.
+ * @param hserial Pointer to the SERIAL_HandleTypeDef structure.
+ * @param KernelHz New UART kernel clock [Hz].
+ * @return HAL_OK, HAL_BUSY if bytes are still queued or on the line, HAL_ERROR unless oversampling by 16.
+ * @note The UART is disabled for a few cycles: a byte arriving meanwhile is lost,
+ *       the circular reception continues where it was.
+ */
+HAL_StatusTypeDef SERIAL_Retime(SERIAL_HandleTypeDef* hserial, uint32_t KernelHz);
+
+/**
+ * @brief Must be called from HAL_UARTEx_RxEventCallback for the UART of the handle.
+ * @param hserial Pointer to the SERIAL_HandleTypeDef structure.
+ * @param Size DMA write index reported by the HAL (idle line, half or full buffer).
+ * @note Only publishes the new bytes, constant time.
+ */
+void SERIAL_RxEventCallback(SERIAL_HandleTypeDef* hserial, uint16_t Size);
+
+/**
+ * @brief Must be called from HAL_UART_TxCpltCallback for the UART of the handle.
+ * @param hserial Pointer to the SERIAL_HandleTypeDef structure.
+ * @note Releases the sent chunk and starts the DMA for the next one.
+ */
+void SERIAL_TxCpltCallback(SERIAL_HandleTypeDef* hserial);
+
+/**
+ * @brief Must be called from HAL_UART_ErrorCallback for the UART of the handle.
+ * @param hserial Pointer to the SERIAL_HandleTypeDef structure.
+ * @note If the error aborted the transmission, the chunk is dropped and the ring resumes.
+ *       If it stopped the reception, the next SERIAL_Read restarts it.
+ */
+void SERIAL_ErrorCallback(SERIAL_HandleTypeDef* hserial);
+
+#endif /* INC_SERIAL_H_ */
@@ -0,0 +1,125 @@
+/**
+  ******************************************************************************
+  * @file     : telemetry.h
+  * @author   : MS    Mateusz.Stasiak@student.put.poznan.pl
+  * @version  : 1.0.0
+  * @date     : Oct 17, 2026
+  * @brief    : Binary telemetry frames: fixed little-endian payload, CRC-16, COBS framing.
+  *
+  ******************************************************************************
+  */
+
+#ifndef INC_TELEMETRY_H_
+#define INC_TELEMETRY_H_
+
+/*
+ * Frame on the wire: COBS(payload | CRC16 little-endian) followed by a single 0x00.
+ * The delimiter never appears inside a frame, so a receiver resynchronises at the
+ * next zero after any lost byte. CRC-16/CCITT-FALSE (poly 0x1021, init 0xFFFF)
+ * covers the payload.
+ *
+ * Payload version 1, little-endian, TELEMETRY_PAYLOAD_SIZE bytes:
+ *   off  size  field
+ *     0   u8   Version      TELEMETRY_VERSION
+ *     1   u8   Type         TELEMETRY_TYPE_SAMPLE
+ *     2   u16  Sequence     increments per sample, gaps mean dropped frames
+ *     4   u32  TimeMs       HAL tick [ms]
+ *     8   u16  AdcRaw       raw LM35 ADC code
+ *    10   u16  Duty         applied PWM duty [%]
+ *    12   f32  Temperature  filtered temperature [degC]
+ *    16   f32  SetPoint     [degC]
+ *    20   f32  P            proportional term
+ *    24   f32  I            integral term
+ *    28   f32  D            derivative term
+ *
+ * The functions only depend on the standard headers, so host tools can share them.
+ */
+
+/* Public includes -----------------------------------------------------------*/
+#include "stdint.h"
+#include "stddef.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Public typedef ------------------------------------------------------------*/
+typedef struct {
+	uint16_t Sequence;
+	uint32_t TimeMs;
+	uint16_t AdcRaw;
+	uint16_t Duty;
+	float Temperature;
+	float SetPoint;
+	float P, I, D;
+} TELEMETRY_SampleTypeDef;
+
+typedef enum {
+	TELEMETRY_OK = 0,
+	TELEMETRY_ERROR_COBS,     // malformed COBS block
+	TELEMETRY_ERROR_LENGTH,   // decoded size is not a version 1 sample
+	TELEMETRY_ERROR_CRC,      // payload corrupted
+	TELEMETRY_ERROR_VERSION   // unknown version or frame type
+} TELEMETRY_StatusTypeDef;
+
+/* Public define -------------------------------------------------------------*/
+#define TELEMETRY_VERSION       1U
+#define TELEMETRY_TYPE_SAMPLE   1U
+#define TELEMETRY_DELIMITER     0x00U
+#define TELEMETRY_PAYLOAD_SIZE  32U
+#define TELEMETRY_RAW_SIZE      (TELEMETRY_PAYLOAD_SIZE + 2U)         // payload and CRC
+#define TELEMETRY_FRAME_MAX     (TELEMETRY_RAW_SIZE + 1U + 1U)        // COBS overhead and delimiter, raw size < 254
+
+/* Public macro --------------------------------------------------------------*/
+
+/* Public variables ----------------------------------------------------------*/
+
+/* Public function prototypes ------------------------------------------------*/
+/**
+ * @brief Encodes a sample into a complete frame, delimiter included.
+ * @param Sample Pointer to the sample.
+ * @param Buffer Destination, at least TELEMETRY_FRAME_MAX bytes.
+ * @return Number of bytes written.
+ */
+size_t TELEMETRY_Encode(const TELEMETRY_SampleTypeDef* Sample, uint8_t* Buffer);
+
+/**
+ * @brief Decodes one frame.
+ * @param Frame Bytes between two delimiters, the delimiter itself excluded.
+ * @param Length Number of bytes.
+ * @param Sample Output, valid only when TELEMETRY_OK is returned.
+ * @return TELEMETRY_OK or the reason the frame was rejected.
+ */
+TELEMETRY_StatusTypeDef TELEMETRY_Decode(const uint8_t* Frame, size_t Length, TELEMETRY_SampleTypeDef* Sample);
+
+/**
+ * @brief Calculates CRC-16/CCITT-FALSE.
+ * @param Data Input bytes.
+ * @param Length Number of bytes.
+ * @return The CRC, 0x29B1 for "123456789".
+ */
+uint16_t TELEMETRY_Crc16(const uint8_t* Data, size_t Length);
+
+/**
+ * @brief COBS-encodes a block, without the trailing delimiter.
+ * @param In Input bytes.
+ * @param Length Number of input bytes.
+ * @param Out Destination, at least Length + Length/254 + 1 bytes; must not overlap In.
+ * @return Number of bytes written, never containing 0x00.
+ */
+size_t TELEMETRY_CobsEncode(const uint8_t* In, size_t Length, uint8_t* Out);
+
+/**
+ * @brief Decodes a COBS block.
+ * @param In Encoded bytes, delimiter excluded.
+ * @param Length Number of encoded bytes.
+ * @param Out Destination, at least Length bytes; may be the same buffer as In.
+ * @return Number of decoded bytes, 0 if the block is malformed.
+ */
+size_t TELEMETRY_CobsDecode(const uint8_t* In, size_t Length, uint8_t* Out);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* INC_TELEMETRY_H_ */
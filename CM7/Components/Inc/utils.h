@@ -13,8 +13,20 @@
 #define INC_UTILS_H_
 
 /* Public includes -----------------------------------------------------------*/
+#ifdef USE_HAL_DRIVER
+#include "stm32h7xx_hal.h"
+#endif
 
 /* Public typedef ------------------------------------------------------------*/
+#ifdef USE_HAL_DRIVER
+typedef struct {
+	uint32_t Channel;           // ADC_CHANNEL_x
+	uint32_t SamplingTime;      // ADC_SAMPLETIME_x
+	uint32_t OversamplingRatio; // 1 (oversampler off) .. 1024
+	uint32_t RightBitShift;     // ADC_RIGHTBITSHIFT_x
+	uint32_t TriggeredMode;     // ADC_TRIGGEREDMODE_SINGLE_TRIGGER or ADC_TRIGGEREDMODE_MULTI_TRIGGER
+} ADC_SamplingConfigTypeDef;
+#endif
 
 /* Public define -------------------------------------------------------------*/
 
@@ -43,8 +55,53 @@
         } \
     } while (0)
 
+/*
+ *---------------------------------------
+ *   DWT Cycle Counter Macros
+ *---------------------------------------
+ */
+
+#define DWT_GET_CYCLES() (DWT->CYCCNT)
+#define DWT_CYCLES2US(cycles) ((float)(cycles) / (float)(SystemCoreClock/1000000U))
+
+/*
+ *---------------------------------------
+ *   Memory Placement Macros
+ *---------------------------------------
+ *
+ * Hot code and state of the CM7 control path go to the tightly coupled
+ * memories (zero wait states, never cached). The CM7 startup copies both
+ * sections from flash; zero-initialised DTCM variables are copied as well.
+ * On the CM4 and the host the macros expand to nothing.
+ */
+
+#ifdef CORE_CM7
+#define ITCM_FUNC __attribute__((section(".itcm_text")))
+#define DTCM_DATA __attribute__((section(".dtcm_data")))
+#else
+#define ITCM_FUNC
+#define DTCM_DATA
+#endif
+
 /* Public variables ----------------------------------------------------------*/
 
 /* Public function prototypes ------------------------------------------------*/
 
+/**
+ * @brief Enables the DWT cycle counter used for timestamps.
+ * @note Must be called once at startup before DWT_GET_CYCLES() is used.
+ */
+void DWT_Init(void);
+
+#ifdef USE_HAL_DRIVER
+/**
+ * @brief Applies sampling time and hardware oversampling settings to a stopped ADC.
+ * @param hadc Pointer to the ADC_HandleTypeDef structure containing the ADC configuration.
+ * @param Config Pointer to the requested sampling configuration.
+ * @return HAL_ERROR if the ratio is out of range or the shift would leave results wider than 16 bits.
+ * @note Conversions must be stopped by the caller and restarted afterwards.
+ */
+HAL_StatusTypeDef ADC_ConfigSampling(ADC_HandleTypeDef *hadc, const ADC_SamplingConfigTypeDef *Config);
+#endif
+
 #endif /* INC_UTILS_H_ */
@@ -0,0 +1,208 @@
+/**
+  ******************************************************************************
+  * @file     : clock.c
+  * @author   : MS    Mateusz.Stasiak@student.put.poznan.pl
+  * @version  : 1.0.0
+  * @date     : Oct 17, 2026
+  * @brief    : System clock profiles and the peripheral timings derived from them.
+  *
+  ******************************************************************************
+  */
+
+/* Private includes ----------------------------------------------------------*/
+#include "clock.h"
+
+/* Private typedef -----------------------------------------------------------*/
+
+/* Private define ------------------------------------------------------------*/
+#define CLK_I2C_TICK_MAX_HZ  4000000U // prescaled I2C tick of 250 ns or shorter
+#define CLK_I2C_LOW_NS       5700U    // SCL low, standard mode minimum 4.7 us
+#define CLK_I2C_HIGH_NS      4300U    // SCL high, standard mode minimum 4.0 us; with the low
+                                      // phase a full 10 us, synchronisation only slows the bus
+#define CLK_I2C_HOLD_NS      500U     // data hold after SCL falls
+#define CLK_I2C_SETUP_NS     1250U    // data setup before SCL rises, minimum 250 ns plus rise time
+
+/* Private macro -------------------------------------------------------------*/
+#define CLK_CEIL_DIV(A, B)  (((A) + (B) - 1U) / (B))
+#define CLK_MIN(A, B)       (((A) < (B)) ? (A) : (B))
+
+/* Timers on APB2, all the others are on APB1 */
+#define CLK_IS_APB2_TIMER(INSTANCE) \
+  ((INSTANCE) == TIM1 || (INSTANCE) == TIM8 || (INSTANCE) == TIM15 || (INSTANCE) == TIM16 || (INSTANCE) == TIM17)
+
+/* Private variables ---------------------------------------------------------*/
+
+/* Public variables ----------------------------------------------------------*/
+
+/* Private function prototypes -----------------------------------------------*/
+
+/* Public function prototypes ------------------------------------------------*/
+
+/* Private functions ---------------------------------------------------------*/
+
+/**
+ * @brief Fills the bus configuration of the nominal profile (HSI, CubeMX defaults).
+ */
+static void CLK_NominalBuses(RCC_ClkInitTypeDef* Clk)
+{
+	Clk->ClockType = RCC_CLOCKTYPE_HCLK | RCC_CLOCKTYPE_SYSCLK
+	               | RCC_CLOCKTYPE_PCLK1 | RCC_CLOCKTYPE_PCLK2
+	               | RCC_CLOCKTYPE_D3PCLK1 | RCC_CLOCKTYPE_D1PCLK1;
+	Clk->SYSCLKSource = RCC_SYSCLKSOURCE_HSI;
+	Clk->SYSCLKDivider = RCC_SYSCLK_DIV1;
+	Clk->AHBCLKDivider = RCC_HCLK_DIV1;
+	Clk->APB3CLKDivider = RCC_APB3_DIV1;
+	Clk->APB1CLKDivider = RCC_APB1_DIV2;
+	Clk->APB2CLKDivider = RCC_APB2_DIV1;
+	Clk->APB4CLKDivider = RCC_APB4_DIV1;
+}
+
+/* Public functions ----------------------------------------------------------*/
+
+/**
+ * @brief Switches the system clock to a profile.
+ * @param Profile One of CLK_ProfileTypeDef.
+ * @return HAL_OK, HAL_ERROR for an unknown profile or a failed switch (SYSCLK is then HSI).
+ */
+HAL_StatusTypeDef CLK_SetProfile(CLK_ProfileTypeDef Profile)
+{
+	RCC_OscInitTypeDef Osc = {0};
+	RCC_ClkInitTypeDef Clk = {0};
+	uint32_t Latency = FLASH_LATENCY_1;
+
+	if (Profile >= CLK_PROFILE_COUNT) return HAL_ERROR;
+
+	// Every switch passes through the nominal configuration, which is valid at any scale,
+	// so PLL1 can be stopped and the regulator moved while nothing depends on them
+	CLK_NominalBuses(&Clk);
+	if (HAL_RCC_ClockConfig(&Clk, FLASH_LATENCY_1) != HAL_OK) return HAL_ERROR;
+	Osc.OscillatorType = RCC_OSCILLATORTYPE_NONE;
+	Osc.PLL.PLLState = RCC_PLL_OFF;
+	if (HAL_RCC_OscConfig(&Osc) != HAL_OK) return HAL_ERROR;
+
+	__HAL_PWR_VOLTAGESCALING_CONFIG((Profile == CLK_PROFILE_PERFORMANCE) ? PWR_REGULATOR_VOLTAGE_SCALE1
+	                                                                     : PWR_REGULATOR_VOLTAGE_SCALE3);
+	while(!__HAL_PWR_GET_FLAG(PWR_FLAG_VOSRDY)) {}
+
+	switch (Profile)
+	{
+	case CLK_PROFILE_PERFORMANCE:
+		// HSI / 4 = 16 MHz reference, VCO 800 MHz, PLL1P 400 MHz
+		Osc.PLL.PLLState = RCC_PLL_ON;
+		Osc.PLL.PLLSource = RCC_PLLSOURCE_HSI;
+		Osc.PLL.PLLM = 4;
+		Osc.PLL.PLLN = 50;
+		Osc.PLL.PLLP = 2;
+		Osc.PLL.PLLQ = 4;
+		Osc.PLL.PLLR = 2;
+		Osc.PLL.PLLRGE = RCC_PLL1VCIRANGE_3;
+		Osc.PLL.PLLVCOSEL = RCC_PLL1VCOWIDE;
+		Osc.PLL.PLLFRACN = 0;
+		if (HAL_RCC_OscConfig(&Osc) != HAL_OK) return HAL_ERROR;
+		Clk.SYSCLKSource = RCC_SYSCLKSOURCE_PLLCLK;
+		Clk.AHBCLKDivider = RCC_HCLK_DIV2;   // 200 MHz, the AXI and CM4 limit is 240 MHz
+		Clk.APB3CLKDivider = RCC_APB3_DIV2;  // 100 MHz, the APB limit is 120 MHz
+		Clk.APB1CLKDivider = RCC_APB1_DIV2;
+		Clk.APB2CLKDivider = RCC_APB2_DIV2;
+		Clk.APB4CLKDivider = RCC_APB4_DIV2;
+		Latency = FLASH_LATENCY_2;
+		break;
+	case CLK_PROFILE_LOW_POWER:
+		// D1CPRE rather than HSIDIV: HSI keeps feeding PLL2 and the ADC at the same rate
+		Clk.SYSCLKDivider = RCC_SYSCLK_DIV4;
+		Clk.APB1CLKDivider = RCC_APB1_DIV1;
+		Latency = FLASH_LATENCY_0;
+		break;
+	default:
+		return HAL_OK;
+	}
+	// Updates SystemCoreClock and the SysTick reload of this core
+	return HAL_RCC_ClockConfig(&Clk, Latency);
+}
+
+/**
+ * @brief Returns the profile the system clock runs in.
+ * @return One of CLK_ProfileTypeDef, CLK_PROFILE_COUNT if the configuration matches none.
+ */
+CLK_ProfileTypeDef CLK_GetProfile(void)
+{
+	uint32_t Source = __HAL_RCC_GET_SYSCLK_SOURCE();
+
+	if (Source == RCC_SYSCLKSOURCE_STATUS_PLLCLK) return CLK_PROFILE_PERFORMANCE;
+	if (Source != RCC_SYSCLKSOURCE_STATUS_HSI) return CLK_PROFILE_COUNT;
+	switch (RCC->D1CFGR & RCC_D1CFGR_D1CPRE)
+	{
+	case RCC_SYSCLK_DIV1: return CLK_PROFILE_NOMINAL;
+	case RCC_SYSCLK_DIV4: return CLK_PROFILE_LOW_POWER;
+	default:              return CLK_PROFILE_COUNT;
+	}
+}
+
+/**
+ * @brief Returns the counter clock of a timer before its prescaler.
+ * @param htim Pointer to the TIM_HandleTypeDef structure.
+ * @return Timer kernel clock [Hz].
+ */
+uint32_t CLK_GetTimerFreq(const TIM_HandleTypeDef* htim)
+{
+	uint32_t Pclk, Ppre;
+
+	if (CLK_IS_APB2_TIMER(htim->Instance))
+	{
+		Pclk = HAL_RCC_GetPCLK2Freq();
+		Ppre = (RCC->D2CFGR & RCC_D2CFGR_D2PPRE2) >> RCC_D2CFGR_D2PPRE2_Pos;
+	}
+	else
+	{
+		Pclk = HAL_RCC_GetPCLK1Freq();
+		Ppre = (RCC->D2CFGR & RCC_D2CFGR_D2PPRE1) >> RCC_D2CFGR_D2PPRE1_Pos;
+	}
+	// Ppre 0..3 is not divided, 4..7 divides by 2..16
+	uint32_t Divider = (Ppre < 4U) ? 1U : (1UL << (Ppre - 3U));
+
+	if (RCC->CFGR & RCC_CFGR_TIMPRE)
+	{
+		return (Divider <= 4U) ? HAL_RCC_GetHCLKFreq() : 4U * Pclk;
+	}
+	return (Divider == 1U) ? Pclk : 2U * Pclk;
+}
+
+/**
+ * @brief Sets the prescaler so that the timer counts at TickHz.
+ * @param htim Pointer to the TIM_HandleTypeDef structure.
+ * @param TickHz Counter clock [Hz], a divisor of the timer kernel clock.
+ * @return HAL_OK, or HAL_ERROR if the ratio does not fit the 16-bit prescaler.
+ */
+HAL_StatusTypeDef CLK_SetTimerTick(TIM_HandleTypeDef* htim, uint32_t TickHz)
+{
+	if (TickHz == 0U) return HAL_ERROR;
+
+	uint32_t Ratio = CLK_GetTimerFreq(htim) / TickHz;
+	if (Ratio == 0U || Ratio > 0x10000U) return HAL_ERROR;
+
+	htim->Init.Prescaler = Ratio - 1U;
+	__HAL_TIM_SET_PRESCALER(htim, Ratio - 1U);
+	return HAL_OK;
+}
+
+/**
+ * @brief Computes the I2C TIMINGR value for a standard-mode bus.
+ * @param KernelHz I2C kernel clock [Hz].
+ * @return Value for hi2c->Init.Timing (CLK_I2C_STANDARD_HZ at most, analog filter on).
+ */
+uint32_t CLK_GetI2CTiming(uint32_t KernelHz)
+{
+	if (KernelHz == 0U) return 0U;
+
+	uint32_t Presc = CLK_MIN(CLK_CEIL_DIV(KernelHz, CLK_I2C_TICK_MAX_HZ), 16U);
+
+	// Rounded down, so every interval below comes out at least as long as asked
+	uint32_t TickNs = (uint32_t)((uint64_t)Presc * 1000000000ULL / KernelHz);
+	uint32_t Scll = CLK_MIN(CLK_CEIL_DIV(CLK_I2C_LOW_NS, TickNs) - 1U, 255U);
+	uint32_t Sclh = CLK_MIN(CLK_CEIL_DIV(CLK_I2C_HIGH_NS, TickNs) - 1U, 255U);
+	uint32_t Sdadel = CLK_MIN(CLK_CEIL_DIV(CLK_I2C_HOLD_NS, TickNs), 15U);
+	uint32_t Scldel = CLK_MIN(CLK_CEIL_DIV(CLK_I2C_SETUP_NS, TickNs) - 1U, 15U);
+
+	return ((Presc - 1U) << I2C_TIMINGR_PRESC_Pos) | (Scldel << I2C_TIMINGR_SCLDEL_Pos)
+	     | (Sdadel << I2C_TIMINGR_SDADEL_Pos) | (Sclh << I2C_TIMINGR_SCLH_Pos) | (Scll << I2C_TIMINGR_SCLL_Pos);
+}
@@ -0,0 +1,180 @@
+/**
+  ******************************************************************************
+  * @file     : cmd.c
+  * @author   : MS    Mateusz.Stasiak@student.put.poznan.pl
+  * @version  : 1.0.0
+  * @date     : Oct 17, 2026
+  * @brief    : Line assembler and bounded-time tokenizer for text commands.
+  *
+  ******************************************************************************
+  */
+
+/* Private includes ----------------------------------------------------------*/
+#include "cmd.h"
+
+/* Private typedef -----------------------------------------------------------*/
+
+/* Private define ------------------------------------------------------------*/
+#define CMD_MANTISSA_LIMIT  100000000000000000ULL // 18 significant digits, exact in 64 bits
+
+/* Private macro -------------------------------------------------------------*/
+#define CMD_IS_DIGIT(c)      ((c) >= '0' && (c) <= '9')
+#define CMD_IS_LETTER(c)     (((c) >= 'a' && (c) <= 'z') || ((c) >= 'A' && (c) <= 'Z'))
+#define CMD_IS_SEPARATOR(c)  ((c) == ' ' || (c) == '\t' || (c) == ',' || (c) == ';')
+#define CMD_IS_NUMBER_START(s) (CMD_IS_DIGIT((s)[0]) || (((s)[0] == '-' || (s)[0] == '+' || (s)[0] == '.') && \
+                               (CMD_IS_DIGIT((s)[1]) || ((s)[1] == '.' && CMD_IS_DIGIT((s)[2])))))
+
+/* Private variables ---------------------------------------------------------*/
+
+/* Public variables ----------------------------------------------------------*/
+
+/* Private function prototypes -----------------------------------------------*/
+
+/* Public function prototypes ------------------------------------------------*/
+
+/* Private functions ---------------------------------------------------------*/
+
+/* Public functions ----------------------------------------------------------*/
+
+/**
+ * @brief Adds one received character to the line being assembled.
+ * @param hcmd Pointer to the CMD_HandleTypeDef structure.
+ * @param Ch Received character.
+ * @return 1 when a non-empty line is complete in hcmd->Line, 0 otherwise.
+ */
+uint8_t CMD_Feed(CMD_HandleTypeDef* hcmd, char Ch)
+{
+	if (hcmd->Ready)
+	{
+		hcmd->Ready = 0;
+		hcmd->Length = 0;
+	}
+
+	if (Ch == '\n' || Ch == '\r')
+	{
+		uint8_t Complete = (!hcmd->Discard && hcmd->Length > 0);
+		hcmd->Discard = 0;
+		if (!Complete)
+		{
+			hcmd->Length = 0;
+			return 0;
+		}
+		hcmd->Line[hcmd->Length] = '\0';
+		hcmd->Ready = 1;
+		hcmd->Lines++;
+		return 1;
+	}
+
+	if (hcmd->Discard) return 0;
+
+	// Control characters mean line noise, the line cannot be trusted any more
+	if ((Ch != '\t' && (uint8_t)Ch < 0x20U) || (uint8_t)Ch > 0x7EU || hcmd->Length >= CMD_LINE_MAX - 1)
+	{
+		hcmd->Discard = 1;
+		hcmd->Length = 0;
+		hcmd->Rejected++;
+		return 0;
+	}
+	hcmd->Line[hcmd->Length++] = Ch;
+	return 0;
+}
+
+/**
+ * @brief Splits the complete line into arguments, in place.
+ * @param hcmd Pointer to the CMD_HandleTypeDef structure.
+ * @param Args Output array.
+ * @param MaxArgs Capacity of Args.
+ * @return Number of arguments; arguments beyond MaxArgs are ignored.
+ */
+uint8_t CMD_Tokenize(CMD_HandleTypeDef* hcmd, CMD_ArgTypeDef* Args, uint8_t MaxArgs)
+{
+	char *p = hcmd->Line;
+	uint8_t Count = 0;
+
+	if (!hcmd->Ready) return 0;
+
+	while (*p != '\0' && Count < MaxArgs)
+	{
+		while (CMD_IS_SEPARATOR(*p)) p++;
+		if (*p == '\0') break;
+
+		CMD_ArgTypeDef *Arg = &Args[Count++];
+		Arg->Name = p;
+		while (*p != '\0' && *p != '=' && !CMD_IS_SEPARATOR(*p)) p++;
+		Arg->NameLength = (uint8_t)(p - Arg->Name);
+
+		if (*p == '=')
+		{
+			Arg->Value = ++p;
+			while (*p != '\0' && !CMD_IS_SEPARATOR(*p)) p++;
+		}
+		else if (Arg->NameLength > 1 && CMD_IS_LETTER(Arg->Name[0]) && CMD_IS_NUMBER_START(&Arg->Name[1]))
+		{
+			// Short form: one letter directly followed by the value
+			Arg->Value = Arg->Name + 1;
+			Arg->NameLength = 1;
+		}
+		else
+		{
+			Arg->Value = p; // the terminator, or a separator cleared below
+		}
+
+		if (*p != '\0') *p++ = '\0';
+	}
+	return Count;
+}
+
+/**
+ * @brief Checks the name of an argument.
+ * @param Arg Pointer to the argument.
+ * @param Name Null-terminated name to compare with.
+ * @return 1 if the names are equal, 0 otherwise.
+ */
+uint8_t CMD_IsName(const CMD_ArgTypeDef* Arg, const char* Name)
+{
+	for (uint8_t i = 0; i < Arg->NameLength; i++)
+	{
+		if (Name[i] != Arg->Name[i]) return 0; // also stops at the end of Name
+	}
+	return Name[Arg->NameLength] == '\0';
+}
+
+/**
+ * @brief Parses a decimal number such as "-12", "35.5" or ".25".
+ * @param Str Null-terminated string, the whole string must be the number.
+ * @param Value Output, written only on success.
+ * @return 1 on success, 0 if the string is not a number.
+ */
+uint8_t CMD_ParseFloat(const char* Str, float* Value)
+{
+	const char *p = Str;
+	uint8_t Negative = 0, Point = 0, Digits = 0;
+	uint64_t Mantissa = 0;
+	int16_t Scale = 0;
+
+	if (*p == '+' || *p == '-') Negative = (*p++ == '-');
+	for (; *p != '\0'; p++)
+	{
+		if (*p == '.' && !Point)
+		{
+			Point = 1;
+			continue;
+		}
+		if (!CMD_IS_DIGIT(*p)) return 0;
+		Digits = 1;
+		if (Mantissa < CMD_MANTISSA_LIMIT)
+		{
+			Mantissa = Mantissa * 10U + (uint64_t)(*p - '0');
+			if (Point) Scale--;
+		}
+		else if (!Point) Scale++;
+	}
+	if (!Digits) return 0;
+
+	// One rounding for the power of ten and one for the division or product
+	double Power = 1.0;
+	for (int16_t i = (Scale < 0) ? -Scale : Scale; i > 0; i--) Power *= 10.0;
+	double Result = (Scale < 0) ? (double)Mantissa / Power : (double)Mantissa * Power;
+	*Value = (float)(Negative ? -Result : Result);
+	return 1;
+}
@@ -0,0 +1,64 @@
+/**
+  ******************************************************************************
+  * @file     : control.c
+  * @author   : MS    Mateusz.Stasiak@student.put.poznan.pl
+  * @version  : 1.0.0
+  * @date     : Oct 17, 2026
+  * @brief    : One control period: LM35 reading, PID and PWM with saturation feedback.
+  *
+  ******************************************************************************
+  */
+
+/* Private includes ----------------------------------------------------------*/
+#include "control.h"
+
+/* Private typedef -----------------------------------------------------------*/
+
+/* Private define ------------------------------------------------------------*/
+
+/* Private macro -------------------------------------------------------------*/
+#define CONTROL_PROBE_START(hprobe) do { if ((hprobe) != NULL) PROBE_START(hprobe); } while (0)
+#define CONTROL_PROBE_STOP(hprobe)  do { if ((hprobe) != NULL) PROBE_STOP(hprobe); } while (0)
+
+/* Private variables ---------------------------------------------------------*/
+
+/* Public variables ----------------------------------------------------------*/
+
+/* Private function prototypes -----------------------------------------------*/
+
+/* Public function prototypes ------------------------------------------------*/
+
+/* Private functions ---------------------------------------------------------*/
+
+/* Public functions ----------------------------------------------------------*/
+
+/**
+ * @brief Runs one control period from the latest LM35 reading to the PWM compare value.
+ * @param hcontrol Pointer to the CONTROL_HandleTypeDef structure.
+ * @param Timestamp PID_TIMESTAMP() value of the DMA event that completed the samples.
+ * @param AdcRaw Output, the raw LM35 code the temperature was converted from.
+ * @param Temperature Output, filtered temperature the controller used [degC].
+ * @return Applied PWM duty [%], after saturation to the PWM limits.
+ */
+int CONTROL_Step(CONTROL_HandleTypeDef* hcontrol, uint32_t Timestamp, uint16_t* AdcRaw, float* Temperature)
+{
+	CONTROL_PROBE_START(hcontrol->ProbeLm35);
+	// One reading per period, so the published code and temperature are the same sample
+	*AdcRaw = LM35_GetReg(hcontrol->Adc);
+	*Temperature = LM35_ConvertTemp(*AdcRaw, hcontrol->Filter);
+	CONTROL_PROBE_STOP(hcontrol->ProbeLm35);
+
+	CONTROL_PROBE_START(hcontrol->ProbePid);
+	// The time step between the hardware-paced DMA events, free of the task start delay
+	float u = PID_CalculateAt(hcontrol->Pid, *Temperature, Timestamp);
+	CONTROL_PROBE_STOP(hcontrol->ProbePid);
+
+	CONTROL_PROBE_START(hcontrol->ProbePwm);
+	PWM_WriteDuty(hcontrol->Pwm, (int)u);
+	int duty = PWM_ReadDuty(hcontrol->Pwm);
+	CONTROL_PROBE_STOP(hcontrol->ProbePwm);
+
+	// Feed saturation back to the controller, truncation to whole percent is not saturation
+	PID_TrackOutput(hcontrol->Pid, (duty == (int)u) ? u : (float)duty);
+	return duty;
+}
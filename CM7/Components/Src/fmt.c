@@ -0,0 +1,249 @@
+/**
+  ******************************************************************************
+  * @file     : fmt.c
+  * @author   : MS    Mateusz.Stasiak@student.put.poznan.pl
+  * @version  : 1.0.0
+  * @date     : Oct 17, 2026
+  * @brief    : Allocation-free text formatting of integers and fixed-point floats.
+  *
+  *             Floats are split into a 32-bit integer part and a scaled fraction
+  *             straight from their bits. A float has a 24-bit mantissa and
+  *             10^6 < 2^20, so the fraction times 10^Decimals is exact in 64-bit
+  *             integers and the result is rounded like printf. No floating-point
+  *             arithmetic at all, so the CM4 (single-precision FPU) needs no soft
+  *             double calls. The cost is bounded by the digit count: no loops over
+  *             the exponent, no heap, no locale.
+  *
+  ******************************************************************************
+  */
+
+/* Private includes ----------------------------------------------------------*/
+#include <string.h>
+#include "fmt.h"
+
+/* Private typedef -----------------------------------------------------------*/
+
+/* Private define ------------------------------------------------------------*/
+#define FMT_DIGITS_MAX  (10 + 1 + FMT_MAX_DECIMALS) // 32-bit integer part, point and decimals
+#define FMT_EXP_SPECIAL 0xFFU                       // biased exponent of inf and nan
+#define FMT_EXP_LIMIT   (127U + 32U)                // biased exponent of FMT_FLOAT_LIMIT, 2^32
+#define FMT_SHIFT_MAX   64U                         // fractions shifted further are below half of any last digit
+
+/* Private macro -------------------------------------------------------------*/
+
+/* Private variables ---------------------------------------------------------*/
+static const uint32_t FMT_Pow10[FMT_MAX_DECIMALS + 1] = {
+	1U, 10U, 100U, 1000U, 10000U, 100000U, 1000000U
+};
+
+/* Public variables ----------------------------------------------------------*/
+
+/* Private function prototypes -----------------------------------------------*/
+
+/* Public function prototypes ------------------------------------------------*/
+
+/* Private functions ---------------------------------------------------------*/
+
+/**
+ * @brief Writes the decimal digits of Value backwards, ending just before End.
+ * @return Pointer to the first digit.
+ */
+static char* FMT_Digits(char* End, uint32_t Value, uint8_t MinDigits)
+{
+	char *p = End;
+	do
+	{
+		*--p = (char)('0' + Value % 10U);
+		Value /= 10U;
+		if (MinDigits > 0) MinDigits--;
+	} while (Value != 0U || MinDigits > 0);
+	return p;
+}
+
+/**
+ * @brief Appends a sign and a digit string padded to Width.
+ */
+static size_t FMT_Field(FMT_HandleTypeDef* hfmt, uint8_t Negative, const char* Digits, size_t Count, uint8_t Width, char Pad)
+{
+	size_t Total = Count + (Negative ? 1U : 0U);
+	size_t Fill = (Width > Total) ? Width - Total : 0U;
+
+	if (Pad != '0')
+	{
+		while (Fill-- > 0U) FMT_Char(hfmt, ' ');
+		Fill = 0;
+	}
+	if (Negative) FMT_Char(hfmt, '-');
+	while (Fill-- > 0U) FMT_Char(hfmt, '0');
+	while (Count-- > 0U) FMT_Char(hfmt, *Digits++);
+	return hfmt->Length;
+}
+
+/**
+ * @brief Fills the field with '#' when the value does not fit the format.
+ */
+static size_t FMT_Overflow(FMT_HandleTypeDef* hfmt, uint8_t Width)
+{
+	do
+	{
+		FMT_Char(hfmt, '#');
+	} while (Width-- > 1U);
+	return hfmt->Length;
+}
+
+/* Public functions ----------------------------------------------------------*/
+
+/**
+ * @brief Starts a new text in the buffer.
+ * @param hfmt Pointer to the FMT_HandleTypeDef structure.
+ * @param Buffer Destination buffer.
+ * @param Size Size of the destination buffer in bytes, at least 1.
+ */
+void FMT_Init(FMT_HandleTypeDef* hfmt, char* Buffer, size_t Size)
+{
+	hfmt->Buffer = Buffer;
+	hfmt->Size = Size;
+	hfmt->Length = 0;
+	if (Size > 0U) Buffer[0] = '\0';
+}
+
+/**
+ * @brief Appends a null-terminated string.
+ * @param hfmt Pointer to the FMT_HandleTypeDef structure.
+ * @param Str String to append.
+ * @return Length of the text after appending.
+ */
+size_t FMT_String(FMT_HandleTypeDef* hfmt, const char* Str)
+{
+	while (*Str) FMT_Char(hfmt, *Str++);
+	return hfmt->Length;
+}
+
+/**
+ * @brief Appends a single character, dropped when the buffer is full.
+ * @param hfmt Pointer to the FMT_HandleTypeDef structure.
+ * @param Ch Character to append.
+ * @return Length of the text after appending.
+ */
+size_t FMT_Char(FMT_HandleTypeDef* hfmt, char Ch)
+{
+	if (hfmt->Length + 1U < hfmt->Size)
+	{
+		hfmt->Buffer[hfmt->Length++] = Ch;
+		hfmt->Buffer[hfmt->Length] = '\0';
+	}
+	return hfmt->Length;
+}
+
+/**
+ * @brief Appends an unsigned integer.
+ * @param hfmt Pointer to the FMT_HandleTypeDef structure.
+ * @param Value Value to append.
+ * @param Width Minimum field width, right-aligned; 0 for none.
+ * @param Pad Fill character, ' ' or '0'.
+ * @return Length of the text after appending.
+ */
+size_t FMT_UInt(FMT_HandleTypeDef* hfmt, uint32_t Value, uint8_t Width, char Pad)
+{
+	char Tmp[FMT_DIGITS_MAX];
+	char *End = Tmp + sizeof(Tmp);
+	char *p = FMT_Digits(End, Value, 1);
+
+	return FMT_Field(hfmt, 0, p, (size_t)(End - p), Width, Pad);
+}
+
+/**
+ * @brief Appends a signed integer.
+ * @param hfmt Pointer to the FMT_HandleTypeDef structure.
+ * @param Value Value to append.
+ * @param Width Minimum field width, right-aligned; 0 for none.
+ * @param Pad Fill character, ' ' or '0' (zeros go after the sign).
+ * @return Length of the text after appending.
+ */
+size_t FMT_Int(FMT_HandleTypeDef* hfmt, int32_t Value, uint8_t Width, char Pad)
+{
+	char Tmp[FMT_DIGITS_MAX];
+	char *End = Tmp + sizeof(Tmp);
+	uint32_t Magnitude = (Value < 0) ? 0U - (uint32_t)Value : (uint32_t)Value;
+	char *p = FMT_Digits(End, Magnitude, 1);
+
+	return FMT_Field(hfmt, Value < 0, p, (size_t)(End - p), Width, Pad);
+}
+
+/**
+ * @brief Appends a float with a fixed number of decimals.
+ * @param hfmt Pointer to the FMT_HandleTypeDef structure.
+ * @param Value Value to append.
+ * @param Decimals Digits after the decimal point, limited to FMT_MAX_DECIMALS.
+ * @param Width Minimum field width, right-aligned; 0 for none.
+ * @param Pad Fill character, ' ' or '0' (zeros go after the sign).
+ * @return Length of the text after appending.
+ * @note Values with |Value| >= FMT_FLOAT_LIMIT fill the field with '#'.
+ */
+size_t FMT_Float(FMT_HandleTypeDef* hfmt, float Value, uint8_t Decimals, uint8_t Width, char Pad)
+{
+	char Tmp[FMT_DIGITS_MAX];
+	char *End = Tmp + sizeof(Tmp);
+	char *p;
+	uint32_t Bits;
+
+	memcpy(&Bits, &Value, sizeof(Bits));
+	uint8_t Negative = (uint8_t)(Bits >> 31);
+	uint32_t Exponent = (Bits >> 23) & 0xFFU;
+	uint32_t Mantissa = Bits & 0x7FFFFFU;
+
+	if (Decimals > FMT_MAX_DECIMALS) Decimals = FMT_MAX_DECIMALS;
+
+	if (Exponent == FMT_EXP_SPECIAL)
+	{
+		if (Mantissa != 0U) return FMT_Field(hfmt, 0, "nan", 3, Width, ' ');
+		return FMT_Field(hfmt, Negative, "inf", 3, Width, ' ');
+	}
+	if (Exponent >= FMT_EXP_LIMIT)
+	{
+		return FMT_Overflow(hfmt, Width);
+	}
+
+	// |Value| = Mantissa * 2^(Exponent - 150); subnormals have no implicit bit and the exponent of 1
+	if (Exponent != 0U) Mantissa |= 1U << 23;
+	else Exponent = 1U;
+
+	// Integer part, and the fraction bits below it scaled by 10^Decimals, both exact
+	uint32_t Integer = 0, Fraction = 0;
+	uint64_t Rest = 0, Half = 1;
+	if (Exponent >= 150U)
+	{
+		Integer = Mantissa << (Exponent - 150U); // below 2^32, checked above
+	}
+	else if (150U - Exponent < FMT_SHIFT_MAX)
+	{
+		uint32_t Shift = 150U - Exponent;
+		uint32_t Low = (Shift < 32U) ? Mantissa & ((1U << Shift) - 1U) : Mantissa;
+		uint64_t Scaled = (uint64_t)Low * FMT_Pow10[Decimals]; // below 2^44
+		Integer = (Shift < 32U) ? Mantissa >> Shift : 0U;
+		Fraction = (uint32_t)(Scaled >> Shift);
+		Rest = Scaled & ((1ULL << Shift) - 1U);
+		Half = 1ULL << (Shift - 1U);
+	}
+
+	// Round half to even; the largest float below the limit is an integer, so Integer cannot overflow
+	uint32_t LastDigit = (Decimals > 0) ? Fraction : Integer;
+	if (Rest > Half || (Rest == Half && (LastDigit & 1U)))
+	{
+		if (Decimals == 0) Integer++;
+		else if (++Fraction == FMT_Pow10[Decimals])
+		{
+			Fraction = 0;
+			Integer++;
+		}
+	}
+
+	p = End;
+	if (Decimals > 0)
+	{
+		p = FMT_Digits(p, Fraction, Decimals);
+		*--p = '.';
+	}
+	p = FMT_Digits(p, Integer, 1);
+	return FMT_Field(hfmt, Negative, p, (size_t)(End - p), Width, Pad);
+}
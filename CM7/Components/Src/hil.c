@@ -0,0 +1,122 @@
+/**
+  ******************************************************************************
+  * @file     : hil.c
+  * @author   : MS    Mateusz.Stasiak@student.put.poznan.pl
+  * @version  : 1.0.0
+  * @date     : Oct 17, 2026
+  * @brief    : Hardware-in-the-loop glue: thermal plant model driving emulated LM35 readings.
+  *
+  ******************************************************************************
+  */
+
+/* Private includes ----------------------------------------------------------*/
+#include "hil.h"
+#include "lm35.h"
+
+/* Private typedef -----------------------------------------------------------*/
+
+/* Private define ------------------------------------------------------------*/
+
+/* Private macro -------------------------------------------------------------*/
+
+/* Private variables ---------------------------------------------------------*/
+
+/* Public variables ----------------------------------------------------------*/
+
+/* Private function prototypes -----------------------------------------------*/
+
+/* Public function prototypes ------------------------------------------------*/
+
+/* Private functions ---------------------------------------------------------*/
+
+/**
+ * @brief Approximately normal random number (sum of four uniforms), unit variance.
+ * @note One xorshift64 step supplies all four 16-bit uniforms, summed as integers.
+ */
+static float HIL_Noise(HIL_HandleTypeDef* hhil)
+{
+	uint64_t x = hhil->Seed;
+	x ^= x << 13;
+	x ^= x >> 7;
+	x ^= x << 17;
+	hhil->Seed = x;
+
+	int32_t sum = (int32_t)((x & 0xFFFFU) + ((x >> 16) & 0xFFFFU) + ((x >> 32) & 0xFFFFU) + (x >> 48)) - 2 * 65535;
+	return (float)sum * (1.7320508f / 65536.0f); // 4 uniforms on [-0.5, 0.5) have variance 1/3
+}
+
+static void HIL_Publish(HIL_HandleTypeDef* hhil)
+{
+	float noise = (hhil->NoiseMv > 0.0f) ? hhil->NoiseMv * HIL_Noise(hhil) : 0.0f;
+
+	hhil->Shared->AdcRaw = HIL_TempToReg(hhil->Plant->Temperature, noise);
+	hhil->Shared->Temperature = hhil->Plant->Temperature;
+}
+
+/* Public functions ----------------------------------------------------------*/
+
+/**
+ * @brief Starts the plant at the ambient temperature and marks the emulator active.
+ * @param hhil Pointer to the HIL_HandleTypeDef structure, the plant parameters set.
+ */
+void HIL_Init(HIL_HandleTypeDef* hhil)
+{
+	PLANT_Init(hhil->Plant);
+	hhil->Elapsed = 0.0f;
+	hhil->Shared->Steps = 0;
+	HIL_Publish(hhil);
+	hhil->Shared->Magic = HIL_MAGIC; // the reading is valid before the controller switches to it
+}
+
+/**
+ * @brief Advances the plant and publishes the new reading.
+ * @param hhil Pointer to the HIL_HandleTypeDef structure.
+ * @param Duty Heater duty applied during the elapsed time [%].
+ * @param Elapsed Time since the previous call [s].
+ */
+void HIL_Update(HIL_HandleTypeDef* hhil, float Duty, float Elapsed)
+{
+	hhil->Elapsed += Elapsed;
+	while (hhil->Elapsed >= hhil->Plant->Ts)
+	{
+		hhil->Elapsed -= hhil->Plant->Ts;
+		PLANT_Step(hhil->Plant, Duty);
+		hhil->Shared->Steps++;
+	}
+	HIL_Publish(hhil);
+}
+
+/**
+ * @brief Marks the emulator inactive, the controller falls back to the real ADC.
+ * @param hhil Pointer to the HIL_HandleTypeDef structure.
+ */
+void HIL_Stop(HIL_HandleTypeDef* hhil)
+{
+	hhil->Shared->Magic = 0;
+}
+
+/**
+ * @brief Checks whether an emulator feeds the readings.
+ * @param Shared Pointer to the shared HIL_SharedTypeDef structure.
+ * @return 1 if active, 0 otherwise.
+ */
+uint8_t HIL_IsActive(const HIL_SharedTypeDef* Shared)
+{
+	return Shared->Magic == HIL_MAGIC;
+}
+
+/**
+ * @brief Converts a temperature to the ADC1 code LM35_GetTemp turns back into it.
+ * @param Temperature Sensor temperature [degC].
+ * @param NoiseMv Noise added to the sensor voltage [mV].
+ * @return ADC1 code, saturated to the converter range.
+ */
+uint16_t HIL_TempToReg(float Temperature, float NoiseMv)
+{
+	float mv = 10.0f * (Temperature + LM35_OFFSET) + NoiseMv;
+	float reg = mv * (ADC_REG_MAX / (1000.0f * ADC_VOLTAGE_MAX)) + 0.5f;
+
+	if (reg < 0.0f) reg = 0.0f;
+	else if (reg > ADC_REG_MAX) reg = ADC_REG_MAX;
+	return (uint16_t)reg;
+}
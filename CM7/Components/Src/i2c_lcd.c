@@ -11,7 +11,7 @@
 
 /*-------------------------[Private includes]-------------------------*/
 
-#include <utils.h>
+#include <string.h>
 #include "i2c_lcd.h"
 
 /*-----------------------[INTERNAL DEFINITIONS]-----------------------*/
@@ -54,98 +54,331 @@
 #define EN                      0b00000100  // Enable bit
 #define RW                      0b00000010  // Read/Write bit
 #define RS                      0b00000001  // Register select bit
+// FRAMEBUFFER
+#define I2C_LCD_MERGE_GAP       1           // rewriting one unchanged cell costs the same as a cursor move
+// TRANSFER QUEUE
+#define I2C_LCD_RAW             0x80        // entry is a single expander byte, not a HD44780 byte
+#define I2C_LCD_TIMED           0x40        // wait must be timed, the busy flag is not valid yet
+// BUSY FLAG POLLING
+#define I2C_LCD_BF              0x80        // D7 of the high nibble read back through P7
+#define I2C_LCD_POLL_MAX        8           // busy reads before the module is assumed not to support reads
+#define I2C_LCD_POLL_IDLE       0
+#define I2C_LCD_POLL_STROBE     1           // RW and EN are being raised
+#define I2C_LCD_POLL_READ       2           // high nibble is being read
+#define I2C_LCD_POLL_FINISH     3           // EN is being lowered and the low nibble strobed
+#define I2C_LCD_POLL_ABORT      4           // as FINISH, after a failed read
+#define I2C_LCD_POWERUP_US      50000       // > 40ms after power up
+#define I2C_LCD_RESET_US        5000        // > 4.1ms after the first function set
+#define I2C_LCD_RESET2_US       150         // > 100us after the second function set
+#define I2C_LCD_CLEAR_US        2000        // clear display and return home take 1.52ms
 
 /*-----------------------[INTERNAL VARIABLES]-----------------------*/
 
+static const uint8_t Row_Offsets[I2C_LCD_MAX_ROWS] = {0x00, 0x40, 0x14, 0x54};
+
 
 /*---------------------[STATIC INTERNAL FUNCTIONS]-----------------------*/
 
 /**
- * @brief Writes data to the I2C LCD expander.
+ * @brief Builds the expander bytes of one queue entry.
+ *
+ * A HD44780 byte is sent as two nibbles, each as data, data|EN, data. The PCF8574
+ * latches every byte of a transfer, so the EN pulse lasts one I2C byte time (90us
+ * at 100 kHz), well above the required 450ns.
+ *
+ * @param Entry Queue entry to send.
+ * @param Buf Destination, at least I2C_LCD_FRAME_SIZE bytes.
+ * @return Number of bytes in the frame.
+ */
+static uint16_t I2C_LCD_BuildFrame(const I2C_LCD_QueueEntryTypeDef* Entry, uint8_t* Buf)
+{
+	uint8_t Ctrl = Entry->Ctrl & (RS | LCD_BACKLIGHT);
+
+	if (Entry->Ctrl & I2C_LCD_RAW)
+	{
+		Buf[0] = Entry->Val | Ctrl;
+		return 1;
+	}
+	uint8_t HighNib = (Entry->Val & 0xF0) | Ctrl;
+	uint8_t LowNib = ((Entry->Val << 4) & 0xF0) | Ctrl;
+	Buf[0] = HighNib; Buf[1] = HighNib | EN; Buf[2] = HighNib;
+	Buf[3] = LowNib;  Buf[4] = LowNib | EN;  Buf[5] = LowNib;
+	return I2C_LCD_FRAME_SIZE;
+}
+
+/**
+ * @brief Starts the transfer of the entries at the queue tail, or goes idle when the queue is empty.
  *
- * This function sends data to the I2C LCD expander with the appropriate backlight value.
+ * Consecutive entries are packed into one transfer of up to I2C_LCD_BURST_MAX entries,
+ * so a whole string costs one START/address/STOP. A burst ends after the first entry
+ * that needs a wait. Between the EN strobes of two packed bytes there are two I2C byte
+ * times, more than the 37us execution time up to 400 kHz.
+ *
+ * Called with Busy set, either from the interrupt handlers or from I2C_LCD_Kick with
+ * interrupts disabled. Entries whose transfer cannot be started are skipped.
  *
  * @param hi2c_lcd Pointer to the I2C_LCD_HandleTypeDef structure that contains the I2C configuration.
- * @param DATA Data byte to send.
  */
-static void I2C_LCD_ExpanderWrite(I2C_LCD_HandleTypeDef* hi2c_lcd, uint8_t DATA)
+static void I2C_LCD_StartNext(I2C_LCD_HandleTypeDef* hi2c_lcd)
+{
+	uint16_t Head = hi2c_lcd->QueueHead;
+
+	while (hi2c_lcd->QueueTail != Head)
+	{
+		uint16_t Pending = (uint16_t)(Head - hi2c_lcd->QueueTail);
+		const I2C_LCD_QueueEntryTypeDef* Entry;
+		uint16_t Size = 0;
+		uint8_t Count = 0;
+		do
+		{
+			Entry = &hi2c_lcd->Queue[(hi2c_lcd->QueueTail + Count) & (I2C_LCD_QUEUE_SIZE - 1)];
+			Size += I2C_LCD_BuildFrame(Entry, &hi2c_lcd->TxBuf[Size]);
+			Count++;
+		} while (Count < Pending && Count < I2C_LCD_BURST_MAX && Entry->WaitUs == 0);
+
+		hi2c_lcd->BurstLen = Count;
+		if (HAL_I2C_Master_Transmit_IT(hi2c_lcd->hi2c, (hi2c_lcd->I2C_LCD_Address<<1), hi2c_lcd->TxBuf, Size) == HAL_OK)
+		{
+			return;
+		}
+		hi2c_lcd->Errors++;
+		hi2c_lcd->QueueTail += Count;
+	}
+	hi2c_lcd->Busy = 0;
+	I2C_LCD_IdleCallback(hi2c_lcd);
+}
+
+/**
+ * @brief Starts draining the queue if no transfer is in progress and no batch is being queued.
+ *
+ * @param hi2c_lcd Pointer to the I2C_LCD_HandleTypeDef structure that contains the I2C configuration.
+ */
+static void I2C_LCD_Kick(I2C_LCD_HandleTypeDef* hi2c_lcd)
+{
+	uint32_t Primask = __get_PRIMASK();
+	__disable_irq(); // the interrupt side may be clearing Busy right now
+	if (!hi2c_lcd->Busy && !hi2c_lcd->Hold && hi2c_lcd->QueueTail != hi2c_lcd->QueueHead)
+	{
+		hi2c_lcd->Busy = 1;
+		I2C_LCD_StartNext(hi2c_lcd);
+	}
+	__set_PRIMASK(Primask);
+}
+
+/**
+ * @brief Waits for the execution time of the last sent entry on the wait timer, then resumes the queue.
+ *
+ * @param hi2c_lcd Pointer to the I2C_LCD_HandleTypeDef structure that contains the I2C configuration.
+ * @param WaitUs Time to wait in microseconds, 0 to resume at once.
+ */
+static void I2C_LCD_StartWait(I2C_LCD_HandleTypeDef* hi2c_lcd, uint16_t WaitUs)
+{
+	if (WaitUs > 0 && hi2c_lcd->htim != NULL)
+	{
+		__HAL_TIM_SET_AUTORELOAD(hi2c_lcd->htim, WaitUs);
+		__HAL_TIM_SET_COUNTER(hi2c_lcd->htim, 0);
+		__HAL_TIM_CLEAR_FLAG(hi2c_lcd->htim, TIM_FLAG_UPDATE);
+		if (HAL_TIM_Base_Start_IT(hi2c_lcd->htim) == HAL_OK) return;
+		hi2c_lcd->Errors++;
+	}
+	I2C_LCD_StartNext(hi2c_lcd);
+}
+
+/**
+ * @brief Starts one busy flag read: data lines released as inputs, RW and EN raised.
+ *
+ * The PCF8574 pins are quasi-bidirectional, writing 1 lets the controller drive them.
+ * The high nibble (BF and AC6..4) is read while EN is high.
+ *
+ * @param hi2c_lcd Pointer to the I2C_LCD_HandleTypeDef structure that contains the I2C configuration.
+ */
+static void I2C_LCD_StartPoll(I2C_LCD_HandleTypeDef* hi2c_lcd)
+{
+	uint8_t Read = 0xF0 | RW | hi2c_lcd->BacklightVal;
+
+	hi2c_lcd->TxBuf[0] = Read;
+	hi2c_lcd->TxBuf[1] = Read | EN;
+	hi2c_lcd->PollState = I2C_LCD_POLL_STROBE;
+	if (HAL_I2C_Master_Transmit_IT(hi2c_lcd->hi2c, (hi2c_lcd->I2C_LCD_Address<<1), hi2c_lcd->TxBuf, 2) != HAL_OK)
+	{
+		I2C_LCD_ErrorCallback(hi2c_lcd);
+	}
+}
+
+/**
+ * @brief Lowers EN after the high nibble read and strobes the low nibble.
+ *
+ * The low nibble must be clocked as well to keep the 4-bit interface in step; its
+ * value is not needed.
+ *
+ * @param hi2c_lcd Pointer to the I2C_LCD_HandleTypeDef structure that contains the I2C configuration.
+ * @param State I2C_LCD_POLL_FINISH after a read, I2C_LCD_POLL_ABORT after a failed one.
+ */
+static void I2C_LCD_FinishPoll(I2C_LCD_HandleTypeDef* hi2c_lcd, uint8_t State)
 {
-    uint8_t TxData = (DATA) | hi2c_lcd->BacklightVal;
-    HAL_I2C_Master_Transmit(hi2c_lcd->hi2c, (hi2c_lcd->I2C_LCD_Address<<1), &TxData, sizeof(TxData), 100);
+	uint8_t Read = 0xF0 | RW | hi2c_lcd->BacklightVal;
+
+	hi2c_lcd->TxBuf[0] = Read;
+	hi2c_lcd->TxBuf[1] = Read | EN;
+	hi2c_lcd->TxBuf[2] = Read;
+	hi2c_lcd->PollState = State;
+	if (HAL_I2C_Master_Transmit_IT(hi2c_lcd->hi2c, (hi2c_lcd->I2C_LCD_Address<<1), hi2c_lcd->TxBuf, 3) != HAL_OK)
+	{
+		I2C_LCD_ErrorCallback(hi2c_lcd);
+	}
 }
 
 /**
- * @brief Generates a pulse on the Enable pin of the I2C LCD expander.
+ * @brief Holds back the queued entries so that a whole string or frame leaves in one burst.
  *
- * This function toggles the Enable pin of the LCD to trigger the data transmission.
+ * @param hi2c_lcd Pointer to the I2C_LCD_HandleTypeDef structure that contains the I2C configuration.
+ */
+static void I2C_LCD_Hold(I2C_LCD_HandleTypeDef* hi2c_lcd)
+{
+	hi2c_lcd->Hold = 1;
+}
+
+/**
+ * @brief Releases the entries held back by I2C_LCD_Hold.
  *
  * @param hi2c_lcd Pointer to the I2C_LCD_HandleTypeDef structure that contains the I2C configuration.
- * @param DATA Data byte to send along with the pulse.
  */
-static void I2C_LCD_EnPulse(I2C_LCD_HandleTypeDef* hi2c_lcd, uint8_t DATA)
+static void I2C_LCD_Release(I2C_LCD_HandleTypeDef* hi2c_lcd)
 {
-	I2C_LCD_ExpanderWrite(hi2c_lcd, (DATA | EN)); // En high
-	DELAY_US(2); // enable pulse must be >450ns
+	hi2c_lcd->Hold = 0;
+	I2C_LCD_Kick(hi2c_lcd);
+}
 
-    I2C_LCD_ExpanderWrite(hi2c_lcd, (DATA & ~EN)); // En low
-    DELAY_US(50); // commands need > 37us to settle
+/**
+ * @brief Returns the number of free queue entries.
+ *
+ * @param hi2c_lcd Pointer to the I2C_LCD_HandleTypeDef structure that contains the I2C configuration.
+ */
+static uint16_t I2C_LCD_QueueFree(I2C_LCD_HandleTypeDef* hi2c_lcd)
+{
+	return I2C_LCD_QUEUE_SIZE - (uint16_t)(hi2c_lcd->QueueHead - hi2c_lcd->QueueTail);
 }
 
 /**
- * @brief Writes a 4-bit value to the I2C LCD expander.
+ * @brief Appends one entry to the transfer queue and starts the transfer if the bus is idle.
  *
- * This function sends a 4-bit value to the LCD using the Enable pulse.
+ * A rejected entry leaves the display address counter unknown, so the next
+ * cursor-relative write repositions it first.
  *
  * @param hi2c_lcd Pointer to the I2C_LCD_HandleTypeDef structure that contains the I2C configuration.
- * @param Val 4-bit value to send.
+ * @param Val HD44780 byte, or the expander byte for I2C_LCD_RAW entries.
+ * @param Ctrl RS, I2C_LCD_RAW and I2C_LCD_TIMED flags; the current backlight bit is added here.
+ * @param WaitUs Time the controller needs after this entry, 0 if the I2C gap is enough.
+ * @return HAL_OK when queued, HAL_BUSY when the queue is full.
  */
-static void I2C_LCD_Write4Bits(I2C_LCD_HandleTypeDef* hi2c_lcd, uint8_t Val)
+static HAL_StatusTypeDef I2C_LCD_Enqueue(I2C_LCD_HandleTypeDef* hi2c_lcd, uint8_t Val, uint8_t Ctrl, uint16_t WaitUs)
 {
-	I2C_LCD_ExpanderWrite(hi2c_lcd, Val);
-	I2C_LCD_EnPulse(hi2c_lcd, Val);
+	uint16_t Head = hi2c_lcd->QueueHead;
+
+	if (I2C_LCD_QueueFree(hi2c_lcd) == 0)
+	{
+		hi2c_lcd->Dropped++;
+		hi2c_lcd->CursorRow = I2C_LCD_CURSOR_UNKNOWN;
+		return HAL_BUSY;
+	}
+	I2C_LCD_QueueEntryTypeDef* Entry = &hi2c_lcd->Queue[Head & (I2C_LCD_QUEUE_SIZE - 1)];
+	Entry->Val = Val;
+	Entry->Ctrl = Ctrl | hi2c_lcd->BacklightVal;
+	Entry->WaitUs = WaitUs;
+	__DMB(); // publish the entry before the new head
+	hi2c_lcd->QueueHead = Head + 1;
+
+	I2C_LCD_Kick(hi2c_lcd);
+	return HAL_OK;
 }
 
 /**
- * @brief Sends a byte to the I2C LCD in two 4-bit nibbles.
+ * @brief Queues a command that needs a longer execution time than the I2C gap between entries.
  *
- * This function sends the high and low nibbles of a byte to the LCD.
+ * Standard commands need 37us, less than the I2C time before the next EN strobe,
+ * so they are queued with WaitUs = 0 by I2C_LCD_Cmd and may share a burst.
  *
  * @param hi2c_lcd Pointer to the I2C_LCD_HandleTypeDef structure that contains the I2C configuration.
- * @param Val Byte to send.
- * @param Mode Data/Command mode selector (0 for command, 1 for data).
+ * @param CMD Command byte to send.
+ * @param WaitUs Execution time of the command in microseconds.
  */
-static void I2C_LCD_Send(I2C_LCD_HandleTypeDef* hi2c_lcd, uint8_t Val, uint8_t Mode)
+static HAL_StatusTypeDef I2C_LCD_CmdWait(I2C_LCD_HandleTypeDef* hi2c_lcd, uint8_t CMD, uint16_t WaitUs)
 {
-    uint8_t HighNib = Val & 0xF0;
-    uint8_t LowNib = (Val << 4) & 0xF0;
-    I2C_LCD_Write4Bits(hi2c_lcd, (HighNib) | Mode);
-    I2C_LCD_Write4Bits(hi2c_lcd, (LowNib) | Mode);
+	return I2C_LCD_Enqueue(hi2c_lcd, CMD, 0, WaitUs);
 }
 
 /**
  * @brief Sends a command to the I2C LCD.
  *
- * This function sends a command byte to the LCD in command mode (Mode = 0).
+ * This function queues a command byte for the LCD in command mode (RS = 0).
  *
  * @param hi2c_lcd Pointer to the I2C_LCD_HandleTypeDef structure that contains the I2C configuration.
  * @param CMD Command byte to send.
  */
-static void I2C_LCD_Cmd(I2C_LCD_HandleTypeDef* hi2c_lcd, uint8_t CMD)
+static HAL_StatusTypeDef I2C_LCD_Cmd(I2C_LCD_HandleTypeDef* hi2c_lcd, uint8_t CMD)
 {
-	I2C_LCD_Send(hi2c_lcd, CMD, 0);
+	return I2C_LCD_CmdWait(hi2c_lcd, CMD, 0);
 }
 
 /**
  * @brief Sends data to the I2C LCD.
  *
- * This function sends data to the LCD in data mode (Mode = 1).
+ * This function queues a data byte for the LCD in data mode (RS = 1).
  *
  * @param hi2c_lcd Pointer to the I2C_LCD_HandleTypeDef structure that contains the I2C configuration.
  * @param DATA Data byte to send.
  */
-static void I2C_LCD_Data(I2C_LCD_HandleTypeDef* hi2c_lcd, uint8_t DATA)
+static HAL_StatusTypeDef I2C_LCD_Data(I2C_LCD_HandleTypeDef* hi2c_lcd, uint8_t DATA)
+{
+	return I2C_LCD_Enqueue(hi2c_lcd, DATA, RS, 0);
+}
+
+/**
+ * @brief Moves the display address counter, skipping the command when it is already there.
+ *
+ * @param hi2c_lcd Pointer to the I2C_LCD_HandleTypeDef structure that contains the I2C configuration.
+ * @param Col Column position.
+ * @param Row Row position.
+ */
+static void I2C_LCD_MoveTo(I2C_LCD_HandleTypeDef* hi2c_lcd, uint8_t Col, uint8_t Row)
+{
+	if (hi2c_lcd->CursorCol != Col || hi2c_lcd->CursorRow != Row)
+	{
+		I2C_LCD_SetCursor(hi2c_lcd, Col, Row);
+	}
+}
+
+/**
+ * @brief Writes one character at the address counter and mirrors it in the DDRAM copy.
+ *
+ * A character rejected by the full queue is not mirrored, so the next flush retries it.
+ *
+ * @param hi2c_lcd Pointer to the I2C_LCD_HandleTypeDef structure that contains the I2C configuration.
+ * @param Ch Character to write.
+ */
+static void I2C_LCD_PutCell(I2C_LCD_HandleTypeDef* hi2c_lcd, char Ch)
+{
+	if (I2C_LCD_Data(hi2c_lcd, Ch) != HAL_OK) return;
+	if (hi2c_lcd->CursorRow < hi2c_lcd->I2C_LCD_nRow && hi2c_lcd->CursorCol < hi2c_lcd->I2C_LCD_nCol)
+	{
+		hi2c_lcd->Ddram[hi2c_lcd->CursorRow][hi2c_lcd->CursorCol] = Ch;
+		hi2c_lcd->CursorCol++;
+	}
+	else
+	{
+		hi2c_lcd->CursorRow = I2C_LCD_CURSOR_UNKNOWN;
+	}
+}
+
+/**
+ * @brief Fills both framebuffer copies with spaces, matching a cleared display.
+ *
+ * @param hi2c_lcd Pointer to the I2C_LCD_HandleTypeDef structure that contains the I2C configuration.
+ */
+static void I2C_LCD_BlankFrames(I2C_LCD_HandleTypeDef* hi2c_lcd)
 {
-	I2C_LCD_Send(hi2c_lcd, DATA, 1);
+	memset(hi2c_lcd->Shadow, ' ', sizeof(hi2c_lcd->Shadow));
+	memset(hi2c_lcd->Ddram, ' ', sizeof(hi2c_lcd->Ddram));
 }
 
 /*-----------------------------------------------------------------------*/
@@ -157,21 +390,25 @@ static void I2C_LCD_Data(I2C_LCD_HandleTypeDef* hi2c_lcd, uint8_t DATA)
 /**
  * @brief Initializes the I2C LCD.
  *
- * This function initializes the I2C LCD by sending a series of initialization commands
- * according to the LCD datasheet. It also configures the LCD display settings.
+ * This function queues a series of initialization commands according to the LCD
+ * datasheet. It also configures the LCD display settings. The datasheet delays are
+ * timed by the wait timer, so the function returns before the display is ready.
  *
  * @param hi2c_lcd Pointer to the I2C_LCD_HandleTypeDef structure that contains the I2C configuration.
  */
 void I2C_LCD_Init(I2C_LCD_HandleTypeDef* hi2c_lcd)
 {
+	hi2c_lcd->QueueHead = hi2c_lcd->QueueTail = 0;
+	hi2c_lcd->Busy = 0;
+	hi2c_lcd->PollState = I2C_LCD_POLL_IDLE;
+	hi2c_lcd->BacklightVal = LCD_NOBACKLIGHT;
+	I2C_LCD_Hold(hi2c_lcd);
 	// According To Datasheet, We Must Wait At Least 40ms After Power Up Before Interacting With The LCD Module
-	while(HAL_GetTick() < 50);
-    I2C_LCD_Cmd(hi2c_lcd, 0x30);
-    DELAY_MS(5);  // Delay > 4.1ms
-    I2C_LCD_Cmd(hi2c_lcd, 0x30);
-    DELAY_MS(5);  // Delay > 4.1ms
-    I2C_LCD_Cmd(hi2c_lcd, 0x30);
-    DELAY_US(150);  // Delay > 100μs
+	I2C_LCD_Enqueue(hi2c_lcd, 0, I2C_LCD_RAW, I2C_LCD_POWERUP_US);
+	// The busy flag cannot be read before the interface is in 4-bit mode
+    I2C_LCD_Enqueue(hi2c_lcd, 0x30, I2C_LCD_TIMED, I2C_LCD_RESET_US);
+    I2C_LCD_Enqueue(hi2c_lcd, 0x30, I2C_LCD_TIMED, I2C_LCD_RESET_US);
+    I2C_LCD_Enqueue(hi2c_lcd, 0x30, I2C_LCD_TIMED, I2C_LCD_RESET2_US);
     I2C_LCD_Cmd(hi2c_lcd, 0x02);
     // Configure the LCD
     I2C_LCD_Cmd(hi2c_lcd, LCD_FUNCTIONSET | LCD_4BITMODE | LCD_2LINE | LCD_5x8DOTS);
@@ -181,6 +418,7 @@ void I2C_LCD_Init(I2C_LCD_HandleTypeDef* hi2c_lcd)
     hi2c_lcd->BacklightVal = LCD_BACKLIGHT;
     // Clear the LCD
     I2C_LCD_Clear(hi2c_lcd);
+    I2C_LCD_Release(hi2c_lcd);
 }
 
 /**
@@ -192,8 +430,10 @@ void I2C_LCD_Init(I2C_LCD_HandleTypeDef* hi2c_lcd)
  */
 void I2C_LCD_Clear(I2C_LCD_HandleTypeDef* hi2c_lcd)
 {
-    I2C_LCD_Cmd(hi2c_lcd, LCD_CLEARDISPLAY);
-    DELAY_MS(2);
+    if (I2C_LCD_CmdWait(hi2c_lcd, LCD_CLEARDISPLAY, I2C_LCD_CLEAR_US) != HAL_OK) return;
+    I2C_LCD_BlankFrames(hi2c_lcd);
+    hi2c_lcd->CursorCol = 0;
+    hi2c_lcd->CursorRow = 0;
 }
 
 /**
@@ -205,8 +445,9 @@ void I2C_LCD_Clear(I2C_LCD_HandleTypeDef* hi2c_lcd)
  */
 void I2C_LCD_Home(I2C_LCD_HandleTypeDef* hi2c_lcd)
 {
-    I2C_LCD_Cmd(hi2c_lcd, LCD_RETURNHOME);
-    DELAY_MS(2);
+    if (I2C_LCD_CmdWait(hi2c_lcd, LCD_RETURNHOME, I2C_LCD_CLEAR_US) != HAL_OK) return;
+    hi2c_lcd->CursorCol = 0;
+    hi2c_lcd->CursorRow = 0;
 }
 
 /**
@@ -220,12 +461,13 @@ void I2C_LCD_Home(I2C_LCD_HandleTypeDef* hi2c_lcd)
  */
 void I2C_LCD_SetCursor(I2C_LCD_HandleTypeDef* hi2c_lcd, uint8_t Col, uint8_t Row)
 {
-    int Row_Offsets[] = {0x00, 0x40, 0x14, 0x54};
-    if (Row > hi2c_lcd->I2C_LCD_nRow)
+    if (Row >= hi2c_lcd->I2C_LCD_nRow)
     {
     	Row = hi2c_lcd->I2C_LCD_nRow - 1;
     }
-    I2C_LCD_Cmd(hi2c_lcd, LCD_SETDDRAMADDR | (Col + Row_Offsets[Row]));
+    if (I2C_LCD_Cmd(hi2c_lcd, LCD_SETDDRAMADDR | (Col + Row_Offsets[Row])) != HAL_OK) return;
+    hi2c_lcd->CursorCol = Col;
+    hi2c_lcd->CursorRow = Row;
 }
 
 /**
@@ -238,7 +480,12 @@ void I2C_LCD_SetCursor(I2C_LCD_HandleTypeDef* hi2c_lcd, uint8_t Col, uint8_t Row
  */
 void I2C_LCD_WriteChar(I2C_LCD_HandleTypeDef* hi2c_lcd, char Ch)
 {
-    I2C_LCD_Data(hi2c_lcd, Ch);
+    uint8_t Col = hi2c_lcd->CursorCol, Row = hi2c_lcd->CursorRow;
+    I2C_LCD_PutCell(hi2c_lcd, Ch);
+    if (Row < hi2c_lcd->I2C_LCD_nRow && Col < hi2c_lcd->I2C_LCD_nCol)
+    {
+    	hi2c_lcd->Shadow[Row][Col] = Ch; // keep direct writes from being undone by the next flush
+    }
 }
 
 /**
@@ -251,10 +498,232 @@ void I2C_LCD_WriteChar(I2C_LCD_HandleTypeDef* hi2c_lcd, char Ch)
  */
 void I2C_LCD_WriteString(I2C_LCD_HandleTypeDef* hi2c_lcd, char *Str)
 {
+    I2C_LCD_Hold(hi2c_lcd);
     while (*Str)
     {
-        I2C_LCD_Data(hi2c_lcd, *Str++);
+        I2C_LCD_WriteChar(hi2c_lcd, *Str++);
+    }
+    I2C_LCD_Release(hi2c_lcd);
+}
+
+/**
+ * @brief Writes a string into the shadow framebuffer.
+ *
+ * This function only updates RAM; the display is updated by I2C_LCD_Flush.
+ *
+ * @param hi2c_lcd Pointer to the I2C_LCD_HandleTypeDef structure that contains the I2C configuration.
+ * @param Col Column of the first character.
+ * @param Row Row of the string.
+ * @param Str Pointer to the string, clipped at the end of the row.
+ */
+void I2C_LCD_Print(I2C_LCD_HandleTypeDef* hi2c_lcd, uint8_t Col, uint8_t Row, const char* Str)
+{
+    if (Row >= hi2c_lcd->I2C_LCD_nRow) return;
+    while (*Str && Col < hi2c_lcd->I2C_LCD_nCol)
+    {
+    	hi2c_lcd->Shadow[Row][Col++] = *Str++;
+    }
+}
+
+/**
+ * @brief Queues the changed cells of the shadow framebuffer for the display.
+ *
+ * Cells are compared with the copy of what the display shows. Runs of changed
+ * cells separated by at most I2C_LCD_MERGE_GAP unchanged cells are merged. Each
+ * run costs one cursor move, skipped when the address counter already points at
+ * the run, plus one data write per cell.
+ *
+ * @param hi2c_lcd Pointer to the I2C_LCD_HandleTypeDef structure that contains the I2C configuration.
+ * @return Number of characters queued for the display.
+ */
+uint16_t I2C_LCD_Flush(I2C_LCD_HandleTypeDef* hi2c_lcd)
+{
+    uint16_t Written = 0;
+    uint8_t Full = 0;
+
+    I2C_LCD_Hold(hi2c_lcd);
+    for (uint8_t Row = 0; Row < hi2c_lcd->I2C_LCD_nRow && !Full; Row++)
+    {
+    	uint8_t Col = 0;
+    	while (Col < hi2c_lcd->I2C_LCD_nCol)
+    	{
+    		if (hi2c_lcd->Shadow[Row][Col] == hi2c_lcd->Ddram[Row][Col])
+    		{
+    			Col++;
+    			continue;
+    		}
+    		// Extend the run over gaps of up to I2C_LCD_MERGE_GAP unchanged cells
+    		uint8_t End = Col + 1;
+    		for (uint8_t i = End; i < hi2c_lcd->I2C_LCD_nCol && i <= End + I2C_LCD_MERGE_GAP; i++)
+    		{
+    			if (hi2c_lcd->Shadow[Row][i] != hi2c_lcd->Ddram[Row][i]) End = i + 1;
+    		}
+    		// Cursor move plus the run; what does not fit stays dirty for the next flush
+    		if (I2C_LCD_QueueFree(hi2c_lcd) < 1U + (End - Col))
+    		{
+    			Full = 1;
+    			break;
+    		}
+    		I2C_LCD_MoveTo(hi2c_lcd, Col, Row);
+    		while (Col < End)
+    		{
+    			I2C_LCD_PutCell(hi2c_lcd, hi2c_lcd->Shadow[Row][Col]);
+    			Col++;
+    			Written++;
+    		}
+    	}
     }
+    I2C_LCD_Release(hi2c_lcd);
+    return Written;
+}
+
+/**
+ * @brief Checks whether the transfer queue is still draining.
+ *
+ * @param hi2c_lcd Pointer to the I2C_LCD_HandleTypeDef structure that contains the I2C configuration.
+ * @return 1 while transfers or waits are pending, 0 otherwise.
+ */
+uint8_t I2C_LCD_IsBusy(I2C_LCD_HandleTypeDef* hi2c_lcd)
+{
+	return hi2c_lcd->Busy;
+}
+
+/**
+ * @brief Handles the end of a burst or busy flag transfer.
+ *
+ * After a burst its entries are retired. The execution time of the last one is
+ * then waited out by polling the busy flag, when enabled and valid, or on the wait
+ * timer. A finished poll either repeats or resumes the queue.
+ *
+ * @param hi2c_lcd Pointer to the I2C_LCD_HandleTypeDef structure that contains the I2C configuration.
+ */
+void I2C_LCD_TxCpltCallback(I2C_LCD_HandleTypeDef* hi2c_lcd)
+{
+	if (hi2c_lcd->PollState == I2C_LCD_POLL_STROBE)
+	{
+		hi2c_lcd->PollState = I2C_LCD_POLL_READ;
+		if (HAL_I2C_Master_Receive_IT(hi2c_lcd->hi2c, (hi2c_lcd->I2C_LCD_Address<<1), &hi2c_lcd->RxByte, 1) != HAL_OK)
+		{
+			I2C_LCD_ErrorCallback(hi2c_lcd);
+		}
+		return;
+	}
+	if (hi2c_lcd->PollState == I2C_LCD_POLL_FINISH)
+	{
+		hi2c_lcd->PollState = I2C_LCD_POLL_IDLE;
+		if (!(hi2c_lcd->RxByte & I2C_LCD_BF))
+		{
+			I2C_LCD_StartNext(hi2c_lcd);
+		}
+		else if (++hi2c_lcd->PollCount < I2C_LCD_POLL_MAX)
+		{
+			I2C_LCD_StartPoll(hi2c_lcd);
+		}
+		else
+		{
+			// BF never clears when RW is not wired, fall back to timed waits
+			hi2c_lcd->BusyPolling = 0;
+			I2C_LCD_StartWait(hi2c_lcd, hi2c_lcd->PollWaitUs);
+		}
+		return;
+	}
+	if (hi2c_lcd->PollState == I2C_LCD_POLL_ABORT)
+	{
+		hi2c_lcd->PollState = I2C_LCD_POLL_IDLE;
+		I2C_LCD_StartWait(hi2c_lcd, hi2c_lcd->PollWaitUs);
+		return;
+	}
+
+	const I2C_LCD_QueueEntryTypeDef* Last = &hi2c_lcd->Queue[(hi2c_lcd->QueueTail + hi2c_lcd->BurstLen - 1) & (I2C_LCD_QUEUE_SIZE - 1)];
+	uint16_t WaitUs = Last->WaitUs;
+	uint8_t Timed = Last->Ctrl & (I2C_LCD_TIMED | I2C_LCD_RAW);
+
+	hi2c_lcd->QueueTail += hi2c_lcd->BurstLen;
+	hi2c_lcd->BurstLen = 0;
+	if (WaitUs > 0 && hi2c_lcd->BusyPolling && !Timed)
+	{
+		hi2c_lcd->PollWaitUs = WaitUs;
+		hi2c_lcd->PollCount = 0;
+		I2C_LCD_StartPoll(hi2c_lcd);
+		return;
+	}
+	I2C_LCD_StartWait(hi2c_lcd, WaitUs);
+}
+
+/**
+ * @brief Handles the end of a busy flag read and lowers EN again.
+ *
+ * @param hi2c_lcd Pointer to the I2C_LCD_HandleTypeDef structure that contains the I2C configuration.
+ */
+void I2C_LCD_RxCpltCallback(I2C_LCD_HandleTypeDef* hi2c_lcd)
+{
+	I2C_LCD_FinishPoll(hi2c_lcd, I2C_LCD_POLL_FINISH);
+}
+
+/**
+ * @brief Handles a failed transfer, e.g. a missing expander acknowledge.
+ *
+ * A failed burst is skipped. A failed busy flag read falls back to the timed wait;
+ * when the read itself failed, EN is high and the high nibble was taken, so EN is
+ * lowered and the low nibble strobed first to keep the 4-bit interface in step.
+ *
+ * @param hi2c_lcd Pointer to the I2C_LCD_HandleTypeDef structure that contains the I2C configuration.
+ */
+void I2C_LCD_ErrorCallback(I2C_LCD_HandleTypeDef* hi2c_lcd)
+{
+	hi2c_lcd->Errors++;
+	if (hi2c_lcd->PollState == I2C_LCD_POLL_READ)
+	{
+		I2C_LCD_FinishPoll(hi2c_lcd, I2C_LCD_POLL_ABORT);
+		return;
+	}
+	if (hi2c_lcd->PollState != I2C_LCD_POLL_IDLE)
+	{
+		hi2c_lcd->PollState = I2C_LCD_POLL_IDLE;
+		I2C_LCD_StartWait(hi2c_lcd, hi2c_lcd->PollWaitUs);
+		return;
+	}
+	hi2c_lcd->QueueTail += hi2c_lcd->BurstLen;
+	hi2c_lcd->BurstLen = 0;
+	I2C_LCD_StartNext(hi2c_lcd);
+}
+
+/**
+ * @brief Enables or disables busy flag polling for the long commands.
+ *
+ * With polling the queue resumes as soon as the controller reports ready, not
+ * after the datasheet worst case. It needs the expander P1 wired to RW; if the
+ * flag never clears, polling switches itself off and timed waits are used.
+ *
+ * @param hi2c_lcd Pointer to the I2C_LCD_HandleTypeDef structure that contains the I2C configuration.
+ * @param Enable 1 to poll the busy flag, 0 for timed waits.
+ */
+void I2C_LCD_SetBusyPolling(I2C_LCD_HandleTypeDef* hi2c_lcd, uint8_t Enable)
+{
+	hi2c_lcd->BusyPolling = Enable ? 1 : 0;
+}
+
+/**
+ * @brief Handles the end of an execution wait and resumes the queue.
+ *
+ * @param hi2c_lcd Pointer to the I2C_LCD_HandleTypeDef structure that contains the I2C configuration.
+ */
+void I2C_LCD_WaitElapsedCallback(I2C_LCD_HandleTypeDef* hi2c_lcd)
+{
+	HAL_TIM_Base_Stop_IT(hi2c_lcd->htim); // one-pulse mode already stopped the counter, this resets the HAL state
+	I2C_LCD_StartNext(hi2c_lcd);
+}
+
+/**
+ * @brief Called when the transfer queue has been drained.
+ *
+ * @param hi2c_lcd Pointer to the I2C_LCD_HandleTypeDef structure that contains the I2C configuration.
+ * @note This function should not be modified, when the callback is needed,
+ *       I2C_LCD_IdleCallback could be implemented in the user file.
+ */
+__weak void I2C_LCD_IdleCallback(I2C_LCD_HandleTypeDef* hi2c_lcd)
+{
+	(void)hi2c_lcd;
 }
 
 /**
@@ -291,7 +760,7 @@ void I2C_LCD_ShiftRight(I2C_LCD_HandleTypeDef* hi2c_lcd)
 void I2C_LCD_Backlight(I2C_LCD_HandleTypeDef* hi2c_lcd)
 {
 	hi2c_lcd->BacklightVal = LCD_BACKLIGHT;
-    I2C_LCD_ExpanderWrite(hi2c_lcd, 0);
+    I2C_LCD_Enqueue(hi2c_lcd, 0, I2C_LCD_RAW, 0);
 }
 
 /**
@@ -304,7 +773,7 @@ void I2C_LCD_Backlight(I2C_LCD_HandleTypeDef* hi2c_lcd)
 void I2C_LCD_NoBacklight(I2C_LCD_HandleTypeDef* hi2c_lcd)
 {
 	hi2c_lcd->BacklightVal = LCD_NOBACKLIGHT;
-    I2C_LCD_ExpanderWrite(hi2c_lcd, 0);
+    I2C_LCD_Enqueue(hi2c_lcd, 0, I2C_LCD_RAW, 0);
 }
 
 /**
@@ -397,11 +866,14 @@ void I2C_LCD_NoBlink(I2C_LCD_HandleTypeDef* hi2c_lcd)
 void I2C_LCD_CreateCustomChar(I2C_LCD_HandleTypeDef* hi2c_lcd, uint8_t CharIndex, const uint8_t* CharMap)
 {
     CharIndex &= 0x07;
+    I2C_LCD_Hold(hi2c_lcd);
     I2C_LCD_Cmd(hi2c_lcd, LCD_SETCGRAMADDR | (CharIndex << 3));
+    hi2c_lcd->CursorRow = I2C_LCD_CURSOR_UNKNOWN; // address counter now points into CGRAM
     for (int i = 0; i < 8; i++)
     {
-    	I2C_LCD_Send(hi2c_lcd, CharMap[i], RS);
+    	I2C_LCD_Data(hi2c_lcd, CharMap[i]);
     }
+    I2C_LCD_Release(hi2c_lcd);
 }
 
 /**
@@ -414,5 +886,5 @@ void I2C_LCD_CreateCustomChar(I2C_LCD_HandleTypeDef* hi2c_lcd, uint8_t CharIndex
  */
 void I2C_LCD_PrintCustomChar(I2C_LCD_HandleTypeDef* hi2c_lcd, uint8_t CharIndex)
 {
-	I2C_LCD_Send(hi2c_lcd, CharIndex, RS);
+	I2C_LCD_WriteChar(hi2c_lcd, (char)CharIndex);
 }
@@ -0,0 +1,159 @@
+/**
+  ******************************************************************************
+  * @file     : ipc.c
+  * @author   : MS    Mateusz.Stasiak@student.put.poznan.pl
+  * @version  : 1.0.0
+  * @date     : Oct 17, 2026
+  * @brief    : Lock-free single-producer single-consumer ring between the cores.
+  *
+  ******************************************************************************
+  */
+
+/* Private includes ----------------------------------------------------------*/
+#include <string.h>
+#include "ipc.h"
+
+/* Private typedef -----------------------------------------------------------*/
+
+/* Private define ------------------------------------------------------------*/
+
+/* Private macro -------------------------------------------------------------*/
+
+/* Private variables ---------------------------------------------------------*/
+
+/* Public variables ----------------------------------------------------------*/
+
+/* Private function prototypes -----------------------------------------------*/
+
+/* Public function prototypes ------------------------------------------------*/
+
+/* Private functions ---------------------------------------------------------*/
+
+static void IPC_Clean(const volatile void* Addr, uint32_t Size)
+{
+#if defined(CORE_CM7) && (__DCACHE_PRESENT == 1U)
+	// Writes back whole lines; Addr and Size are multiples of IPC_CACHE_LINE
+	if (SCB->CCR & SCB_CCR_DC_Msk) SCB_CleanDCache_by_Addr((uint32_t*)Addr, (int32_t)Size);
+#else
+	(void)Addr;
+	(void)Size;
+#endif
+}
+
+static void IPC_Invalidate(const volatile void* Addr, uint32_t Size)
+{
+#if defined(CORE_CM7) && (__DCACHE_PRESENT == 1U)
+	// Only lines the other core writes, or that this core cleaned after writing
+	if (SCB->CCR & SCB_CCR_DC_Msk) SCB_InvalidateDCache_by_Addr((void*)Addr, (int32_t)Size);
+#else
+	(void)Addr;
+	(void)Size;
+#endif
+}
+
+static void IPC_Notify(uint32_t SemId)
+{
+	if (SemId != 0 && HAL_HSEM_FastTake(SemId) == HAL_OK)
+	{
+		HAL_HSEM_Release(SemId, 0);
+	}
+}
+
+/* Public functions ----------------------------------------------------------*/
+
+/**
+ * @brief Empties the ring and writes its geometry for the other core.
+ * @param hipc Pointer to the IPC_HandleTypeDef structure.
+ */
+void IPC_Init(IPC_HandleTypeDef* hipc)
+{
+	IPC_RingTypeDef *Ring = hipc->Ring;
+
+	memset((void*)Ring, 0, sizeof(*Ring));
+	Ring->ItemSize = hipc->Stride;
+	Ring->Count = hipc->Count;
+	__DMB();
+	Ring->Magic = IPC_MAGIC;
+	IPC_Clean(Ring, sizeof(*Ring));
+	__DSB();
+}
+
+/**
+ * @brief Checks that the ring was initialised with the geometry of this image.
+ * @param hipc Pointer to the IPC_HandleTypeDef structure.
+ * @return 1 if magic, item size and count agree, 0 otherwise.
+ */
+uint8_t IPC_IsReady(const IPC_HandleTypeDef* hipc)
+{
+	const IPC_RingTypeDef *Ring = hipc->Ring;
+
+	IPC_Invalidate(Ring, IPC_CACHE_LINE);
+	return Ring->Magic == IPC_MAGIC && Ring->ItemSize == hipc->Stride && Ring->Count == hipc->Count;
+}
+
+/**
+ * @brief Copies an item into the ring and notifies the consumer.
+ * @param hipc Pointer to the IPC_HandleTypeDef structure.
+ * @param Item ItemSize bytes to copy.
+ * @return HAL_OK, or HAL_BUSY if the ring is full and the item was dropped.
+ */
+HAL_StatusTypeDef IPC_Push(IPC_HandleTypeDef* hipc, const void* Item)
+{
+	IPC_RingTypeDef *Ring = hipc->Ring;
+	uint32_t Head = Ring->Head;
+
+	IPC_Invalidate(&Ring->Tail, IPC_CACHE_LINE);
+	if (Head - Ring->Tail >= hipc->Count)
+	{
+		Ring->Dropped++;
+		IPC_Clean(&Ring->Head, IPC_CACHE_LINE);
+		return HAL_BUSY;
+	}
+
+	uint8_t *Slot = &hipc->Data[(Head & (hipc->Count - 1U)) * hipc->Stride];
+	memcpy(Slot, Item, hipc->ItemSize);
+	IPC_Clean(Slot, hipc->Stride);
+	__DMB(); // the item reaches the memory before the head that publishes it
+	Ring->Head = Head + 1U;
+	IPC_Clean(&Ring->Head, IPC_CACHE_LINE);
+	__DSB();
+	IPC_Notify(hipc->SemId);
+	return HAL_OK;
+}
+
+/**
+ * @brief Copies the oldest item out of the ring.
+ * @param hipc Pointer to the IPC_HandleTypeDef structure.
+ * @param Item Output, ItemSize bytes.
+ * @return 1 if an item was copied, 0 if the ring is empty.
+ */
+uint8_t IPC_Pop(IPC_HandleTypeDef* hipc, void* Item)
+{
+	IPC_RingTypeDef *Ring = hipc->Ring;
+	uint32_t Tail = Ring->Tail;
+
+	IPC_Invalidate(&Ring->Head, IPC_CACHE_LINE);
+	if (Ring->Head == Tail) return 0;
+	__DMB(); // the head is read before the item it publishes
+
+	uint8_t *Slot = &hipc->Data[(Tail & (hipc->Count - 1U)) * hipc->Stride];
+	IPC_Invalidate(Slot, hipc->Stride);
+	memcpy(Item, Slot, hipc->ItemSize);
+	__DMB(); // and the item is read before the slot is handed back
+	Ring->Tail = Tail + 1U;
+	IPC_Clean(&Ring->Tail, IPC_CACHE_LINE);
+	return 1;
+}
+
+/**
+ * @brief Returns the number of items waiting in the ring.
+ * @param hipc Pointer to the IPC_HandleTypeDef structure.
+ */
+uint16_t IPC_Pending(const IPC_HandleTypeDef* hipc)
+{
+	const IPC_RingTypeDef *Ring = hipc->Ring;
+
+	// Both index lines are always cleaned by their writer, so invalidating them is safe
+	IPC_Invalidate(&Ring->Head, 2U * IPC_CACHE_LINE);
+	return (uint16_t)(Ring->Head - Ring->Tail);
+}
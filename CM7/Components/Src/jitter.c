@@ -0,0 +1,124 @@
+/**
+  ******************************************************************************
+  * @file     : jitter.c
+  * @author   : MS    Mateusz.Stasiak@student.put.poznan.pl
+  * @version  : 1.0.0
+  * @date     : Oct 17, 2026
+  * @brief    : Sampling interval (jitter) statistics.
+  *
+  ******************************************************************************
+  */
+
+/* Private includes ----------------------------------------------------------*/
+#include <math.h>
+#include "jitter.h"
+#include "utils.h"
+
+/* Private typedef -----------------------------------------------------------*/
+
+/* Private define ------------------------------------------------------------*/
+
+/* Private macro -------------------------------------------------------------*/
+
+/* Private variables ---------------------------------------------------------*/
+
+/* Public variables ----------------------------------------------------------*/
+
+/* Private function prototypes -----------------------------------------------*/
+
+/* Public function prototypes ------------------------------------------------*/
+
+/* Private functions ---------------------------------------------------------*/
+
+/* Public functions ----------------------------------------------------------*/
+
+/**
+ * @brief Clears the collected interval statistics.
+ * @param hjitter Pointer to the JITTER_HandleTypeDef structure that holds the statistics.
+ */
+void JITTER_Reset(JITTER_HandleTypeDef* hjitter)
+{
+	// JITTER_Update runs in an interrupt and must not see a half-cleared handle
+	uint32_t primask = __get_PRIMASK();
+	__disable_irq();
+	hjitter->Started = 0;
+	hjitter->Count = 0;
+	hjitter->Min = UINT32_MAX;
+	hjitter->Max = 0;
+	hjitter->Reference = 0;
+	hjitter->Sum = 0;
+	hjitter->SumSq = 0;
+	__set_PRIMASK(primask);
+}
+
+/**
+ * @brief Adds a new event timestamp and updates the interval statistics.
+ * @param hjitter Pointer to the JITTER_HandleTypeDef structure that holds the statistics.
+ * @param Timestamp Event time in timer ticks (e.g. DWT cycles), may wrap around.
+ * @note Integer sums of the deviations from the first interval, so the mean and the spread
+ *       keep full resolution however large the intervals and however long the run.
+ */
+ITCM_FUNC void JITTER_Update(JITTER_HandleTypeDef* hjitter, uint32_t Timestamp)
+{
+	if (!hjitter->Started)
+	{
+		hjitter->Started = 1;
+		hjitter->LastTimestamp = Timestamp;
+		return;
+	}
+
+	uint32_t interval = Timestamp - hjitter->LastTimestamp;
+	hjitter->LastTimestamp = Timestamp;
+
+	hjitter->Sequence++;
+	__DMB();
+	if (hjitter->Count == 0) hjitter->Reference = interval;
+	if (interval < hjitter->Min) hjitter->Min = interval;
+	if (interval > hjitter->Max) hjitter->Max = interval;
+
+	int64_t deviation = (int32_t)(interval - hjitter->Reference);
+	hjitter->Count++;
+	hjitter->Sum += deviation;
+	hjitter->SumSq += (uint64_t)(deviation * deviation);
+	__DMB();
+	hjitter->Sequence++;
+}
+
+/**
+ * @brief Returns a consistent copy of the statistics.
+ * @param hjitter Pointer to the JITTER_HandleTypeDef structure that holds the statistics.
+ * @param Stats Output: count, extremes, mean and standard deviation in timer ticks.
+ * @note The copy is retried until no update ran during it, so no interrupt is masked.
+ */
+void JITTER_GetStats(const JITTER_HandleTypeDef* hjitter, JITTER_StatsTypeDef* Stats)
+{
+	uint32_t sequence, reference;
+	int64_t sum;
+	uint64_t sumSq;
+
+	do
+	{
+		sequence = hjitter->Sequence;
+		__DMB();
+		Stats->Count = hjitter->Count;
+		Stats->Min = hjitter->Min;
+		Stats->Max = hjitter->Max;
+		reference = hjitter->Reference;
+		sum = hjitter->Sum;
+		sumSq = hjitter->SumSq;
+		__DMB();
+	} while ((sequence & 1U) || sequence != hjitter->Sequence);
+
+	Stats->Mean = 0.0;
+	Stats->StdDev = 0.0;
+	if (Stats->Count == 0) return;
+
+	double n = (double)Stats->Count;
+	double mean = (double)sum / n;
+	Stats->Mean = (double)reference + mean;
+	if (Stats->Count < 2) return;
+
+	// Deviations from a value inside the spread keep the two terms close in size, no cancellation
+	double variance = ((double)sumSq - (double)sum * mean) / (n - 1.0);
+	Stats->StdDev = (variance > 0.0) ? sqrt(variance) : 0.0;
+}
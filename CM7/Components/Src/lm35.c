@@ -19,6 +19,9 @@
 /* Private macro -------------------------------------------------------------*/
 
 /* Private variables ---------------------------------------------------------*/
+// Placed in D2 SRAM: DMA1 cannot reach DTCM, and the region must stay out of the D-cache
+static uint16_t LM35_DmaBuffer[LM35_DMA_BUFFER_LENGTH] __attribute__((section(".dma_buffer"), aligned(32)));
+static LM35_SourceTypeDef LM35_Source = LM35_GetLatestReg;
 
 /* Public variables ----------------------------------------------------------*/
 
@@ -28,33 +31,130 @@
 
 /* Private functions ---------------------------------------------------------*/
 
+/**
+ * @brief Returns the buffer index the DMA will write next.
+ * @param hadc Pointer to the ADC_HandleTypeDef structure containing ADC configuration.
+ * @return Write index in the range 0..LM35_DMA_BUFFER_LENGTH-1.
+ */
+static uint16_t LM35_WriteIndex(ADC_HandleTypeDef *hadc)
+{
+	uint32_t remaining = __HAL_DMA_GET_COUNTER(hadc->DMA_Handle);
+	return (uint16_t)((LM35_DMA_BUFFER_LENGTH - remaining) % LM35_DMA_BUFFER_LENGTH);
+}
+
 /**
  * @brief Converts the input voltage to temperature based on LM35 sensor characteristics.
  * @param voltage The input voltage measured from the LM35 sensor.
  * @return The corresponding temperature in Celsius.
  * @note The LM35 sensor provides a voltage that is linearly proportional to the temperature in Celsius, with a typical scale factor of 10mV per degree Celsius.
  */
-float LM35_VOLTAGE2TEMP(float voltage) { return voltage / 10; }
+float LM35_VOLTAGE2TEMP(float voltage) { return voltage * 0.1f; }
 /* Public functions ----------------------------------------------------------*/
 
+/**
+ * @brief Starts ADC acquisition of the LM35 into a circular DMA buffer.
+ * @param hadc Pointer to the ADC_HandleTypeDef structure containing ADC configuration.
+ * @return HAL status of the ADC start.
+ * @note The ADC must be configured with circular DMA data management; conversions are started by
+ *       its trigger (timer TRGO or continuous mode). After this call the buffer is refreshed by hardware
+ *       and never has to be polled. Half and full buffer events arrive through the HAL ADC callbacks.
+ */
+HAL_StatusTypeDef LM35_Start(ADC_HandleTypeDef *hadc)
+{
+	return HAL_ADC_Start_DMA(hadc, (uint32_t*)LM35_DmaBuffer, LM35_DMA_BUFFER_LENGTH);
+}
+
+/**
+ * @brief Changes the sampling time and hardware oversampling of the LM35 ADC at run time.
+ * @param hadc Pointer to the ADC_HandleTypeDef structure containing ADC configuration.
+ * @param Config Pointer to the ADC_SamplingConfigTypeDef structure with the new settings.
+ * @return HAL status; on HAL_ERROR the acquisition is left stopped.
+ * @note Acquisition is stopped, reconfigured and restarted, so the DMA buffer starts over.
+ */
+HAL_StatusTypeDef LM35_ConfigADC(ADC_HandleTypeDef *hadc, const ADC_SamplingConfigTypeDef *Config)
+{
+	if (HAL_ADC_Stop_DMA(hadc) != HAL_OK) return HAL_ERROR;
+	if (ADC_ConfigSampling(hadc, Config) != HAL_OK) return HAL_ERROR;
+	return LM35_Start(hadc);
+}
+
+/**
+ * @brief Returns the most recent raw ADC sample written by the DMA.
+ * @param hadc Pointer to the ADC_HandleTypeDef structure containing ADC configuration.
+ * @return The latest ADC register value.
+ * @note Constant time, does not block.
+ */
+uint16_t LM35_GetLatestReg(ADC_HandleTypeDef *hadc)
+{
+	uint16_t idx = LM35_WriteIndex(hadc);
+	idx = (idx + LM35_DMA_BUFFER_LENGTH - 1) % LM35_DMA_BUFFER_LENGTH;
+	return LM35_DmaBuffer[idx];
+}
+
+/**
+ * @brief Copies the most recent raw ADC samples written by the DMA.
+ * @param hadc Pointer to the ADC_HandleTypeDef structure containing ADC configuration.
+ * @param Block Destination buffer, oldest sample first.
+ * @param Length Number of samples requested.
+ * @return Number of samples copied (limited to LM35_DMA_BUFFER_LENGTH).
+ */
+uint16_t LM35_ReadBlock(ADC_HandleTypeDef *hadc, uint16_t *Block, uint16_t Length)
+{
+	if (Length > LM35_DMA_BUFFER_LENGTH) Length = LM35_DMA_BUFFER_LENGTH;
+	uint16_t idx = LM35_WriteIndex(hadc);
+	idx = (idx + LM35_DMA_BUFFER_LENGTH - Length) % LM35_DMA_BUFFER_LENGTH;
+	for (uint16_t i = 0; i < Length; i++)
+	{
+		Block[i] = LM35_DmaBuffer[idx];
+		idx = (idx + 1) % LM35_DMA_BUFFER_LENGTH;
+	}
+	return Length;
+}
+
+/**
+ * @brief Selects where LM35_GetReg and LM35_GetTemp take the raw reading from.
+ * @param Source Function returning the latest raw ADC code, NULL for the DMA buffer (LM35_GetLatestReg).
+ */
+void LM35_SetSource(LM35_SourceTypeDef Source)
+{
+	LM35_Source = (Source != NULL) ? Source : LM35_GetLatestReg;
+}
+
+/**
+ * @brief Returns the latest raw reading from the selected source.
+ * @param hadc Pointer to the ADC_HandleTypeDef structure containing ADC configuration.
+ * @return The latest ADC register value, real or injected.
+ */
+uint16_t LM35_GetReg(ADC_HandleTypeDef *hadc)
+{
+	return LM35_Source(hadc);
+}
+
 /**
  * @brief Gets the current temperature reading from the LM35 sensor using ADC.
  * @param hadc Pointer to the ADC_HandleTypeDef structure containing ADC configuration.
  * @param hfilter Pointer to the LM35_Filter_HandleTypeDef structure for filtering temperature readings.
  * @return The current temperature in Celsius after applying filtering.
- * @note This function reads the ADC value, converts it to voltage, and then applies a filter to smooth the temperature reading.
+ * @note This function takes the latest sample of the selected source, converts it to voltage, and then applies a filter to smooth the temperature reading.
  */
 float LM35_GetTemp(ADC_HandleTypeDef *hadc, LM35_Filter_HandleTypeDef *hfilter)
+{
+	return LM35_ConvertTemp(LM35_GetReg(hadc), hfilter);
+}
+
+/**
+ * @brief Converts a raw reading to temperature and passes it through the filter.
+ * @param reg Raw ADC code, e.g. from LM35_GetReg.
+ * @param hfilter Pointer to the LM35_Filter_HandleTypeDef structure for filtering temperature readings.
+ * @return The filtered temperature in Celsius.
+ */
+float LM35_ConvertTemp(uint16_t reg, LM35_Filter_HandleTypeDef *hfilter)
 {
 	float LM35_voltage;
 	float LM35_temperature;
-	HAL_ADC_Start(hadc);
-	if(HAL_ADC_PollForConversion(hadc, ADC1_TIMEOUT) == HAL_OK)
-	{
-		LM35_voltage = ADC_REG2VOLTAGE(HAL_ADC_GetValue(hadc));
-		LM35_temperature = LM35_VOLTAGE2TEMP(LM35_voltage) - 2;
-		LM35_temperature = LM35_UpdateFilter(hfilter, LM35_temperature);
-	}
+	LM35_voltage = ADC_REG2VOLTAGE(reg);
+	LM35_temperature = LM35_VOLTAGE2TEMP(LM35_voltage) - LM35_OFFSET;
+	LM35_temperature = LM35_UpdateFilter(hfilter, LM35_temperature);
 	return LM35_temperature;
 }
 
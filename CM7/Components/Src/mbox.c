@@ -0,0 +1,189 @@
+/**
+  ******************************************************************************
+  * @file     : mbox.c
+  * @author   : MS    Mateusz.Stasiak@student.put.poznan.pl
+  * @version  : 1.0.0
+  * @date     : Oct 17, 2026
+  * @brief    : Inter-core mailbox in shared SRAM: control snapshot and request slot.
+  *
+  ******************************************************************************
+  */
+
+/* Private includes ----------------------------------------------------------*/
+#include <string.h>
+#include "mbox.h"
+
+/* Private typedef -----------------------------------------------------------*/
+
+/* Private define ------------------------------------------------------------*/
+
+/* Private macro -------------------------------------------------------------*/
+
+/* Private variables ---------------------------------------------------------*/
+
+/* Public variables ----------------------------------------------------------*/
+
+/* Private function prototypes -----------------------------------------------*/
+
+/* Public function prototypes ------------------------------------------------*/
+
+/* Private functions ---------------------------------------------------------*/
+
+static void MBOX_Lock(void)
+{
+	while (HAL_HSEM_FastTake(MBOX_HSEM_LOCK) != HAL_OK)
+	{
+	}
+}
+
+static void MBOX_Unlock(void)
+{
+	HAL_HSEM_Release(MBOX_HSEM_LOCK, 0);
+}
+
+/* Public functions ----------------------------------------------------------*/
+
+/**
+ * @brief Clears the shared area and marks it valid.
+ * @param hmbox Pointer to the shared MBOX_SharedTypeDef structure.
+ */
+void MBOX_Init(MBOX_SharedTypeDef* hmbox)
+{
+	memset((void*)hmbox, 0, sizeof(*hmbox));
+	__DMB();
+	hmbox->Magic = MBOX_MAGIC;
+	__DSB();
+}
+
+/**
+ * @brief Checks that the shared area was initialised by the CM7.
+ * @param hmbox Pointer to the shared MBOX_SharedTypeDef structure.
+ * @return 1 if the area is valid, 0 otherwise.
+ */
+uint8_t MBOX_IsReady(const MBOX_SharedTypeDef* hmbox)
+{
+	return hmbox->Magic == MBOX_MAGIC;
+}
+
+/**
+ * @brief Publishes a new snapshot and notifies the other core.
+ * @param hmbox Pointer to the shared MBOX_SharedTypeDef structure.
+ * @param Snapshot Snapshot to copy.
+ */
+void MBOX_Publish(MBOX_SharedTypeDef* hmbox, const MBOX_SnapshotTypeDef* Snapshot)
+{
+	hmbox->Sequence++;
+	__DMB(); // the odd sequence is visible before any of the data changes
+	memcpy(&hmbox->Snapshot, Snapshot, sizeof(*Snapshot));
+	__DMB(); // and the data before the even one
+	hmbox->Sequence++;
+	__DSB();
+	MBOX_Notify(MBOX_HSEM_SNAPSHOT);
+}
+
+/**
+ * @brief Copies the latest consistent snapshot.
+ * @param hmbox Pointer to the shared MBOX_SharedTypeDef structure.
+ * @param Snapshot Output.
+ * @return 1 on success, 0 if every one of MBOX_READ_RETRIES attempts overlapped a write.
+ */
+uint8_t MBOX_Read(const MBOX_SharedTypeDef* hmbox, MBOX_SnapshotTypeDef* Snapshot)
+{
+	for (uint32_t i = 0; i < MBOX_READ_RETRIES; i++)
+	{
+		uint32_t Sequence = hmbox->Sequence;
+		if (Sequence & 1U) continue;
+		__DMB();
+		memcpy(Snapshot, &hmbox->Snapshot, sizeof(*Snapshot));
+		__DMB();
+		if (hmbox->Sequence == Sequence) return 1;
+	}
+	return 0;
+}
+
+/**
+ * @brief Sends a request to the CM7 and waits for its reply.
+ * @param hmbox Pointer to the shared MBOX_SharedTypeDef structure.
+ * @param Message Request on input, reply on output.
+ * @param Timeout Maximum wait [ms].
+ * @return HAL_OK, or HAL_TIMEOUT if the CM7 did not answer in time.
+ */
+HAL_StatusTypeDef MBOX_Call(MBOX_SharedTypeDef* hmbox, MBOX_MessageTypeDef* Message, uint32_t Timeout)
+{
+	uint32_t Start = HAL_GetTick();
+
+	MBOX_Lock();
+	hmbox->Message = *Message;
+	uint32_t Sequence = hmbox->RequestSequence + 1U;
+	__DMB();
+	hmbox->RequestSequence = Sequence;
+	MBOX_Unlock();
+	MBOX_Notify(MBOX_HSEM_REQUEST);
+
+	// A late reply to an abandoned request carries an older sequence; MBOX_Reply drops it
+	while (hmbox->ReplySequence != Sequence)
+	{
+		if (HAL_GetTick() - Start > Timeout) return HAL_TIMEOUT;
+	}
+
+	MBOX_Lock();
+	*Message = hmbox->Message;
+	MBOX_Unlock();
+	return HAL_OK;
+}
+
+/**
+ * @brief Fetches the pending request, if any.
+ * @param hmbox Pointer to the shared MBOX_SharedTypeDef structure.
+ * @param Message Output, valid when 1 is returned.
+ * @param Sequence Output, sequence of the request to pass to MBOX_Reply, valid when 1 is returned.
+ * @return 1 if a request waits for MBOX_Reply, 0 otherwise.
+ */
+uint8_t MBOX_GetRequest(MBOX_SharedTypeDef* hmbox, MBOX_MessageTypeDef* Message, uint32_t* Sequence)
+{
+	uint8_t Pending;
+
+	MBOX_Lock();
+	Pending = (hmbox->RequestSequence != hmbox->ReplySequence);
+	if (Pending)
+	{
+		*Message = hmbox->Message;
+		*Sequence = hmbox->RequestSequence;
+	}
+	MBOX_Unlock();
+	return Pending;
+}
+
+/**
+ * @brief Answers a request and notifies the CM4.
+ * @param hmbox Pointer to the shared MBOX_SharedTypeDef structure.
+ * @param Message Reply; report text, if any, is already in hmbox->Report.
+ * @param Sequence Sequence MBOX_GetRequest returned with the request.
+ */
+void MBOX_Reply(MBOX_SharedTypeDef* hmbox, const MBOX_MessageTypeDef* Message, uint32_t Sequence)
+{
+	MBOX_Lock();
+	// The CM4 gave up on this request and already sent the next one: its slot is not ours to write
+	if (hmbox->RequestSequence != Sequence)
+	{
+		MBOX_Unlock();
+		return;
+	}
+	hmbox->Message = *Message;
+	__DMB(); // the reply and the report text before the sequence that publishes them
+	hmbox->ReplySequence = Sequence;
+	MBOX_Unlock();
+	MBOX_Notify(MBOX_HSEM_REPLY);
+}
+
+/**
+ * @brief Notifies the other core by taking and freeing a hardware semaphore.
+ * @param SemId One of the MBOX_HSEM_x notification semaphores.
+ */
+void MBOX_Notify(uint32_t SemId)
+{
+	if (HAL_HSEM_FastTake(SemId) == HAL_OK)
+	{
+		HAL_HSEM_Release(SemId, 0);
+	}
+}
@@ -0,0 +1,279 @@
+/**
+  ******************************************************************************
+  * @file     : param.c
+  * @author   : MS    Mateusz.Stasiak@student.put.poznan.pl
+  * @version  : 1.0.0
+  * @date     : Oct 17, 2026
+  * @brief    : Registry of named, typed and range-checked runtime parameters.
+  *
+  ******************************************************************************
+  */
+
+/* Private includes ----------------------------------------------------------*/
+#include "param.h"
+
+/* Private typedef -----------------------------------------------------------*/
+
+/* Private define ------------------------------------------------------------*/
+#define PARAM_REPLY_MAX   320 // a get of every entry fits
+#define PARAM_SIGNIFICANT 7   // digits a float holds, more decimals only print noise
+
+/* Private macro -------------------------------------------------------------*/
+
+/* Private variables ---------------------------------------------------------*/
+static const char* const PARAM_StatusNames[] = {
+	[PARAM_OK]            = "ok",
+	[PARAM_ERROR_UNKNOWN] = "unknown",
+	[PARAM_ERROR_VALUE]   = "value",
+	[PARAM_ERROR_TYPE]    = "type",
+	[PARAM_ERROR_RANGE]   = "range",
+	[PARAM_ERROR_REFUSED] = "refused"
+};
+
+/* Public variables ----------------------------------------------------------*/
+
+/* Private function prototypes -----------------------------------------------*/
+
+/* Public function prototypes ------------------------------------------------*/
+
+/* Private functions ---------------------------------------------------------*/
+
+static size_t PARAM_FormatValue(FMT_HandleTypeDef* hfmt, PARAM_TypeTypeDef Type, float Value)
+{
+	if (Type == PARAM_TYPE_INT)
+	{
+		return FMT_Int(hfmt, (int32_t)((Value < 0) ? Value - 0.5f : Value + 0.5f), 0, ' ');
+	}
+
+	// Keep about PARAM_SIGNIFICANT digits, then drop the trailing zeros
+	uint8_t Decimals = PARAM_SIGNIFICANT - 1;
+	for (float Magnitude = (Value < 0) ? -Value : Value; Magnitude >= 10.0f && Decimals > 0; Magnitude /= 10.0f)
+	{
+		Decimals--;
+	}
+	size_t Start = hfmt->Length;
+	size_t End = FMT_Float(hfmt, Value, Decimals, 0, ' ');
+	if (Decimals > 0)
+	{
+		while (End > Start && hfmt->Buffer[End - 1] == '0') End--;
+		if (End > Start && hfmt->Buffer[End - 1] == '.') End--;
+		hfmt->Length = End;
+		hfmt->Buffer[End] = '\0';
+	}
+	return hfmt->Length;
+}
+
+static void PARAM_FormatArg(FMT_HandleTypeDef* hfmt, const CMD_ArgTypeDef* Arg)
+{
+	for (uint8_t i = 0; i < Arg->NameLength; i++) FMT_Char(hfmt, Arg->Name[i]);
+	if (Arg->Value[0] != '\0')
+	{
+		FMT_Char(hfmt, '=');
+		FMT_String(hfmt, Arg->Value);
+	}
+}
+
+static void PARAM_Reply(FMT_HandleTypeDef* hfmt, void (*Write)(const char* Line, size_t Length))
+{
+	// A truncated reply still ends the line
+	if (hfmt->Length >= hfmt->Size - 1) hfmt->Length = hfmt->Size - 2;
+	hfmt->Buffer[hfmt->Length] = '\0';
+	Write(hfmt->Buffer, FMT_Char(hfmt, '\n'));
+}
+
+static void PARAM_ReplyError(FMT_HandleTypeDef* hfmt, PARAM_StatusTypeDef Status, const CMD_ArgTypeDef* Arg,
+                             void (*Write)(const char* Line, size_t Length))
+{
+	FMT_Init(hfmt, hfmt->Buffer, hfmt->Size);
+	FMT_String(hfmt, "err ");
+	FMT_String(hfmt, PARAM_StatusName(Status));
+	FMT_Char(hfmt, ' ');
+	PARAM_FormatArg(hfmt, Arg);
+	PARAM_Reply(hfmt, Write);
+}
+
+static PARAM_StatusTypeDef PARAM_Parse(const PARAM_HandleTypeDef* hparam, const CMD_ArgTypeDef* Arg,
+                                       uint8_t* Id, float* Value)
+{
+	*Id = PARAM_Find(hparam, Arg);
+	if (*Id == PARAM_NOT_FOUND) return PARAM_ERROR_UNKNOWN;
+	if (Arg->Value[0] == '\0' || !CMD_ParseFloat(Arg->Value, Value)) return PARAM_ERROR_VALUE;
+	return PARAM_Check(hparam, *Id, *Value);
+}
+
+/* Public functions ----------------------------------------------------------*/
+
+/**
+ * @brief Looks up a parameter by the name of a command argument.
+ * @param hparam Pointer to the PARAM_HandleTypeDef structure.
+ * @param Arg Argument whose name is looked up.
+ * @return Index of the entry, PARAM_NOT_FOUND if there is none.
+ */
+uint8_t PARAM_Find(const PARAM_HandleTypeDef* hparam, const CMD_ArgTypeDef* Arg)
+{
+	for (uint8_t Id = 0; Id < hparam->Count; Id++)
+	{
+		if (CMD_IsName(Arg, hparam->Entries[Id].Name)) return Id;
+	}
+	return PARAM_NOT_FOUND;
+}
+
+/**
+ * @brief Checks a value against the type and range of a parameter.
+ * @param hparam Pointer to the PARAM_HandleTypeDef structure.
+ * @param Id Index of the entry.
+ * @param Value Value to check.
+ * @return PARAM_OK, PARAM_ERROR_TYPE or PARAM_ERROR_RANGE.
+ */
+PARAM_StatusTypeDef PARAM_Check(const PARAM_HandleTypeDef* hparam, uint8_t Id, float Value)
+{
+	const PARAM_EntryTypeDef *Entry = &hparam->Entries[Id];
+
+	if (!(Value >= Entry->Min && Value <= Entry->Max)) return PARAM_ERROR_RANGE;
+	if (Entry->Type == PARAM_TYPE_INT && Value != (float)(int32_t)Value) return PARAM_ERROR_TYPE;
+	return PARAM_OK;
+}
+
+/**
+ * @brief Checks and writes a value.
+ * @param hparam Pointer to the PARAM_HandleTypeDef structure.
+ * @param Id Index of the entry.
+ * @param Value New value.
+ * @return PARAM_OK, or the reason the value was not written.
+ */
+PARAM_StatusTypeDef PARAM_Set(const PARAM_HandleTypeDef* hparam, uint8_t Id, float Value)
+{
+	if (Id >= hparam->Count) return PARAM_ERROR_UNKNOWN;
+
+	PARAM_StatusTypeDef Status = PARAM_Check(hparam, Id, Value);
+	if (Status != PARAM_OK) return Status;
+	return hparam->Set(Id, Value) ? PARAM_OK : PARAM_ERROR_REFUSED;
+}
+
+/**
+ * @brief Appends "name=value" with the current value of a parameter.
+ * @param hparam Pointer to the PARAM_HandleTypeDef structure.
+ * @param Id Index of the entry.
+ * @param hfmt Destination text.
+ * @return Length of the text after appending.
+ */
+size_t PARAM_Format(const PARAM_HandleTypeDef* hparam, uint8_t Id, FMT_HandleTypeDef* hfmt)
+{
+	const PARAM_EntryTypeDef *Entry = &hparam->Entries[Id];
+
+	FMT_String(hfmt, Entry->Name);
+	FMT_Char(hfmt, '=');
+	return PARAM_FormatValue(hfmt, Entry->Type, hparam->Get(Id));
+}
+
+/**
+ * @brief Executes a get, set or list command.
+ * @param hparam Pointer to the PARAM_HandleTypeDef structure.
+ * @param Args Tokenized command line, Args[0] is the command.
+ * @param Count Number of arguments.
+ * @param Write Sink for the reply lines, each passed complete with its '\n'.
+ * @return 1 if Args[0] is a registry command and a reply was written, 0 otherwise.
+ */
+uint8_t PARAM_Command(const PARAM_HandleTypeDef* hparam, const CMD_ArgTypeDef* Args, uint8_t Count,
+                      void (*Write)(const char* Line, size_t Length))
+{
+	char Reply[PARAM_REPLY_MAX];
+	FMT_HandleTypeDef hfmt;
+	uint8_t Id;
+	float Value;
+
+	if (Count == 0) return 0;
+	FMT_Init(&hfmt, Reply, sizeof(Reply));
+
+	if (CMD_IsName(&Args[0], "list"))
+	{
+		for (Id = 0; Id < hparam->Count; Id++)
+		{
+			const PARAM_EntryTypeDef *Entry = &hparam->Entries[Id];
+			FMT_Init(&hfmt, Reply, sizeof(Reply));
+			PARAM_Format(hparam, Id, &hfmt);
+			FMT_String(&hfmt, (Entry->Type == PARAM_TYPE_INT) ? " int " : " float ");
+			PARAM_FormatValue(&hfmt, Entry->Type, Entry->Min);
+			FMT_String(&hfmt, "..");
+			PARAM_FormatValue(&hfmt, Entry->Type, Entry->Max);
+			PARAM_Reply(&hfmt, Write);
+		}
+		FMT_Init(&hfmt, Reply, sizeof(Reply));
+		FMT_String(&hfmt, "ok ");
+		FMT_UInt(&hfmt, hparam->Count, 0, ' ');
+		PARAM_Reply(&hfmt, Write);
+		return 1;
+	}
+
+	if (CMD_IsName(&Args[0], "get"))
+	{
+		for (uint8_t i = 1; i < Count; i++)
+		{
+			if (PARAM_Find(hparam, &Args[i]) == PARAM_NOT_FOUND)
+			{
+				PARAM_ReplyError(&hfmt, PARAM_ERROR_UNKNOWN, &Args[i], Write);
+				return 1;
+			}
+		}
+		FMT_String(&hfmt, "ok");
+		for (uint8_t i = 1; i < Count; i++)
+		{
+			FMT_Char(&hfmt, ' ');
+			PARAM_Format(hparam, PARAM_Find(hparam, &Args[i]), &hfmt);
+		}
+		// Without names every entry is read, a snapshot in a single line
+		for (Id = 0; Count == 1 && Id < hparam->Count; Id++)
+		{
+			FMT_Char(&hfmt, ' ');
+			PARAM_Format(hparam, Id, &hfmt);
+		}
+		PARAM_Reply(&hfmt, Write);
+		return 1;
+	}
+
+	if (CMD_IsName(&Args[0], "set"))
+	{
+		if (Count == 1)
+		{
+			PARAM_ReplyError(&hfmt, PARAM_ERROR_VALUE, &Args[0], Write);
+			return 1;
+		}
+		// Nothing is written unless every argument is valid
+		for (uint8_t i = 1; i < Count; i++)
+		{
+			PARAM_StatusTypeDef Status = PARAM_Parse(hparam, &Args[i], &Id, &Value);
+			if (Status != PARAM_OK)
+			{
+				PARAM_ReplyError(&hfmt, Status, &Args[i], Write);
+				return 1;
+			}
+		}
+
+		FMT_String(&hfmt, "ok");
+		for (uint8_t i = 1; i < Count; i++)
+		{
+			PARAM_Parse(hparam, &Args[i], &Id, &Value);
+			if (!hparam->Set(Id, Value))
+			{
+				PARAM_ReplyError(&hfmt, PARAM_ERROR_REFUSED, &Args[i], Write);
+				return 1;
+			}
+			FMT_Char(&hfmt, ' ');
+			PARAM_Format(hparam, Id, &hfmt);
+		}
+		PARAM_Reply(&hfmt, Write);
+		return 1;
+	}
+
+	return 0;
+}
+
+/**
+ * @brief Returns the reply keyword of a status.
+ * @param Status Status to describe.
+ * @return "ok", "unknown", "value", "type", "range" or "refused".
+ */
+const char* PARAM_StatusName(PARAM_StatusTypeDef Status)
+{
+	return (Status <= PARAM_ERROR_REFUSED) ? PARAM_StatusNames[Status] : "?";
+}
@@ -10,13 +10,22 @@
   */
 
 /* Private includes ----------------------------------------------------------*/
+#include <math.h>
 #include "pid.h"
+#include "utils.h"
 
 /* Private typedef -----------------------------------------------------------*/
 
 /* Private define ------------------------------------------------------------*/
 
 /* Private macro -------------------------------------------------------------*/
+#ifdef PID_USE_FIXED_POINT
+#define PID_TO_HANDLE(x) PID_Q16FromFloat(x)
+#define PID_FROM_HANDLE(q) PID_Q162FLOAT(q)
+#else
+#define PID_TO_HANDLE(x) (x)
+#define PID_FROM_HANDLE(q) (q)
+#endif
 
 /* Private variables ---------------------------------------------------------*/
 
@@ -27,6 +36,61 @@
 /* Public function prototypes ------------------------------------------------*/
 
 /* Private functions ---------------------------------------------------------*/
+#ifdef PID_USE_FIXED_POINT
+/**
+ * @brief Clamps a 64-bit intermediate to the Q16.16 range.
+ */
+static inline PID_Q16TypeDef PID_Q16Sat(int64_t x)
+{
+	if (x > PID_Q16_MAX) return PID_Q16_MAX;
+	if (x < PID_Q16_MIN) return PID_Q16_MIN;
+	return (PID_Q16TypeDef)x;
+}
+
+/**
+ * @brief Converts a float to Q16.16, saturating values outside the representable range.
+ * @note NaN converts to 0; casting it to an integer would be undefined.
+ */
+static inline PID_Q16TypeDef PID_Q16FromFloat(float x)
+{
+	if (isnan(x)) return 0;
+	if (x >= 32767.99998f) return PID_Q16_MAX;
+	if (x <= -32768.0f) return PID_Q16_MIN;
+	return PID_FLOAT2Q16(x);
+}
+
+/**
+ * @brief Saturating Q16.16 addition.
+ */
+static inline PID_Q16TypeDef PID_Q16Add(PID_Q16TypeDef a, PID_Q16TypeDef b)
+{
+	return PID_Q16Sat((int64_t)a + b);
+}
+
+/**
+ * @brief Saturating Q16.16 subtraction.
+ */
+static inline PID_Q16TypeDef PID_Q16Sub(PID_Q16TypeDef a, PID_Q16TypeDef b)
+{
+	return PID_Q16Sat((int64_t)a - b);
+}
+
+/**
+ * @brief Saturating Q16.16 multiplication with round-half-up.
+ */
+static inline PID_Q16TypeDef PID_Q16Mul(PID_Q16TypeDef a, PID_Q16TypeDef b)
+{
+	return PID_Q16Sat(((int64_t)a * b + 0x8000) >> 16);
+}
+
+/**
+ * @brief Saturating Q16.16 division, truncating towards zero. The divisor must be non-zero.
+ */
+static inline PID_Q16TypeDef PID_Q16Div(PID_Q16TypeDef a, PID_Q16TypeDef b)
+{
+	return PID_Q16Sat(((int64_t)a * 65536) / b);
+}
+#endif
 
 /* Public functions ----------------------------------------------------------*/
 
@@ -34,19 +98,20 @@
  * @brief Initializes the PID controller with given parameters.
  * @param hpid Pointer to the PID_HandleTypeDef structure that holds the PID controller state.
  * @param Kp Proportional gain constant.
- * @param Ki Integral gain constant.
- * @param Kd Derivative gain constant.
+ * @param Ki Integral gain constant [1/s].
+ * @param Kd Derivative gain constant [s].
  * @param SetPoint The desired target value for the PID controller.
- * @param anti_windup_upperLimit The upper limit for anti-windup to prevent integral windup.
- * @param anti_windup_lowerLimit The lower limit for anti-windup to prevent integral windup.
+ * @param anti_windup_upperLimit The upper limit of the integral term state.
+ * @param anti_windup_lowerLimit The lower limit of the integral term state.
  * @note This function sets the initial tuning parameters and anti-windup limits for the PID controller.
  */
 void PID_Init(PID_HandleTypeDef* hpid, float Kp, float Ki, float Kd, float SetPoint, float anti_windup_upperLimit, float anti_windup_lowerLimit)
 {
 	PID_SetTunings(hpid, Kp, Ki, Kd);
 	PID_SetReference(hpid, SetPoint);
-	hpid->anti_windup_upperLimit = anti_windup_upperLimit;
-	hpid->anti_windup_lowerLimit = anti_windup_lowerLimit;
+	PID_SetLimits(hpid, anti_windup_upperLimit, anti_windup_lowerLimit);
+	PID_SetWeighting(hpid, 1.0f, 0.0f);
+	PID_SetDerivativeFilter(hpid, PID_DEFAULT_TF);
 }
 
 /**
@@ -56,23 +121,36 @@ void PID_Init(PID_HandleTypeDef* hpid, float Kp, float Ki, float Kd, float SetPo
  */
 void PID_Reset(PID_HandleTypeDef* hpid)
 {
-	hpid->sumError = 0;
+	hpid->integral = 0;
+	hpid->dTerm = 0;
 	hpid->lastError = 0;
+	hpid->u = 0;
+	hpid->uApplied = 0;
+	PID_ResetTime(hpid);
+}
+
+/**
+ * @brief Drops the time reference of PID_Calculate and PID_CalculateAt, keeping the controller state.
+ * @param hpid Pointer to the PID_HandleTypeDef structure that holds the PID controller state.
+ */
+void PID_ResetTime(PID_HandleTypeDef* hpid)
+{
+	hpid->timeValid = 0;
 }
 
 /**
  * @brief Sets the PID controller's tuning parameters.
  * @param hpid Pointer to the PID_HandleTypeDef structure that holds the PID controller state.
  * @param Kp Proportional gain constant.
- * @param Ki Integral gain constant.
- * @param Kd Derivative gain constant.
+ * @param Ki Integral gain constant [1/s].
+ * @param Kd Derivative gain constant [s].
  * @note This function allows updating the PID tuning parameters (Kp, Ki, Kd) during operation.
  */
 void PID_SetTunings(PID_HandleTypeDef* hpid, float Kp, float Ki, float Kd)
 {
-	hpid->Kp = Kp;
-	hpid->Ki = Ki;
-	hpid->Kd = Kd;
+	hpid->Kp = PID_TO_HANDLE(Kp);
+	hpid->Ki = PID_TO_HANDLE(Ki);
+	hpid->Kd = PID_TO_HANDLE(Kd);
 }
 
 /**
@@ -83,7 +161,67 @@ void PID_SetTunings(PID_HandleTypeDef* hpid, float Kp, float Ki, float Kd)
  */
 void PID_SetReference(PID_HandleTypeDef* hpid, float SetPoint)
 {
-	hpid->SetPoint = SetPoint;
+	hpid->SetPoint = PID_TO_HANDLE(SetPoint);
+}
+
+/**
+ * @brief Sets the setpoint weights of the proportional and derivative terms.
+ * @param hpid Pointer to the PID_HandleTypeDef structure that holds the PID controller state.
+ * @param b Setpoint weight of the proportional term (1 = classic error feedback).
+ * @param c Setpoint weight of the derivative term (0 = derivative on measurement).
+ */
+void PID_SetWeighting(PID_HandleTypeDef* hpid, float b, float c)
+{
+	hpid->b = PID_TO_HANDLE(b);
+	hpid->c = PID_TO_HANDLE(c);
+}
+
+/**
+ * @brief Sets the time constant of the first-order derivative filter.
+ * @param hpid Pointer to the PID_HandleTypeDef structure that holds the PID controller state.
+ * @param Tf Filter time constant [s], independent of Kp and Kd. 0 disables the filter.
+ * @note Negative values are taken as 0. A fraction of Kd/Kp (Td/N, N = 5..20) is the usual choice,
+ *       one or two loop periods when Kp is 0.
+ */
+void PID_SetDerivativeFilter(PID_HandleTypeDef* hpid, float Tf)
+{
+	hpid->Tf = PID_TO_HANDLE((Tf > 0.0f) ? Tf : 0.0f);
+}
+
+/**
+ * @brief Selects the anti-windup strategy of the PID controller.
+ * @param hpid Pointer to the PID_HandleTypeDef structure that holds the PID controller state.
+ * @param Mode One of PID_AntiWindupTypeDef.
+ * @param Kt Tracking gain used by PID_ANTIWINDUP_BACKCALC [1/s], Kt*dt should stay below 1.
+ * @note The integral state is clamped to the anti-windup limits in every mode.
+ */
+void PID_SetAntiWindup(PID_HandleTypeDef* hpid, PID_AntiWindupTypeDef Mode, float Kt)
+{
+	hpid->AntiWindup = Mode;
+	hpid->Kt = PID_TO_HANDLE(Kt);
+}
+
+/**
+ * @brief Sets the anti-windup limits of the integral term state.
+ * @param hpid Pointer to the PID_HandleTypeDef structure that holds the PID controller state.
+ * @param anti_windup_upperLimit The upper limit of the integral term state.
+ * @param anti_windup_lowerLimit The lower limit of the integral term state.
+ */
+void PID_SetLimits(PID_HandleTypeDef* hpid, float anti_windup_upperLimit, float anti_windup_lowerLimit)
+{
+	hpid->anti_windup_upperLimit = PID_TO_HANDLE(anti_windup_upperLimit);
+	hpid->anti_windup_lowerLimit = PID_TO_HANDLE(anti_windup_lowerLimit);
+}
+
+/**
+ * @brief Reports the actuator value that was actually applied for the last output.
+ * @param hpid Pointer to the PID_HandleTypeDef structure that holds the PID controller state.
+ * @param Applied The applied actuator value, after saturation by the output stage.
+ * @note Call after each PID_Calculate; without it the output is assumed to be applied unchanged.
+ */
+void PID_TrackOutput(PID_HandleTypeDef* hpid, float Applied)
+{
+	hpid->uApplied = PID_TO_HANDLE(Applied);
 }
 
 /**
@@ -91,30 +229,255 @@ void PID_SetReference(PID_HandleTypeDef* hpid, float SetPoint)
  * @param hpid Pointer to the PID_HandleTypeDef structure that holds the PID controller state.
  * @param y The current process variable (measured value) to compare with the setpoint.
  * @return The control output that the PID controller generates.
- * @note This function computes the PID control output based on the current error between the setpoint and the measured value (y).
+ * @note The time step is measured with PID_TIMESTAMP() since the previous call.
+ *       The first call after PID_Reset() uses a zero time step (proportional action only).
+ *       A NaN measurement is replaced by the previous one.
+ */
+#ifdef PID_USE_FIXED_POINT
+ITCM_FUNC float PID_Calculate(PID_HandleTypeDef* hpid, float y)
+{
+	return PID_CalculateAt(hpid, y, PID_TIMESTAMP());
+}
+
+/**
+ * @brief Calculates the new control output for a measurement taken at a given time.
+ * @param hpid Pointer to the PID_HandleTypeDef structure that holds the PID controller state.
+ * @param y The current process variable (measured value) to compare with the setpoint.
+ * @param Timestamp PID_TIMESTAMP() value of the instant y belongs to.
+ * @return The control output that the PID controller generates.
+ */
+ITCM_FUNC float PID_CalculateAt(PID_HandleTypeDef* hpid, float y, uint32_t Timestamp)
+{
+	uint64_t ticks = hpid->timeValid ? (uint32_t)(Timestamp - hpid->lastTime) : 0;
+	hpid->lastTime = Timestamp;
+	hpid->timeValid = 1;
+
+	PID_Q16TypeDef dt = PID_Q16Sat((int64_t)((ticks << 16) / PID_TIMESTAMP_FREQ));
+	return PID_Q162FLOAT(PID_CalculateQ16(hpid, isnan(y) ? hpid->y : PID_Q16FromFloat(y), dt));
+}
+
+/**
+ * @brief Calculates the new control output for an explicit time step.
+ * @param hpid Pointer to the PID_HandleTypeDef structure that holds the PID controller state.
+ * @param y The current process variable (measured value) to compare with the setpoint.
+ * @param dt Time elapsed since the previous step [s].
+ * @return The control output that the PID controller generates.
+ */
+ITCM_FUNC float PID_CalculateDt(PID_HandleTypeDef* hpid, float y, float dt)
+{
+	return PID_Q162FLOAT(PID_CalculateQ16(hpid, isnan(y) ? hpid->y : PID_Q16FromFloat(y), PID_Q16FromFloat(dt)));
+}
+
+/**
+ * @brief Calculates the new control output using Q16.16 saturating arithmetic only.
+ * @param hpid Pointer to the PID_HandleTypeDef structure that holds the PID controller state.
+ * @param y The current process variable in Q16.16.
+ * @param dt Time elapsed since the previous step in Q16.16 seconds.
+ * @return The control output in Q16.16.
+ * @note Mirrors the float implementation step by step; every operation saturates instead of wrapping.
  */
-float PID_Calculate(PID_HandleTypeDef* hpid, float y)
+ITCM_FUNC PID_Q16TypeDef PID_CalculateQ16(PID_HandleTypeDef* hpid, PID_Q16TypeDef y, PID_Q16TypeDef dt)
 {
 	hpid->y = y;
-	//float now = millis();
-	//float timeChange = (float)(now-hpid->lastTime);
-	float timeChange = 1;
+	hpid->dt = dt;
+
+	PID_Q16TypeDef error = PID_Q16Sub(hpid->SetPoint, hpid->y);
+	PID_Q16TypeDef dError = PID_Q16Sub(PID_Q16Mul(hpid->c, hpid->SetPoint), hpid->y);
+	if (dt > 0)
+	{
+		PID_Q16TypeDef dI = PID_Q16Mul(PID_Q16Mul(hpid->Ki, error), dt);
+		PID_Q16TypeDef excess = PID_Q16Sub(hpid->u, hpid->uApplied);
+
+		if (hpid->AntiWindup == PID_ANTIWINDUP_CONDITIONAL)
+		{
+			if ((excess > 0 && dI > 0) || (excess < 0 && dI < 0)) dI = 0;
+		}
+		else if (hpid->AntiWindup == PID_ANTIWINDUP_BACKCALC)
+		{
+			dI = PID_Q16Sub(dI, PID_Q16Mul(PID_Q16Mul(hpid->Kt, excess), dt));
+		}
+		hpid->integral = PID_Q16Add(hpid->integral, dI);
+
+		// Backward Euler discretisation of Kd*s/(1 + Tf*s)
+		PID_Q16TypeDef num = PID_Q16Add(PID_Q16Mul(hpid->Tf, hpid->dTerm), PID_Q16Mul(hpid->Kd, PID_Q16Sub(dError, hpid->lastError)));
+		hpid->dTerm = PID_Q16Div(num, PID_Q16Add(hpid->Tf, dt));
+	}
+	else
+	{
+		// No time passed: no rate of change to filter. lastError is still updated below,
+		// the next dt is measured from this step
+		hpid->dTerm = 0;
+	}
+
+	if (hpid->integral >= hpid->anti_windup_upperLimit) hpid->integral = hpid->anti_windup_upperLimit;
+	else if (hpid->integral <= hpid->anti_windup_lowerLimit) hpid->integral = hpid->anti_windup_lowerLimit;
+
+	PID_Q16TypeDef p_term = PID_Q16Mul(hpid->Kp, PID_Q16Sub(PID_Q16Mul(hpid->b, hpid->SetPoint), hpid->y));
+
+	hpid->u = PID_Q16Add(PID_Q16Add(p_term, hpid->integral), hpid->dTerm);
+	hpid->uApplied = hpid->u;
+
+	hpid->lastError = dError;
+
+	return hpid->u;
+}
+#else
+ITCM_FUNC float PID_Calculate(PID_HandleTypeDef* hpid, float y)
+{
+	return PID_CalculateAt(hpid, y, PID_TIMESTAMP());
+}
+
+/**
+ * @brief Calculates the new control output for a measurement taken at a given time.
+ * @param hpid Pointer to the PID_HandleTypeDef structure that holds the PID controller state.
+ * @param y The current process variable (measured value) to compare with the setpoint.
+ * @param Timestamp PID_TIMESTAMP() value of the instant y belongs to.
+ * @return The control output that the PID controller generates.
+ */
+ITCM_FUNC float PID_CalculateAt(PID_HandleTypeDef* hpid, float y, uint32_t Timestamp)
+{
+	uint32_t ticks = hpid->timeValid ? Timestamp - hpid->lastTime : 0;
+	hpid->lastTime = Timestamp;
+	hpid->timeValid = 1;
+
+	return PID_CalculateDt(hpid, y, (float)ticks / (float)PID_TIMESTAMP_FREQ);
+}
+
+/**
+ * @brief Calculates the new control output for an explicit time step.
+ * @param hpid Pointer to the PID_HandleTypeDef structure that holds the PID controller state.
+ * @param y The current process variable (measured value) to compare with the setpoint.
+ * @param dt Time elapsed since the previous step [s].
+ * @return The control output that the PID controller generates.
+ * @note A non-positive dt freezes the integrator and zeroes the derivative term for this step;
+ *       the next step differentiates against this one.
+ */
+ITCM_FUNC float PID_CalculateDt(PID_HandleTypeDef* hpid, float y, float dt)
+{
+	if (!isnan(y)) hpid->y = y; // a NaN reading would stick in the integrator, hold the last one
+	hpid->dt = dt;
 
 	float error = hpid->SetPoint - hpid->y;
-	hpid->sumError += (error*timeChange);
-	float dErr = (error - hpid->lastError)/timeChange;
+	float dError = hpid->c*hpid->SetPoint - hpid->y;
+	if (dt > 0)
+	{
+		float dI = hpid->Ki*error*dt;
+		float excess = hpid->u - hpid->uApplied; // > 0 when the actuator saturated high
+
+		if (hpid->AntiWindup == PID_ANTIWINDUP_CONDITIONAL)
+		{
+			if ((excess > 0 && dI > 0) || (excess < 0 && dI < 0)) dI = 0;
+		}
+		else if (hpid->AntiWindup == PID_ANTIWINDUP_BACKCALC)
+		{
+			dI -= hpid->Kt*excess*dt;
+		}
+		hpid->integral += dI;
+
+		// Backward Euler discretisation of Kd*s/(1 + Tf*s)
+		hpid->dTerm = (hpid->Tf*hpid->dTerm + hpid->Kd*(dError - hpid->lastError))/(hpid->Tf + dt);
+	}
+	else
+	{
+		// No time passed: no rate of change to filter. lastError is still updated below,
+		// the next dt is measured from this step
+		hpid->dTerm = 0;
+	}
 
-	float p_term = hpid->Kp*error;
-	float i_term = hpid->Ki*hpid->sumError;
-	float d_term = hpid->Kd*dErr;
+	if (hpid->integral >= hpid->anti_windup_upperLimit) hpid->integral = hpid->anti_windup_upperLimit;
+	else if (hpid->integral <= hpid->anti_windup_lowerLimit) hpid->integral = hpid->anti_windup_lowerLimit;
 
-	if (i_term >= hpid->anti_windup_upperLimit) i_term = hpid->anti_windup_upperLimit;
-	else if (i_term <= hpid->anti_windup_lowerLimit) i_term = hpid->anti_windup_lowerLimit;
+	float p_term = hpid->Kp*(hpid->b*hpid->SetPoint - hpid->y);
 
-	hpid->u = p_term + i_term + d_term;
+	hpid->u = p_term + hpid->integral + hpid->dTerm;
+	hpid->uApplied = hpid->u;
 
-	hpid->lastError = error;
-	//hpid->lastTime = now;
+	hpid->lastError = dError;
 
 	return hpid->u;
 }
+#endif
+
+/**
+ * @brief Returns the current reference (setpoint) value of the PID controller.
+ * @param hpid Pointer to the PID_HandleTypeDef structure that holds the PID controller state.
+ * @return The setpoint in engineering units.
+ */
+float PID_GetReference(const PID_HandleTypeDef* hpid)
+{
+	return PID_FROM_HANDLE(hpid->SetPoint);
+}
+
+/**
+ * @brief Returns the current tuning parameters of the PID controller.
+ * @param hpid Pointer to the PID_HandleTypeDef structure that holds the PID controller state.
+ * @param Kp Output for the proportional gain constant.
+ * @param Ki Output for the integral gain constant.
+ * @param Kd Output for the derivative gain constant.
+ */
+void PID_GetTunings(const PID_HandleTypeDef* hpid, float* Kp, float* Ki, float* Kd)
+{
+	*Kp = PID_FROM_HANDLE(hpid->Kp);
+	*Ki = PID_FROM_HANDLE(hpid->Ki);
+	*Kd = PID_FROM_HANDLE(hpid->Kd);
+}
+
+/**
+ * @brief Returns the setpoint weights of the proportional and derivative terms.
+ * @param hpid Pointer to the PID_HandleTypeDef structure that holds the PID controller state.
+ * @param b Output for the setpoint weight of the proportional term.
+ * @param c Output for the setpoint weight of the derivative term.
+ */
+void PID_GetWeighting(const PID_HandleTypeDef* hpid, float* b, float* c)
+{
+	*b = PID_FROM_HANDLE(hpid->b);
+	*c = PID_FROM_HANDLE(hpid->c);
+}
+
+/**
+ * @brief Returns the time constant of the derivative filter.
+ * @param hpid Pointer to the PID_HandleTypeDef structure that holds the PID controller state.
+ * @return The filter time constant Tf [s], 0 when the filter is disabled.
+ */
+float PID_GetDerivativeFilter(const PID_HandleTypeDef* hpid)
+{
+	return PID_FROM_HANDLE(hpid->Tf);
+}
+
+/**
+ * @brief Returns the anti-windup strategy of the PID controller.
+ * @param hpid Pointer to the PID_HandleTypeDef structure that holds the PID controller state.
+ * @param Mode Output for the strategy.
+ * @param Kt Output for the tracking gain [1/s].
+ */
+void PID_GetAntiWindup(const PID_HandleTypeDef* hpid, PID_AntiWindupTypeDef* Mode, float* Kt)
+{
+	*Mode = hpid->AntiWindup;
+	*Kt = PID_FROM_HANDLE(hpid->Kt);
+}
+
+/**
+ * @brief Returns the anti-windup limits of the integral term state.
+ * @param hpid Pointer to the PID_HandleTypeDef structure that holds the PID controller state.
+ * @param anti_windup_upperLimit Output for the upper limit.
+ * @param anti_windup_lowerLimit Output for the lower limit.
+ */
+void PID_GetLimits(const PID_HandleTypeDef* hpid, float* anti_windup_upperLimit, float* anti_windup_lowerLimit)
+{
+	*anti_windup_upperLimit = PID_FROM_HANDLE(hpid->anti_windup_upperLimit);
+	*anti_windup_lowerLimit = PID_FROM_HANDLE(hpid->anti_windup_lowerLimit);
+}
+
+/**
+ * @brief Returns the contributions of the last computed output.
+ * @param hpid Pointer to the PID_HandleTypeDef structure that holds the PID controller state.
+ * @param P Output for the proportional term.
+ * @param I Output for the integral term.
+ * @param D Output for the derivative term.
+ */
+void PID_GetTerms(const PID_HandleTypeDef* hpid, float* P, float* I, float* D)
+{
+	*I = PID_FROM_HANDLE(hpid->integral);
+	*D = PID_FROM_HANDLE(hpid->dTerm);
+	*P = PID_FROM_HANDLE(hpid->u) - *I - *D;
+}
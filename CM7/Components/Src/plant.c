@@ -0,0 +1,70 @@
+/**
+  ******************************************************************************
+  * @file     : plant.c
+  * @author   : MS    Mateusz.Stasiak@student.put.poznan.pl
+  * @version  : 1.0.0
+  * @date     : Oct 17, 2026
+  * @brief    : First-order-plus-dead-time model of the heated resistor and LM35.
+  *
+  ******************************************************************************
+  */
+
+/* Private includes ----------------------------------------------------------*/
+#include <math.h>
+#include "plant.h"
+
+/* Private typedef -----------------------------------------------------------*/
+
+/* Private define ------------------------------------------------------------*/
+
+/* Private macro -------------------------------------------------------------*/
+
+/* Private variables ---------------------------------------------------------*/
+
+/* Public variables ----------------------------------------------------------*/
+
+/* Private function prototypes -----------------------------------------------*/
+
+/* Public function prototypes ------------------------------------------------*/
+
+/* Private functions ---------------------------------------------------------*/
+
+/* Public functions ----------------------------------------------------------*/
+
+/**
+ * @brief Initializes the plant model at thermal equilibrium with the ambient.
+ * @param hplant Pointer to the PLANT_HandleTypeDef structure with Gain, Tau, DeadTime, Ambient and Ts set.
+ * @note DeadTime is rounded to whole steps and limited to PLANT_MAX_DELAY_STEPS.
+ */
+void PLANT_Init(PLANT_HandleTypeDef *hplant)
+{
+	float steps = roundf(hplant->DeadTime / hplant->Ts);
+
+	if (steps < 1.0f) steps = 1.0f;
+	else if (steps > PLANT_MAX_DELAY_STEPS) steps = PLANT_MAX_DELAY_STEPS;
+
+	hplant->DelayLength = (uint16_t)steps;
+	hplant->DelayIndex = 0;
+	for (uint16_t i = 0; i < hplant->DelayLength; i++) hplant->Delay[i] = 0.0f;
+
+	hplant->a = expf(-hplant->Ts / hplant->Tau);
+	hplant->Temperature = hplant->Ambient;
+}
+
+/**
+ * @brief Advances the plant by one integration step.
+ * @param hplant Pointer to the PLANT_HandleTypeDef structure.
+ * @param Duty Heater duty applied during the step [%].
+ * @return The sensor temperature at the end of the step [degC].
+ * @note Uses the exact zero-order-hold discretisation, so it is stable for any Ts.
+ */
+float PLANT_Step(PLANT_HandleTypeDef *hplant, float Duty)
+{
+	float delayed = hplant->Delay[hplant->DelayIndex];
+	hplant->Delay[hplant->DelayIndex] = Duty;
+	if (++hplant->DelayIndex >= hplant->DelayLength) hplant->DelayIndex = 0;
+
+	float target = hplant->Ambient + hplant->Gain * delayed;
+	hplant->Temperature = target + hplant->a * (hplant->Temperature - target);
+	return hplant->Temperature;
+}
@@ -30,21 +30,38 @@
 
 /* Public functions ----------------------------------------------------------*/
 
+/**
+ * @brief Arms the potentiometer ADC so that conversions follow its hardware trigger.
+ * @param hadc Pointer to the ADC_HandleTypeDef structure containing the ADC configuration.
+ * @return HAL status of the ADC start.
+ */
+HAL_StatusTypeDef POT_Start(ADC_HandleTypeDef *hadc)
+{
+	return HAL_ADC_Start(hadc);
+}
+
+/**
+ * @brief Changes the sampling time and hardware oversampling of the potentiometer ADC at run time.
+ * @param hadc Pointer to the ADC_HandleTypeDef structure containing the ADC configuration.
+ * @param Config Pointer to the ADC_SamplingConfigTypeDef structure with the new settings.
+ * @return HAL status; on HAL_ERROR the ADC is left stopped.
+ */
+HAL_StatusTypeDef POT_ConfigADC(ADC_HandleTypeDef *hadc, const ADC_SamplingConfigTypeDef *Config)
+{
+	if (HAL_ADC_Stop(hadc) != HAL_OK) return HAL_ERROR;
+	if (ADC_ConfigSampling(hadc, Config) != HAL_OK) return HAL_ERROR;
+	return POT_Start(hadc);
+}
+
 /**
  * @brief Retrieves the raw ADC register value for the potentiometer.
  * @param hadc Pointer to the ADC_HandleTypeDef structure containing the ADC configuration.
  * @return The raw ADC register value corresponding to the potentiometer reading.
- * @note This function reads the ADC register value from the potentiometer, which is used to determine its analog position.
+ * @note This function returns the result of the last triggered conversion without waiting, which is used to determine its analog position.
  */
 uint16_t POT_GetReg(ADC_HandleTypeDef *hadc)
 {
-	uint16_t Reg;
-	HAL_ADC_Start(hadc);
-	if(HAL_ADC_PollForConversion(hadc, ADC3_TIMEOUT) == HAL_OK)
-	{
-		Reg = ADC_REG2MAP(HAL_ADC_GetValue(hadc));
-	}
-	return Reg;
+	return ADC_REG2MAP(HAL_ADC_GetValue(hadc));
 }
 
 
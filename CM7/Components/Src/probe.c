@@ -0,0 +1,106 @@
+/**
+  ******************************************************************************
+  * @file     : probe.c
+  * @author   : MS    Mateusz.Stasiak@student.put.poznan.pl
+  * @version  : 1.0.0
+  * @date     : Oct 17, 2026
+  * @brief    : Named DWT cycle counter probes for execution time profiling.
+  *
+  ******************************************************************************
+  */
+
+/* Private includes ----------------------------------------------------------*/
+#include <string.h>
+#include "probe.h"
+#include "fmt.h"
+
+/* Private typedef -----------------------------------------------------------*/
+
+/* Private define ------------------------------------------------------------*/
+
+/* Private macro -------------------------------------------------------------*/
+
+/* Private variables ---------------------------------------------------------*/
+
+/* Public variables ----------------------------------------------------------*/
+
+/* Private function prototypes -----------------------------------------------*/
+
+/* Public function prototypes ------------------------------------------------*/
+
+/* Private functions ---------------------------------------------------------*/
+
+/* Public functions ----------------------------------------------------------*/
+
+/**
+ * @brief Clears the collected statistics of a probe.
+ * @param hprobe Pointer to the PROBE_HandleTypeDef structure that holds the statistics.
+ */
+void PROBE_Reset(PROBE_HandleTypeDef* hprobe)
+{
+	hprobe->Count = 0;
+	hprobe->Min = UINT32_MAX;
+	hprobe->Max = 0;
+	hprobe->Sum = 0;
+	memset(hprobe->Histogram, 0, sizeof(hprobe->Histogram));
+}
+
+/**
+ * @brief Adds one measured duration to the probe statistics.
+ * @param hprobe Pointer to the PROBE_HandleTypeDef structure that holds the statistics.
+ * @param Cycles Measured duration in DWT cycles.
+ * @note Constant time: the histogram bin comes from a single CLZ instruction.
+ */
+void PROBE_Record(PROBE_HandleTypeDef* hprobe, uint32_t Cycles)
+{
+	uint32_t bin = (Cycles == 0) ? 0 : 32 - __builtin_clz(Cycles);
+
+	if (bin >= PROBE_HIST_BINS) bin = PROBE_HIST_BINS - 1;
+	hprobe->Histogram[bin]++;
+
+	hprobe->Count++;
+	hprobe->Sum += Cycles;
+	if (Cycles < hprobe->Min) hprobe->Min = Cycles;
+	if (Cycles > hprobe->Max) hprobe->Max = Cycles;
+}
+
+/**
+ * @brief Formats the probe statistics as one text line for the UART.
+ * @param hprobe Pointer to the PROBE_HandleTypeDef structure that holds the statistics.
+ * @param Buffer Destination buffer.
+ * @param Size Size of the destination buffer in bytes.
+ * @return Number of characters written, excluding the terminating null.
+ * @note Output is truncated to the buffer size, the line always ends with '\n' if it fits.
+ */
+int PROBE_Format(const PROBE_HandleTypeDef* hprobe, char* Buffer, size_t Size)
+{
+	FMT_HandleTypeDef hfmt;
+
+	FMT_Init(&hfmt, Buffer, Size);
+	FMT_String(&hfmt, "P: ");
+	FMT_String(&hfmt, hprobe->Name);
+	if (hprobe->Count == 0)
+	{
+		return (int)FMT_String(&hfmt, ": N: 0\n");
+	}
+
+	FMT_String(&hfmt, ": N: ");
+	FMT_UInt(&hfmt, hprobe->Count, 0, ' ');
+	FMT_String(&hfmt, ", MIN: ");
+	FMT_Float(&hfmt, DWT_CYCLES2US(hprobe->Min), 2, 0, ' ');
+	FMT_String(&hfmt, ", MAX: ");
+	FMT_Float(&hfmt, DWT_CYCLES2US(hprobe->Max), 2, 0, ' ');
+	FMT_String(&hfmt, ", MEAN: ");
+	FMT_Float(&hfmt, DWT_CYCLES2US((float)hprobe->Sum / hprobe->Count), 2, 0, ' ');
+	FMT_String(&hfmt, " [us], H:");
+
+	for (uint32_t i = 0; i < PROBE_HIST_BINS; i++)
+	{
+		if (hprobe->Histogram[i] == 0) continue;
+		FMT_Char(&hfmt, ' ');
+		FMT_UInt(&hfmt, i, 0, ' ');
+		FMT_Char(&hfmt, ':');
+		FMT_UInt(&hfmt, hprobe->Histogram[i], 0, ' ');
+	}
+	return (int)FMT_Char(&hfmt, '\n');
+}
@@ -45,14 +45,15 @@ void PWM_Init(PWM_HandleTypeDef* hpwm)
  * @param hpwm Pointer to the PWM_HandleTypeDef structure containing the PWM configuration.
  * @param duty The duty cycle value to set (0-100).
  * @note This function adjusts the duty cycle of the PWM signal, controlling the signal's high time relative to the total period.
+ *       The value is saturated to the output limits, see PWM_SetLimits.
  */
 void PWM_WriteDuty(PWM_HandleTypeDef* hpwm, int duty)
 {
-	if (duty < 0) duty = 0;
-	else if (duty > 100) duty = 100;
+	if (duty < hpwm->Min) duty = hpwm->Min;
+	else if (duty > hpwm->Max) duty = hpwm->Max;
 
 	hpwm->Duty = duty;
-	int COMPARE = (duty * (__HAL_TIM_GET_AUTORELOAD(hpwm->htim)+1)) / 100;
+	int COMPARE = (duty * (__HAL_TIM_GET_AUTORELOAD(hpwm->htim)+1)) / PWM_DUTY_MAX;
 	__HAL_TIM_SET_COMPARE(hpwm->htim, hpwm->Channel, COMPARE);
 }
 
@@ -67,3 +68,19 @@ int PWM_ReadDuty(const PWM_HandleTypeDef* hpwm)
 	return hpwm->Duty;
 }
 
+/**
+ * @brief Sets the output limits of the PWM signal.
+ * @param hpwm Pointer to the PWM_HandleTypeDef structure containing the PWM configuration.
+ * @param Min Lowest duty cycle that is ever written [%].
+ * @param Max Highest duty cycle that is ever written [%].
+ * @return HAL_OK, or HAL_ERROR without any change unless 0 <= Min <= Max <= PWM_DUTY_MAX.
+ */
+HAL_StatusTypeDef PWM_SetLimits(PWM_HandleTypeDef* hpwm, int Min, int Max)
+{
+	if (Min < 0 || Min > Max || Max > PWM_DUTY_MAX) return HAL_ERROR;
+
+	hpwm->Min = Min;
+	hpwm->Max = Max;
+	return HAL_OK;
+}
+
@@ -0,0 +1,82 @@
+/**
+  ******************************************************************************
+  * @file     : scheduler.c
+  * @author   : MS    Mateusz.Stasiak@student.put.poznan.pl
+  * @version  : 1.0.0
+  * @date     : Oct 17, 2026
+  * @brief    : Cooperative run-to-completion task scheduler.
+  *
+  ******************************************************************************
+  */
+
+/* Private includes ----------------------------------------------------------*/
+#include "scheduler.h"
+#include "utils.h"
+
+/* Private typedef -----------------------------------------------------------*/
+
+/* Private define ------------------------------------------------------------*/
+
+/* Private macro -------------------------------------------------------------*/
+
+/* Private variables ---------------------------------------------------------*/
+
+/* Public variables ----------------------------------------------------------*/
+
+/* Private function prototypes -----------------------------------------------*/
+
+/* Public function prototypes ------------------------------------------------*/
+
+/* Private functions ---------------------------------------------------------*/
+
+/* Public functions ----------------------------------------------------------*/
+
+/**
+ * @brief Releases a task so that it runs on the next dispatch.
+ * @param hsched Pointer to the SCHED_HandleTypeDef structure that holds the task table.
+ * @param TaskId Index of the task in the task table (0 is the highest priority).
+ * @note Only the releasing context writes Released and only the dispatcher writes Taken,
+ *       so no critical section is needed.
+ */
+ITCM_FUNC void SCHED_Release(SCHED_HandleTypeDef* hsched, uint8_t TaskId)
+{
+	if (TaskId < hsched->nTasks)
+	{
+		hsched->Tasks[TaskId].Released++;
+	}
+}
+
+/**
+ * @brief Runs the highest priority released task to completion.
+ * @param hsched Pointer to the SCHED_HandleTypeDef structure that holds the task table.
+ * @return 1 if a task was run, 0 if no task was pending.
+ * @note Intended to be called repeatedly from the main loop.
+ */
+uint8_t SCHED_Dispatch(SCHED_HandleTypeDef* hsched)
+{
+	for (uint8_t i = 0; i < hsched->nTasks; i++)
+	{
+		SCHED_TaskTypeDef *task = &hsched->Tasks[i];
+		uint32_t released = task->Released;
+		if (released != task->Taken)
+		{
+			task->Overruns += (released - task->Taken) - 1;
+			task->Taken = released;
+			task->Runs++;
+			task->Function();
+			return 1;
+		}
+	}
+	return 0;
+}
+
+/**
+ * @brief Returns the number of releases of a task that were lost because it had not run yet.
+ * @param hsched Pointer to the SCHED_HandleTypeDef structure that holds the task table.
+ * @param TaskId Index of the task in the task table.
+ * @return Overrun count of the task.
+ */
+uint32_t SCHED_GetOverruns(const SCHED_HandleTypeDef* hsched, uint8_t TaskId)
+{
+	return (TaskId < hsched->nTasks) ? hsched->Tasks[TaskId].Overruns : 0;
+}
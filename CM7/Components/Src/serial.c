@@ -0,0 +1,245 @@
+/**
+  ******************************************************************************
+  * @file     : serial.c
+  * @author   : MS    Mateusz.Stasiak@student.put.poznan.pl
+  * @version  : 1.0.0
+  * @date     : Oct 17, 2026
+  * @brief    : Non-blocking UART transmit and receive through DMA ring buffers.
+  *
+  *             Single producer, single consumer: the writer only moves TxHead,
+  *             the DMA completion interrupt only moves TxTail. Each DMA transfer
+  *             sends the contiguous part of the pending bytes, up to the end of
+  *             the ring; the wrapped part follows in the next transfer.
+  *
+  *             Reception runs a circular DMA over the receive ring. The HAL
+  *             reports the DMA write index on idle line, half and full buffer;
+  *             the event only turns it into a free-running head, the bytes are
+  *             copied out later by the reader.
+  *
+  ******************************************************************************
+  */
+
+/* Private includes ----------------------------------------------------------*/
+#include <string.h>
+#include "serial.h"
+
+/* Private typedef -----------------------------------------------------------*/
+
+/* Private define ------------------------------------------------------------*/
+
+/* Private macro -------------------------------------------------------------*/
+
+/* Private variables ---------------------------------------------------------*/
+
+/* Public variables ----------------------------------------------------------*/
+
+/* Private function prototypes -----------------------------------------------*/
+
+/* Public function prototypes ------------------------------------------------*/
+
+/* Private functions ---------------------------------------------------------*/
+
+/**
+ * @brief Starts the DMA for the pending bytes up to the end of the ring, or goes idle.
+ * @param hserial Pointer to the SERIAL_HandleTypeDef structure.
+ * @note Called with TxBusy set, from the completion interrupt or with interrupts disabled.
+ */
+static void SERIAL_StartNext(SERIAL_HandleTypeDef* hserial)
+{
+	uint16_t Pending = (uint16_t)(hserial->TxHead - hserial->TxTail);
+	uint16_t Offset = hserial->TxTail & (hserial->TxSize - 1U);
+	uint16_t Chunk = hserial->TxSize - Offset;
+
+	if (Pending == 0U)
+	{
+		hserial->TxBusy = 0;
+		return;
+	}
+	if (Chunk > Pending) Chunk = Pending;
+
+	hserial->TxChunk = Chunk;
+	if (HAL_UART_Transmit_DMA(hserial->huart, &hserial->TxBuffer[Offset], Chunk) != HAL_OK)
+	{
+		hserial->TxBusy = 0; // retried by the next write
+	}
+}
+
+/**
+ * @brief Starts the DMA if no transfer is in progress.
+ * @param hserial Pointer to the SERIAL_HandleTypeDef structure.
+ */
+static void SERIAL_Kick(SERIAL_HandleTypeDef* hserial)
+{
+	uint32_t Primask = __get_PRIMASK();
+	__disable_irq(); // the completion interrupt may be clearing TxBusy right now
+	if (!hserial->TxBusy)
+	{
+		hserial->TxBusy = 1;
+		SERIAL_StartNext(hserial);
+	}
+	__set_PRIMASK(Primask);
+}
+
+/* Public functions ----------------------------------------------------------*/
+
+/**
+ * @brief Queues bytes for transmission and starts the DMA if it is idle.
+ * @param hserial Pointer to the SERIAL_HandleTypeDef structure.
+ * @param Data Bytes to send, copied into the ring.
+ * @param Length Number of bytes.
+ * @return HAL_OK if all bytes were queued, HAL_BUSY if some or all were dropped.
+ */
+HAL_StatusTypeDef SERIAL_Write(SERIAL_HandleTypeDef* hserial, const uint8_t* Data, uint16_t Length)
+{
+	uint16_t Head = hserial->TxHead;
+	uint16_t Used = (uint16_t)(Head - hserial->TxTail);
+	uint16_t Free = hserial->TxSize - Used;
+	uint16_t Count = Length;
+	HAL_StatusTypeDef Status = HAL_OK;
+
+	if (Count > Free)
+	{
+		Count = (hserial->DropPolicy == SERIAL_DROP_TRUNCATE) ? Free : 0U;
+		hserial->TxDroppedBytes += Length - Count;
+		hserial->TxDroppedWrites++;
+		Status = HAL_BUSY;
+	}
+	if (Used + Count > hserial->TxHighWater) hserial->TxHighWater = Used + Count;
+
+	if (Count > 0U)
+	{
+		uint16_t Offset = Head & (hserial->TxSize - 1U);
+		uint16_t First = hserial->TxSize - Offset;
+		if (First > Count) First = Count;
+		memcpy(&hserial->TxBuffer[Offset], Data, First);
+		memcpy(hserial->TxBuffer, Data + First, Count - First);
+		__DMB(); // publish the bytes before the new head
+		hserial->TxHead = Head + Count;
+	}
+
+	SERIAL_Kick(hserial);
+	return Status;
+}
+
+/**
+ * @brief Returns the number of bytes that can be queued without dropping.
+ * @param hserial Pointer to the SERIAL_HandleTypeDef structure.
+ */
+uint16_t SERIAL_TxFree(const SERIAL_HandleTypeDef* hserial)
+{
+	return hserial->TxSize - (uint16_t)(hserial->TxHead - hserial->TxTail);
+}
+
+/**
+ * @brief Starts the circular DMA reception with the idle-line event.
+ * @param hserial Pointer to the SERIAL_HandleTypeDef structure.
+ * @return HAL status of the UART.
+ * @note Discards anything not read yet; call only while the reception is stopped.
+ */
+HAL_StatusTypeDef SERIAL_StartReceive(SERIAL_HandleTypeDef* hserial)
+{
+	// The DMA starts over at index 0, the free-running counters follow
+	hserial->RxHead = 0;
+	hserial->RxTail = 0;
+	hserial->RxDmaPos = 0;
+	return HAL_UARTEx_ReceiveToIdle_DMA(hserial->huart, hserial->RxBuffer, hserial->RxSize);
+}
+
+/**
+ * @brief Copies received bytes out of the ring.
+ * @param hserial Pointer to the SERIAL_HandleTypeDef structure.
+ * @param Data Destination.
+ * @param Length Maximum number of bytes.
+ * @return Number of bytes copied, 0 if nothing is pending.
+ */
+uint16_t SERIAL_Read(SERIAL_HandleTypeDef* hserial, uint8_t* Data, uint16_t Length)
+{
+	if (hserial->RxRestart)
+	{
+		hserial->RxRestart = 0;
+		hserial->RxErrors++;
+		SERIAL_StartReceive(hserial);
+		return 0;
+	}
+
+	uint16_t Pending = (uint16_t)(hserial->RxHead - hserial->RxTail);
+	if (Pending > hserial->RxSize)
+	{
+		// The DMA lapped the reader; keep the newest full ring
+		hserial->RxOverruns += Pending - hserial->RxSize;
+		hserial->RxTail += Pending - hserial->RxSize;
+		Pending = hserial->RxSize;
+	}
+	if (Length > Pending) Length = Pending;
+
+	uint16_t Offset = hserial->RxTail & (hserial->RxSize - 1U);
+	uint16_t First = hserial->RxSize - Offset;
+	if (First > Length) First = Length;
+	memcpy(Data, &hserial->RxBuffer[Offset], First);
+	memcpy(Data + First, hserial->RxBuffer, Length - First);
+	hserial->RxTail += Length;
+	return Length;
+}
+
+/**
+ * @brief Recomputes the baud rate divider after the UART kernel clock changed.
+ * @param hserial Pointer to the SERIAL_HandleTypeDef structure.
+ * @param KernelHz New UART kernel clock [Hz].
+ * @return HAL_OK, HAL_BUSY if bytes are still queued or on the line, HAL_ERROR unless oversampling by 16.
+ */
+HAL_StatusTypeDef SERIAL_Retime(SERIAL_HandleTypeDef* hserial, uint32_t KernelHz)
+{
+	UART_HandleTypeDef *huart = hserial->huart;
+
+	if (huart->Init.OverSampling != UART_OVERSAMPLING_16) return HAL_ERROR;
+	// The transmit completion comes with the last stop bit, so an idle ring means an idle line
+	if (hserial->TxBusy || hserial->TxHead != hserial->TxTail) return HAL_BUSY;
+
+	// BRR is written only while the UART is disabled; CR3 keeps the DMA requests
+	__HAL_UART_DISABLE(huart);
+	huart->Instance->BRR = (uint16_t)UART_DIV_SAMPLING16(KernelHz, huart->Init.BaudRate, huart->Init.ClockPrescaler);
+	__HAL_UART_ENABLE(huart);
+	return HAL_OK;
+}
+
+/**
+ * @brief Publishes the bytes the DMA wrote since the previous event.
+ * @param hserial Pointer to the SERIAL_HandleTypeDef structure.
+ * @param Size DMA write index reported by the HAL (idle line, half or full buffer).
+ */
+void SERIAL_RxEventCallback(SERIAL_HandleTypeDef* hserial, uint16_t Size)
+{
+	uint16_t Pos = Size & (hserial->RxSize - 1U); // a full buffer reports RxSize, the DMA is back at 0
+	hserial->RxHead += (uint16_t)(Pos - hserial->RxDmaPos) & (hserial->RxSize - 1U);
+	hserial->RxDmaPos = Pos;
+}
+
+/**
+ * @brief Releases the sent chunk and starts the DMA for the next one.
+ * @param hserial Pointer to the SERIAL_HandleTypeDef structure.
+ */
+void SERIAL_TxCpltCallback(SERIAL_HandleTypeDef* hserial)
+{
+	hserial->TxTail += hserial->TxChunk;
+	hserial->TxChunk = 0;
+	SERIAL_StartNext(hserial);
+}
+
+/**
+ * @brief Recovers the rings when a UART error aborted a transfer.
+ * @param hserial Pointer to the SERIAL_HandleTypeDef structure.
+ * @note A stopped reception is restarted by the reader, which owns the receive tail.
+ */
+void SERIAL_ErrorCallback(SERIAL_HandleTypeDef* hserial)
+{
+	if (hserial->RxSize > 0U && hserial->huart->RxState == HAL_UART_STATE_READY)
+	{
+		hserial->RxRestart = 1;
+	}
+	if (hserial->TxBusy && hserial->huart->gState == HAL_UART_STATE_READY)
+	{
+		hserial->TxDroppedBytes += hserial->TxChunk;
+		hserial->TxDroppedWrites++;
+		SERIAL_TxCpltCallback(hserial);
+	}
+}
@@ -0,0 +1,218 @@
+/**
+  ******************************************************************************
+  * @file     : telemetry.c
+  * @author   : MS    Mateusz.Stasiak@student.put.poznan.pl
+  * @version  : 1.0.0
+  * @date     : Oct 17, 2026
+  * @brief    : Binary telemetry frames: fixed little-endian payload, CRC-16, COBS framing.
+  *
+  *             The payload is serialised field by field, so the layout does not
+  *             depend on struct padding or on the byte order of the host.
+  *
+  ******************************************************************************
+  */
+
+/* Private includes ----------------------------------------------------------*/
+#include <string.h>
+#include "telemetry.h"
+
+/* Private typedef -----------------------------------------------------------*/
+
+/* Private define ------------------------------------------------------------*/
+#define TELEMETRY_COBS_BLOCK  0xFFU // code of a full block: 254 data bytes, no implied zero
+
+/* Private macro -------------------------------------------------------------*/
+
+/* Private variables ---------------------------------------------------------*/
+/* CRC of each nibble shifted through the generator, two lookups per byte */
+static const uint16_t TELEMETRY_CrcTable[16] = {
+	0x0000, 0x1021, 0x2042, 0x3063, 0x4084, 0x50A5, 0x60C6, 0x70E7,
+	0x8108, 0x9129, 0xA14A, 0xB16B, 0xC18C, 0xD1AD, 0xE1CE, 0xF1EF
+};
+
+/* Public variables ----------------------------------------------------------*/
+
+/* Private function prototypes -----------------------------------------------*/
+
+/* Public function prototypes ------------------------------------------------*/
+
+/* Private functions ---------------------------------------------------------*/
+
+static uint8_t* TELEMETRY_PutU16(uint8_t* p, uint16_t Value)
+{
+	p[0] = (uint8_t)Value;
+	p[1] = (uint8_t)(Value >> 8);
+	return p + 2;
+}
+
+static uint8_t* TELEMETRY_PutU32(uint8_t* p, uint32_t Value)
+{
+	p[0] = (uint8_t)Value;
+	p[1] = (uint8_t)(Value >> 8);
+	p[2] = (uint8_t)(Value >> 16);
+	p[3] = (uint8_t)(Value >> 24);
+	return p + 4;
+}
+
+static uint8_t* TELEMETRY_PutF32(uint8_t* p, float Value)
+{
+	uint32_t Bits;
+	memcpy(&Bits, &Value, sizeof(Bits));
+	return TELEMETRY_PutU32(p, Bits);
+}
+
+static uint16_t TELEMETRY_GetU16(const uint8_t* p)
+{
+	return (uint16_t)(p[0] | (p[1] << 8));
+}
+
+static uint32_t TELEMETRY_GetU32(const uint8_t* p)
+{
+	return (uint32_t)p[0] | ((uint32_t)p[1] << 8) | ((uint32_t)p[2] << 16) | ((uint32_t)p[3] << 24);
+}
+
+static float TELEMETRY_GetF32(const uint8_t* p)
+{
+	uint32_t Bits = TELEMETRY_GetU32(p);
+	float Value;
+	memcpy(&Value, &Bits, sizeof(Value));
+	return Value;
+}
+
+/* Public functions ----------------------------------------------------------*/
+
+/**
+ * @brief Encodes a sample into a complete frame, delimiter included.
+ * @param Sample Pointer to the sample.
+ * @param Buffer Destination, at least TELEMETRY_FRAME_MAX bytes.
+ * @return Number of bytes written.
+ */
+size_t TELEMETRY_Encode(const TELEMETRY_SampleTypeDef* Sample, uint8_t* Buffer)
+{
+	uint8_t Raw[TELEMETRY_RAW_SIZE];
+	uint8_t *p = Raw;
+
+	*p++ = TELEMETRY_VERSION;
+	*p++ = TELEMETRY_TYPE_SAMPLE;
+	p = TELEMETRY_PutU16(p, Sample->Sequence);
+	p = TELEMETRY_PutU32(p, Sample->TimeMs);
+	p = TELEMETRY_PutU16(p, Sample->AdcRaw);
+	p = TELEMETRY_PutU16(p, Sample->Duty);
+	p = TELEMETRY_PutF32(p, Sample->Temperature);
+	p = TELEMETRY_PutF32(p, Sample->SetPoint);
+	p = TELEMETRY_PutF32(p, Sample->P);
+	p = TELEMETRY_PutF32(p, Sample->I);
+	p = TELEMETRY_PutF32(p, Sample->D);
+	TELEMETRY_PutU16(p, TELEMETRY_Crc16(Raw, TELEMETRY_PAYLOAD_SIZE));
+
+	size_t Length = TELEMETRY_CobsEncode(Raw, sizeof(Raw), Buffer);
+	Buffer[Length++] = TELEMETRY_DELIMITER;
+	return Length;
+}
+
+/**
+ * @brief Decodes one frame.
+ * @param Frame Bytes between two delimiters, the delimiter itself excluded.
+ * @param Length Number of bytes.
+ * @param Sample Output, valid only when TELEMETRY_OK is returned.
+ * @return TELEMETRY_OK or the reason the frame was rejected.
+ */
+TELEMETRY_StatusTypeDef TELEMETRY_Decode(const uint8_t* Frame, size_t Length, TELEMETRY_SampleTypeDef* Sample)
+{
+	uint8_t Raw[TELEMETRY_FRAME_MAX];
+
+	if (Length == 0U || Length > sizeof(Raw)) return TELEMETRY_ERROR_LENGTH;
+	size_t RawLength = TELEMETRY_CobsDecode(Frame, Length, Raw);
+	if (RawLength == 0U) return TELEMETRY_ERROR_COBS;
+	if (RawLength != TELEMETRY_RAW_SIZE) return TELEMETRY_ERROR_LENGTH;
+	if (TELEMETRY_Crc16(Raw, TELEMETRY_PAYLOAD_SIZE) != TELEMETRY_GetU16(&Raw[TELEMETRY_PAYLOAD_SIZE]))
+	{
+		return TELEMETRY_ERROR_CRC;
+	}
+	if (Raw[0] != TELEMETRY_VERSION || Raw[1] != TELEMETRY_TYPE_SAMPLE) return TELEMETRY_ERROR_VERSION;
+
+	Sample->Sequence    = TELEMETRY_GetU16(&Raw[2]);
+	Sample->TimeMs      = TELEMETRY_GetU32(&Raw[4]);
+	Sample->AdcRaw      = TELEMETRY_GetU16(&Raw[8]);
+	Sample->Duty        = TELEMETRY_GetU16(&Raw[10]);
+	Sample->Temperature = TELEMETRY_GetF32(&Raw[12]);
+	Sample->SetPoint    = TELEMETRY_GetF32(&Raw[16]);
+	Sample->P           = TELEMETRY_GetF32(&Raw[20]);
+	Sample->I           = TELEMETRY_GetF32(&Raw[24]);
+	Sample->D           = TELEMETRY_GetF32(&Raw[28]);
+	return TELEMETRY_OK;
+}
+
+/**
+ * @brief Calculates CRC-16/CCITT-FALSE.
+ * @param Data Input bytes.
+ * @param Length Number of bytes.
+ * @return The CRC, 0x29B1 for "123456789".
+ */
+uint16_t TELEMETRY_Crc16(const uint8_t* Data, size_t Length)
+{
+	uint16_t Crc = 0xFFFFU;
+	while (Length-- > 0U)
+	{
+		uint8_t Byte = *Data++;
+		Crc = (uint16_t)(Crc << 4) ^ TELEMETRY_CrcTable[(Crc >> 12) ^ (Byte >> 4)];
+		Crc = (uint16_t)(Crc << 4) ^ TELEMETRY_CrcTable[(Crc >> 12) ^ (Byte & 0x0FU)];
+	}
+	return Crc;
+}
+
+/**
+ * @brief COBS-encodes a block, without the trailing delimiter.
+ * @param In Input bytes.
+ * @param Length Number of input bytes.
+ * @param Out Destination, at least Length + Length/254 + 1 bytes; must not overlap In.
+ * @return Number of bytes written, never containing 0x00.
+ */
+size_t TELEMETRY_CobsEncode(const uint8_t* In, size_t Length, uint8_t* Out)
+{
+	size_t Write = 1;
+	size_t CodeIndex = 0;
+	uint8_t Code = 1;
+
+	for (size_t Read = 0; Read < Length; Read++)
+	{
+		if (In[Read] != 0U)
+		{
+			Out[Write++] = In[Read];
+			if (++Code != TELEMETRY_COBS_BLOCK) continue;
+		}
+		// A zero, or a full block: close the block and open the next one
+		Out[CodeIndex] = Code;
+		Code = 1;
+		CodeIndex = Write++;
+	}
+	Out[CodeIndex] = Code;
+	return Write;
+}
+
+/**
+ * @brief Decodes a COBS block.
+ * @param In Encoded bytes, delimiter excluded.
+ * @param Length Number of encoded bytes.
+ * @param Out Destination, at least Length bytes; may be the same buffer as In.
+ * @return Number of decoded bytes, 0 if the block is malformed.
+ */
+size_t TELEMETRY_CobsDecode(const uint8_t* In, size_t Length, uint8_t* Out)
+{
+	size_t Read = 0;
+	size_t Write = 0;
+
+	while (Read < Length)
+	{
+		uint8_t Code = In[Read++];
+		if (Code == 0U || Read + Code - 1U > Length) return 0;
+		for (uint8_t i = 1; i < Code; i++)
+		{
+			if (In[Read] == 0U) return 0;
+			Out[Write++] = In[Read++];
+		}
+		// Every block but a full one or the last stands for a zero byte
+		if (Code != TELEMETRY_COBS_BLOCK && Read < Length) Out[Write++] = 0;
+	}
+	return Write;
+}
@@ -29,3 +29,56 @@
 /* Private functions ---------------------------------------------------------*/
 
 /* Public functions ----------------------------------------------------------*/
+
+/**
+ * @brief Enables the DWT cycle counter used for timestamps.
+ * @note Must be called once at startup before DWT_GET_CYCLES() is used.
+ */
+void DWT_Init(void)
+{
+	CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+#ifndef CORE_CM4
+	DWT->LAR = 0xC5ACCE55; // unlock DWT access on Cortex-M7
+#endif
+	DWT->CYCCNT = 0;
+	DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+}
+
+/**
+ * @brief Applies sampling time and hardware oversampling settings to a stopped ADC.
+ * @param hadc Pointer to the ADC_HandleTypeDef structure containing the ADC configuration.
+ * @param Config Pointer to the requested sampling configuration.
+ * @return HAL_ERROR if the ratio is out of range or the shift would leave results wider than 16 bits.
+ * @note Conversions must be stopped by the caller and restarted afterwards.
+ */
+HAL_StatusTypeDef ADC_ConfigSampling(ADC_HandleTypeDef *hadc, const ADC_SamplingConfigTypeDef *Config)
+{
+	ADC_ChannelConfTypeDef sConfig = {0};
+	uint32_t shift = Config->RightBitShift >> ADC_CFGR2_OVSS_Pos;
+
+	// Oversampled sums must fit the 16-bit data path (DMA transfers are half-words)
+	if (Config->OversamplingRatio < 1 || Config->OversamplingRatio > 1024 ||
+		Config->OversamplingRatio > (1ul << shift))
+	{
+		return HAL_ERROR;
+	}
+
+	hadc->Init.OversamplingMode = (Config->OversamplingRatio > 1) ? ENABLE : DISABLE;
+	hadc->Init.Oversampling.Ratio = Config->OversamplingRatio;
+	hadc->Init.Oversampling.RightBitShift = Config->RightBitShift;
+	hadc->Init.Oversampling.TriggeredMode = Config->TriggeredMode;
+	hadc->Init.Oversampling.OversamplingStopReset = ADC_REGOVERSAMPLING_CONTINUED_MODE;
+	if (HAL_ADC_Init(hadc) != HAL_OK)
+	{
+		return HAL_ERROR;
+	}
+
+	sConfig.Channel = Config->Channel;
+	sConfig.Rank = ADC_REGULAR_RANK_1;
+	sConfig.SamplingTime = Config->SamplingTime;
+	sConfig.SingleDiff = ADC_SINGLE_ENDED;
+	sConfig.OffsetNumber = ADC_OFFSET_NONE;
+	sConfig.Offset = 0;
+	sConfig.OffsetSignedSaturation = DISABLE;
+	return HAL_ADC_ConfigChannel(hadc, &sConfig);
+}
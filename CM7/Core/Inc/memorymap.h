@@ -33,11 +33,33 @@ extern "C" {
 /* USER CODE END Includes */
 
 /* USER CODE BEGIN Private defines */
+#define MEMORYMAP_ITCM_SIZE      (64UL * 1024UL)
+#define MEMORYMAP_DTCM_SIZE      (128UL * 1024UL)
 
+/* MemoryMap_SelfCheck failures, OR-ed */
+#define MEMORYMAP_ERROR_MPU      (1UL << 0) // MPU disabled
+#define MEMORYMAP_ERROR_CACHE    (1UL << 1) // I-cache or D-cache disabled
+#define MEMORYMAP_ERROR_ITCM     (1UL << 2) // ITCM code differs from its flash image or is misplaced
+#define MEMORYMAP_ERROR_DTCM     (1UL << 3) // stack or DTCM data outside DTCM
+#define MEMORYMAP_ERROR_DMA      (1UL << 4) // ".dma_buffer" not covered by a non-cacheable region
+#define MEMORYMAP_ERROR_SHARED   (1UL << 5) // ".shared" or ".ipc" not covered by a non-cacheable region
+
+#define MEMORYMAP_IN_ITCM(ADDR)  ((uint32_t)(ADDR) - D1_ITCMRAM_BASE < MEMORYMAP_ITCM_SIZE)
+#define MEMORYMAP_IN_DTCM(ADDR)  ((uint32_t)(ADDR) - D1_DTCMRAM_BASE < MEMORYMAP_DTCM_SIZE)
 /* USER CODE END Private defines */
 
 /* USER CODE BEGIN Prototypes */
+/**
+ * @brief Configures the MPU regions and enables the I-cache and the D-cache.
+ * @note Called first in main, before any DMA or the other core touches shared memory.
+ */
+void MemoryMap_Config(void);
 
+/**
+ * @brief Checks that the caches, the MPU and the linker placement agree with the policy.
+ * @return 0 if everything is in place, otherwise MEMORYMAP_ERROR_x bits.
+ */
+uint32_t MemoryMap_SelfCheck(void);
 /* USER CODE END Prototypes */
 
 #ifdef __cplusplus
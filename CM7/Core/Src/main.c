@@ -19,27 +19,45 @@
 /* Includes ------------------------------------------------------------------*/
 #include "main.h"
 #include "adc.h"
-#include "i2c.h"
+#include "dma.h"
 #include "memorymap.h"
 #include "tim.h"
-#include "usart.h"
 #include "gpio.h"
 
 /* Private includes ----------------------------------------------------------*/
 /* USER CODE BEGIN Includes */
-#include <string.h>
-#include <stdio.h>
-#include <stdlib.h>
 #include "lm35.h"
 #include "pwm.h"
 #include "pid.h"
-#include "i2c_lcd.h"
 #include "pot.h"
+#include "control.h"
+#include "scheduler.h"
+#include "jitter.h"
+#include "probe.h"
+#include "fmt.h"
+#include "mbox.h"
+#include "ipc.h"
+#include "hil.h"
+#include "clock.h"
+#include "utils.h"
 /* USER CODE END Includes */
 
 /* Private typedef -----------------------------------------------------------*/
 /* USER CODE BEGIN PTD */
-
+typedef enum {
+	TASK_CONTROL = 0,
+	TASK_MAILBOX
+} Task_IdTypeDef;
+
+typedef enum {
+	PROBE_POT = 0,
+	PROBE_LM35,
+	PROBE_PID,
+	PROBE_PWM,
+	PROBE_CONTROL,
+	PROBE_PUBLISH,
+	PROBE_COUNT
+} Probe_IdTypeDef;
 /* USER CODE END PTD */
 
 /* Private define ------------------------------------------------------------*/
@@ -49,6 +67,16 @@
 #define HSEM_ID_0 (0U) /* HW semaphore 0*/
 #endif
 
+#define LOOP_TICK_HZ      1000000U                     // TIM6 counter clock, prescaler follows the clock profile
+#define PWM_TICK_HZ       1000000U                     // TIM3 counter clock, 100 counts give 10 kHz PWM
+#define LOOP_SAMPLES      (LM35_DMA_BUFFER_LENGTH / 2U) // TIM6 updates per control period
+#define SAMPLE_HSEM_ID    5U                           // after the MBOX_HSEM_x semaphores, as in the CM4 image
+#define SAMPLE_RING_SIZE  16U                          // control periods the CM4 may lag behind
+
+#ifndef CLOCK_PROFILE
+#define CLOCK_PROFILE     CLK_PROFILE_NOMINAL          // boot profile, -DCLOCK_PROFILE=CLK_PROFILE_PERFORMANCE
+#endif
+
 /* USER CODE END PD */
 
 /* Private macro -------------------------------------------------------------*/
@@ -59,111 +87,285 @@
 /* Private variables ---------------------------------------------------------*/
 
 /* USER CODE BEGIN PV */
-LM35_Filter_HandleTypeDef hfilter1 = LM35_FILTER_INIT_HANDLE(0.1f);
-PWM_HandleTypeDef hpwm1 = PWM_INIT_HANDLE(&htim3, TIM_CHANNEL_1);
-PID_HandleTypeDef hpid1 = PID_INIT_HANDLE(60, 4, 8, 20, 100, 0);
-I2C_LCD_HandleTypeDef hi2c_lcd1 = I2C_LCD_INIT_HANDLE(&hi2c1, 0x27, 16, 2);
-uint8_t rx_buffer[256];
-uint8_t tx_buffer[256];
-int cnt = 1;
-int Edit = 0;
-float NewSetPoint = 0;
-float LM35_Temperature = 0;
-int PWM_Duty = 0;
+/* Control state in DTCM (DTCM_DATA): single-cycle access, never cached or evicted */
+LM35_Filter_HandleTypeDef hfilter1 DTCM_DATA = LM35_FILTER_INIT_HANDLE(0.5f);
+PWM_HandleTypeDef hpwm1 DTCM_DATA = PWM_INIT_HANDLE(&htim3, TIM_CHANNEL_1);
+PID_HandleTypeDef hpid1 DTCM_DATA = PID_INIT_HANDLE(60, 40, 0.8f, 20, 100, 0);
+MBOX_SharedTypeDef hmbox1 __attribute__((section(".shared"), aligned(32)));
+HIL_SharedTypeDef hil1 __attribute__((section(".shared.hil"), aligned(32)));
+MBOX_SnapshotTypeDef snapshot1 DTCM_DATA;
+IPC_RING_DEFINE(sample_ring, sizeof(MBOX_SnapshotTypeDef), SAMPLE_RING_SIZE);
+IPC_HandleTypeDef hipc1 = IPC_INIT_HANDLE(sample_ring, sizeof(MBOX_SnapshotTypeDef), SAMPLE_HSEM_ID);
+JITTER_HandleTypeDef hjitter1 DTCM_DATA = JITTER_INIT_HANDLE();
+PROBE_HandleTypeDef probes[PROBE_COUNT] DTCM_DATA = {
+	[PROBE_POT]     = PROBE_INIT_HANDLE("pot"),
+	[PROBE_LM35]    = PROBE_INIT_HANDLE("lm35"),
+	[PROBE_PID]     = PROBE_INIT_HANDLE("pid"),
+	[PROBE_PWM]     = PROBE_INIT_HANDLE("pwm"),
+	[PROBE_CONTROL] = PROBE_INIT_HANDLE("control"),
+	[PROBE_PUBLISH] = PROBE_INIT_HANDLE("publish")
+};
+CONTROL_HandleTypeDef hcontrol1 DTCM_DATA = {
+	.Adc = &hadc1,
+	.Filter = &hfilter1,
+	.Pid = &hpid1,
+	.Pwm = &hpwm1,
+	.ProbeLm35 = &probes[PROBE_LM35],
+	.ProbePid = &probes[PROBE_PID],
+	.ProbePwm = &probes[PROBE_PWM]
+};
+volatile uint32_t control_timestamp DTCM_DATA; // DWT cycles at the half-buffer event that released Control_Task
 /* USER CODE END PV */
 
 /* Private function prototypes -----------------------------------------------*/
 void SystemClock_Config(void);
 void PeriphCommonClock_Config(void);
 /* USER CODE BEGIN PFP */
-
+static void Control_Task(void);
+static void Mailbox_Task(void);
+static void Clock_Retime(void);
 /* USER CODE END PFP */
 
 /* Private user code ---------------------------------------------------------*/
 /* USER CODE BEGIN 0 */
-void HAL_GPIO_EXTI_Callback(uint16_t GPIO_Pin)
+/* The sample instants are fixed by TIM6 and the DMA, not by these tasks. Control_Task converts
+   one sample per period, the newest in the buffer when it runs, and may start late by one
+   Mailbox_Task run, which is bounded: one request per run, a clock profile switch adds the
+   PLL lock (under 0.1 ms). The sample it takes is newer than the half-buffer by that delay */
+SCHED_TaskTypeDef tasks[] DTCM_DATA = {
+	[TASK_CONTROL] = SCHED_TASK_INIT(Control_Task),
+	[TASK_MAILBOX] = SCHED_TASK_INIT(Mailbox_Task)
+};
+SCHED_HandleTypeDef hsched1 DTCM_DATA = SCHED_INIT_HANDLE(tasks);
+
+/* The control interrupt path runs from ITCM (ITCM_FUNC here, the HAL part by section name in the linker scripts) */
+ITCM_FUNC void HAL_ADC_ConvHalfCpltCallback(ADC_HandleTypeDef *hadc)
 {
-	if (GPIO_Pin == Button_Pin)
+	if (hadc == &hadc1)
 	{
-		if (Edit == 0)
-		{
-			Edit = 1;
-			HAL_GPIO_WritePin(LED1_GPIO_Port, LED1_Pin, GPIO_PIN_SET);
-		}
-		else
-		{
-			Edit = 0;
-			PID_SetReference(&hpid1, NewSetPoint);
-			HAL_GPIO_WritePin(LED1_GPIO_Port, LED1_Pin, GPIO_PIN_RESET);
-		}
+		control_timestamp = DWT_GET_CYCLES();
+		JITTER_Update(&hjitter1, control_timestamp);
+		SCHED_Release(&hsched1, TASK_CONTROL);
 	}
 }
-void HAL_UART_RxCpltCallback(UART_HandleTypeDef *huart)
+
+ITCM_FUNC void HAL_ADC_ConvCpltCallback(ADC_HandleTypeDef *hadc)
 {
-	if (huart == &huart3)
+	if (hadc == &hadc1)
 	{
-		float value = strtol((char*)&rx_buffer[1], 0, 10);
-		if (rx_buffer[0] == 's')
-		{
-			PID_SetReference(&hpid1, value/100);
-		}
-		else if (rx_buffer[0] == 'p')
-		{
-			PID_SetTunings(&hpid1, value/100, hpid1.Ki, hpid1.Kd);
-		}
-		else if (rx_buffer[0] == 'i')
-		{
-			PID_SetTunings(&hpid1, hpid1.Kp, value/100, hpid1.Kd);
-		}
-		else if (rx_buffer[0] == 'd')
+		control_timestamp = DWT_GET_CYCLES();
+		JITTER_Update(&hjitter1, control_timestamp);
+		SCHED_Release(&hsched1, TASK_CONTROL);
+	}
+}
+
+void HAL_HSEM_FreeCallback(uint32_t SemMask)
+{
+	if (SemMask & MBOX_SEM_MASK(MBOX_HSEM_REQUEST))
+	{
+		// The interrupt handler disables the notification, it has to be armed again
+		HAL_HSEM_ActivateNotification(MBOX_SEM_MASK(MBOX_HSEM_REQUEST));
+		SCHED_Release(&hsched1, TASK_MAILBOX);
+	}
+}
+
+static uint16_t Hil_GetReg(ADC_HandleTypeDef *hadc)
+{
+	// Readings of the CM4 plant emulator while it runs (HIL_MODE), the LM35 otherwise
+	return HIL_IsActive(&hil1) ? (uint16_t)hil1.AdcRaw : LM35_GetLatestReg(hadc);
+}
+
+static float Param_Get(uint8_t Id)
+{
+	float a, b, c;
+	PID_AntiWindupTypeDef mode;
+
+	switch (Id)
+	{
+	case MBOX_PARAM_PID_SP:     return PID_GetReference(&hpid1);
+	case MBOX_PARAM_PID_KP:     PID_GetTunings(&hpid1, &a, &b, &c); return a;
+	case MBOX_PARAM_PID_KI:     PID_GetTunings(&hpid1, &a, &b, &c); return b;
+	case MBOX_PARAM_PID_KD:     PID_GetTunings(&hpid1, &a, &b, &c); return c;
+	case MBOX_PARAM_PID_B:      PID_GetWeighting(&hpid1, &a, &b); return a;
+	case MBOX_PARAM_PID_C:      PID_GetWeighting(&hpid1, &a, &b); return b;
+	case MBOX_PARAM_PID_TF:     return PID_GetDerivativeFilter(&hpid1);
+	case MBOX_PARAM_PID_AW:     PID_GetAntiWindup(&hpid1, &mode, &a); return (float)mode;
+	case MBOX_PARAM_PID_KT:     PID_GetAntiWindup(&hpid1, &mode, &a); return a;
+	case MBOX_PARAM_PID_IMAX:   PID_GetLimits(&hpid1, &a, &b); return a;
+	case MBOX_PARAM_PID_IMIN:   PID_GetLimits(&hpid1, &a, &b); return b;
+	case MBOX_PARAM_LM35_ALPHA: return hfilter1.alpha;
+	case MBOX_PARAM_PWM_MIN:    return (float)hpwm1.Min;
+	case MBOX_PARAM_PWM_MAX:    return (float)hpwm1.Max;
+	case MBOX_PARAM_LOOP_MS:    return (float)((__HAL_TIM_GET_AUTORELOAD(&htim6) + 1U) * LOOP_SAMPLES / (LOOP_TICK_HZ / 1000U));
+	case MBOX_PARAM_CLK_PROFILE: return (float)CLK_GetProfile();
+	default:               return 0;
+	}
+}
+
+static uint8_t Param_Set(uint8_t Id, float Value)
+{
+	float a, b, c;
+	PID_AntiWindupTypeDef mode;
+
+	// Runs from a task, never concurrently with Control_Task, so the handles can be written directly;
+	// ranges were checked by the CM4 registry, only the limits that depend on each other are refused here
+	switch (Id)
+	{
+	case MBOX_PARAM_PID_SP: PID_SetReference(&hpid1, Value); break;
+	case MBOX_PARAM_PID_KP:
+	case MBOX_PARAM_PID_KI:
+	case MBOX_PARAM_PID_KD:
+		PID_GetTunings(&hpid1, &a, &b, &c);
+		PID_SetTunings(&hpid1, (Id == MBOX_PARAM_PID_KP) ? Value : a, (Id == MBOX_PARAM_PID_KI) ? Value : b,
+		               (Id == MBOX_PARAM_PID_KD) ? Value : c);
+		break;
+	case MBOX_PARAM_PID_B:
+	case MBOX_PARAM_PID_C:
+		PID_GetWeighting(&hpid1, &a, &b);
+		PID_SetWeighting(&hpid1, (Id == MBOX_PARAM_PID_B) ? Value : a, (Id == MBOX_PARAM_PID_C) ? Value : b);
+		break;
+	case MBOX_PARAM_PID_TF: PID_SetDerivativeFilter(&hpid1, Value); break;
+	case MBOX_PARAM_PID_AW:
+	case MBOX_PARAM_PID_KT:
+		PID_GetAntiWindup(&hpid1, &mode, &a);
+		PID_SetAntiWindup(&hpid1, (Id == MBOX_PARAM_PID_AW) ? (PID_AntiWindupTypeDef)Value : mode, (Id == MBOX_PARAM_PID_KT) ? Value : a);
+		break;
+	case MBOX_PARAM_PID_IMAX:
+	case MBOX_PARAM_PID_IMIN:
+		PID_GetLimits(&hpid1, &a, &b);
+		if (Id == MBOX_PARAM_PID_IMAX) a = Value;
+		else b = Value;
+		if (b > a) return 0;
+		PID_SetLimits(&hpid1, a, b);
+		break;
+	case MBOX_PARAM_LM35_ALPHA: hfilter1.alpha = Value; break;
+	case MBOX_PARAM_PWM_MIN: return PWM_SetLimits(&hpwm1, (int)Value, hpwm1.Max) == HAL_OK;
+	case MBOX_PARAM_PWM_MAX: return PWM_SetLimits(&hpwm1, hpwm1.Min, (int)Value) == HAL_OK;
+	case MBOX_PARAM_LOOP_MS:
+	{
+		uint32_t reload = (uint32_t)Value * (LOOP_TICK_HZ / 1000U) / LOOP_SAMPLES - 1U;
+		uint32_t Primask = __get_PRIMASK();
+		__disable_irq();
+		__HAL_TIM_SET_AUTORELOAD(&htim6, reload);
+		// Without preload a counter already past the new reload would run up to 0xFFFF first
+		if (__HAL_TIM_GET_COUNTER(&htim6) > reload) __HAL_TIM_SET_COUNTER(&htim6, 0);
+		JITTER_Reset(&hjitter1);
+		__set_PRIMASK(Primask);
+		break;
+	}
+	case MBOX_PARAM_CLK_PROFILE:
+	{
+		// The CM4 quiesced its bus traffic before asking and retimes its side after the reply
+		HAL_StatusTypeDef status = CLK_SetProfile((CLK_ProfileTypeDef)Value);
+		Clock_Retime();
+		return status == HAL_OK;
+	}
+	default: return 0;
+	}
+	return 1;
+}
+
+/**
+ * @brief Derives the timer prescalers from the active clock and drops the statistics that mix two clocks.
+ */
+static void Clock_Retime(void)
+{
+	if (CLK_SetTimerTick(&htim3, PWM_TICK_HZ) != HAL_OK || CLK_SetTimerTick(&htim6, LOOP_TICK_HZ) != HAL_OK)
+	{
+		Error_Handler();
+	}
+	// The cycle counter of the next step spans both clocks; a zero step keeps the integral
+	PID_ResetTime(&hpid1);
+	JITTER_Reset(&hjitter1);
+	for (int i = 0; i < PROBE_COUNT; i++) PROBE_Reset(&probes[i]);
+}
+
+static void Control_Task(void)
+{
+	PROBE_START(&probes[PROBE_CONTROL]);
+
+	PROBE_START(&probes[PROBE_POT]);
+	snapshot1.PotRaw = POT_GetReg(&hadc3);
+	PROBE_STOP(&probes[PROBE_POT]);
+
+	// The same step the host simulator runs, the stages timed by the lm35, pid and pwm probes
+	snapshot1.Duty = CONTROL_Step(&hcontrol1, control_timestamp, &snapshot1.AdcRaw, &snapshot1.Temperature);
+	PROBE_STOP(&probes[PROBE_CONTROL]);
+
+	// Display and commands run on the CM4 from the latest snapshot, telemetry from every sample
+	PROBE_START(&probes[PROBE_PUBLISH]);
+	snapshot1.Period++;
+	snapshot1.TimeMs = HAL_GetTick();
+	snapshot1.SetPoint = PID_GetReference(&hpid1);
+	PID_GetTerms(&hpid1, &snapshot1.P, &snapshot1.I, &snapshot1.D);
+	for (uint8_t id = 0; id < MBOX_PARAM_COUNT; id++) snapshot1.Params[id] = Param_Get(id);
+	MBOX_Publish(&hmbox1, &snapshot1);
+	IPC_Push(&hipc1, &snapshot1);
+	PROBE_STOP(&probes[PROBE_PUBLISH]);
+}
+
+static uint16_t Mailbox_Report(uint8_t Report)
+{
+	FMT_HandleTypeDef hfmt;
+	size_t length = 0;
+
+	if (Report == MBOX_REPORT_JITTER)
+	{
+		JITTER_StatsTypeDef stats;
+		JITTER_GetStats(&hjitter1, &stats); // the ADC interrupt keeps updating the handle
+
+		FMT_Init(&hfmt, hmbox1.Report, sizeof(hmbox1.Report));
+		FMT_String(&hfmt, "J: N: ");
+		FMT_UInt(&hfmt, stats.Count, 0, ' ');
+		FMT_String(&hfmt, ", MIN: ");
+		FMT_Float(&hfmt, DWT_CYCLES2US(stats.Min), 1, 0, ' ');
+		FMT_String(&hfmt, ", MAX: ");
+		FMT_Float(&hfmt, DWT_CYCLES2US(stats.Max), 1, 0, ' ');
+		FMT_String(&hfmt, ", MEAN: ");
+		FMT_Float(&hfmt, DWT_CYCLES2US(stats.Mean), 1, 0, ' ');
+		FMT_String(&hfmt, ", STD: ");
+		FMT_Float(&hfmt, DWT_CYCLES2US(stats.StdDev), 2, 0, ' ');
+		length = FMT_String(&hfmt, " [us]\n");
+	}
+	else
+	{
+		for (int i = 0; i < PROBE_COUNT; i++)
 		{
-			PID_SetTunings(&hpid1, hpid1.Kp, hpid1.Ki, value/100);
+			length += PROBE_Format(&probes[i], &hmbox1.Report[length], sizeof(hmbox1.Report) - length);
+			if (Report == MBOX_REPORT_PROBES_RESET) PROBE_Reset(&probes[i]);
 		}
-		HAL_UART_Receive_IT(&huart3, rx_buffer, 5);
 	}
+	return (uint16_t)length;
 }
 
-void HAL_TIM_PeriodElapsedCallback(TIM_HandleTypeDef *htim)
+static void Mailbox_Task(void)
 {
-	if (htim == &htim6)
+	MBOX_MessageTypeDef message;
+	uint32_t sequence;
+
+	if (!MBOX_GetRequest(&hmbox1, &message, &sequence)) return;
+
+	switch (message.Request)
 	{
-		char result[16];
-		NewSetPoint = (float)POT_GetReg(&hadc3)/1000;
-		LM35_Temperature = LM35_GetTemp(&hadc1, &hfilter1);
-		int u = (int)PID_Calculate(&hpid1, LM35_Temperature);
-		PWM_WriteDuty(&hpwm1, u);
-		PWM_Duty = PWM_ReadDuty(&hpwm1);
-
-		if (cnt%3 == 0)
+	case MBOX_REQUEST_SET:
+		if (message.Id >= MBOX_PARAM_COUNT)
 		{
-			cnt = 1;
-			sprintf(result, "TEMP: %.1f   ", LM35_Temperature);
-			I2C_LCD_SetCursor(&hi2c_lcd1, 0, 0);
-			I2C_LCD_WriteString(&hi2c_lcd1, result);
-			sprintf(result, "PWM:  %d%%   ", PWM_Duty);
-			I2C_LCD_SetCursor(&hi2c_lcd1, 0, 1);
-			I2C_LCD_WriteString(&hi2c_lcd1, result);
-			sprintf(result, "%.1f   ", hpid1.SetPoint);
-			I2C_LCD_SetCursor(&hi2c_lcd1, 12, 0);
-			I2C_LCD_WriteString(&hi2c_lcd1, result);
-			if (Edit == 1)
-			{
-				sprintf(result, "%.1f ", NewSetPoint);
-				I2C_LCD_SetCursor(&hi2c_lcd1, 12, 1);
-				I2C_LCD_WriteString(&hi2c_lcd1, result);
-			}
-			else
-			{
-				I2C_LCD_SetCursor(&hi2c_lcd1, 12, 1);
-				I2C_LCD_WriteString(&hi2c_lcd1, "    ");
-			}
+			message.Status = 0;
+			break;
 		}
-		else cnt++;
-
-		memset(tx_buffer, 0, sizeof(tx_buffer));
-		int tx_n = sprintf((char*)tx_buffer, "T: %.1f, PWM: %d, S: %.1f, P: %.3f, I: %.3f, D: %.3f   \n", LM35_Temperature, PWM_Duty, hpid1.SetPoint, hpid1.Kp, hpid1.Ki, hpid1.Kd);
-		HAL_UART_Transmit(&huart3, tx_buffer, tx_n, 100);
+		message.Status = Param_Set(message.Id, message.Value);
+		message.Value = Param_Get(message.Id);
+		snapshot1.Params[message.Id] = message.Value; // the next snapshot agrees with the reply
+		break;
+	case MBOX_REQUEST_REPORT:
+		message.Length = Mailbox_Report(message.Id);
+		message.Status = 1;
+		break;
+	default:
+		message.Status = 0;
+		break;
 	}
+	MBOX_Reply(&hmbox1, &message, sequence);
 }
 /* USER CODE END 0 */
 
@@ -182,6 +384,8 @@ int main(void)
 /* USER CODE END Boot_Mode_Sequence_0 */
 
 /* USER CODE BEGIN Boot_Mode_Sequence_1 */
+  /* MPU regions and caches before anything touches the DMA buffers or the shared memory */
+  MemoryMap_Config();
   /* Wait until CPU2 boots and enters in stop mode or timeout*/
   timeout = 0xFFFF;
   while((__HAL_RCC_GET_FLAG(RCC_FLAG_D2CKRDY) != RESET) && (timeout-- > 0));
@@ -209,6 +413,16 @@ int main(void)
 HSEM notification */
 /*HW semaphore Clock enable*/
 __HAL_RCC_HSEM_CLK_ENABLE();
+/* The mailbox and the sample ring are valid before the CM4 can look at them */
+MBOX_Init(&hmbox1);
+IPC_Init(&hipc1);
+/* SRAM4 keeps its content over a reset, only a running emulator marks itself active */
+hil1.Magic = 0;
+/* The CM4 starts in the boot profile, it reads its clocks back in HAL_Init */
+if (CLOCK_PROFILE != CLK_PROFILE_NOMINAL && CLK_SetProfile(CLOCK_PROFILE) != HAL_OK)
+{
+Error_Handler();
+}
 /*Take HSEM */
 HAL_HSEM_FastTake(HSEM_ID_0);
 /*Release HSEM in order to notify the CPU2(CM4)*/
@@ -223,23 +437,41 @@ Error_Handler();
 /* USER CODE END Boot_Mode_Sequence_2 */
 
   /* USER CODE BEGIN SysInit */
-
+  /* D2 SRAM3 holds the DMA buffers (.dma_buffer), SRAM1 and SRAM2 are the CM4 RAM */
+  __HAL_RCC_D2SRAM3_CLK_ENABLE();
+  /* Caches on, DMA and shared memory non-cacheable, hot code and data in the TCMs */
+  if (MemoryMap_SelfCheck() != 0 || !MEMORYMAP_IN_ITCM(PID_CalculateAt) || !MEMORYMAP_IN_DTCM(&hpid1))
+  {
+    Error_Handler();
+  }
   /* USER CODE END SysInit */
 
   /* Initialize all configured peripherals */
   MX_GPIO_Init();
-  MX_USART3_UART_Init();
+  MX_DMA_Init();
   MX_TIM6_Init();
   MX_ADC1_Init();
   MX_TIM3_Init();
-  MX_I2C1_Init();
   MX_ADC3_Init();
   /* USER CODE BEGIN 2 */
   //HAL_TIM_PWM_Start(&htim3, TIM_CHANNEL_1);
+  DWT_Init();
+  /* CubeMX prescalers assume 64 MHz, the boot profile may differ; the timers are
+     still stopped and no ADC is armed, so an update event loads them at once */
+  Clock_Retime();
+  HAL_TIM_GenerateEvent(&htim3, TIM_EVENTSOURCE_UPDATE);
+  HAL_TIM_GenerateEvent(&htim6, TIM_EVENTSOURCE_UPDATE);
   PWM_Init(&hpwm1);
-  I2C_LCD_Init(&hi2c_lcd1);
-  HAL_TIM_Base_Start_IT(&htim6);
-  HAL_UART_Receive_IT(&huart3, rx_buffer, 5);
+  PID_SetAntiWindup(&hpid1, PID_ANTIWINDUP_BACKCALC, 5.0f);
+  LM35_SetSource(Hil_GetReg);
+  if (LM35_Start(&hadc1) != HAL_OK || POT_Start(&hadc3) != HAL_OK)
+  {
+    Error_Handler();
+  }
+  /* CM4 requests (parameter writes, reports) arrive as HSEM notifications */
+  HAL_HSEM_ActivateNotification(MBOX_SEM_MASK(MBOX_HSEM_REQUEST));
+  /* TIM6 TRGO paces both ADCs, the ADC1 DMA events release the control task */
+  HAL_TIM_Base_Start(&htim6);
   /* USER CODE END 2 */
 
   /* Infinite loop */
@@ -249,6 +481,7 @@ Error_Handler();
     /* USER CODE END WHILE */
 
     /* USER CODE BEGIN 3 */
+	  SCHED_Dispatch(&hsched1);
   }
   /* USER CODE END 3 */
 }
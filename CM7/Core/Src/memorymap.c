@@ -21,9 +21,146 @@
 #include "memorymap.h"
 
 /* USER CODE BEGIN 0 */
+#include <string.h>
+#include "stm32h7xx_it.h"
 
+/*
+ * Memory placement policy of the CM7 image (linker scripts, startup, MPU):
+ *
+ *  ITCMRAM  64 KB   ITCM_FUNC code: the control interrupt path and the PID step
+ *  DTCMRAM  128 KB  DTCM_DATA control state, the stack and the heap
+ *  RAM_D1   512 KB  everything else, write-back cached
+ *  RAM_D2   32 KB   SRAM3, ".dma_buffer", non-cacheable (MPU region 1)
+ *  RAM_D3   64 KB   SRAM4, ".shared" and ".ipc", non-cacheable and shareable (MPU region 2)
+ *
+ * The TCMs are never cached and DMA1/DMA2 cannot reach them, so DMA targets
+ * belong in ".dma_buffer". Region 0 closes the unused external memory space
+ * against speculative reads.
+ */
+#define MEMORYMAP_SRAM3_BASE  0x30040000UL  // RAM_D2 in the linker scripts
+#define MEMORYMAP_SRAM4_BASE  D3_SRAM_BASE  // RAM_D3
+
+/* Linker script symbols */
+extern uint32_t _sitcm, _eitcm, _siitcm;
+extern uint32_t _sdtcm_data, _edtcm_data;
+extern uint32_t _sdma_buffer, _edma_buffer, _sshared, _eipc;
+
+static void MemoryMap_ConfigNonCacheable(uint8_t Number, uint32_t BaseAddress, uint8_t Size, uint8_t IsShareable)
+{
+  MPU_Region_InitTypeDef MPU_InitStruct = {0};
+
+  /* Normal memory, not cacheable (TEX 1, C 0, B 0), no code */
+  MPU_InitStruct.Enable = MPU_REGION_ENABLE;
+  MPU_InitStruct.Number = Number;
+  MPU_InitStruct.BaseAddress = BaseAddress;
+  MPU_InitStruct.Size = Size;
+  MPU_InitStruct.SubRegionDisable = 0x00;
+  MPU_InitStruct.TypeExtField = MPU_TEX_LEVEL1;
+  MPU_InitStruct.AccessPermission = MPU_REGION_FULL_ACCESS;
+  MPU_InitStruct.DisableExec = MPU_INSTRUCTION_ACCESS_DISABLE;
+  MPU_InitStruct.IsShareable = IsShareable;
+  MPU_InitStruct.IsCacheable = MPU_ACCESS_NOT_CACHEABLE;
+  MPU_InitStruct.IsBufferable = MPU_ACCESS_NOT_BUFFERABLE;
+  HAL_MPU_ConfigRegion(&MPU_InitStruct);
+}
+
+/**
+ * @brief Checks that [Start, End) lies in one enabled MPU region of non-cacheable normal memory.
+ */
+static uint8_t MemoryMap_IsNonCacheable(uint32_t Start, uint32_t End)
+{
+  uint32_t Regions = (MPU->TYPE & MPU_TYPE_DREGION_Msk) >> MPU_TYPE_DREGION_Pos;
+
+  if (End <= Start) return 1; /* empty section */
+
+  /* The highest enabled region that holds an address decides its attributes; subregions are
+     ignored, only the background region uses them and its attributes fail the check anyway */
+  for (int32_t n = (int32_t)Regions - 1; n >= 0; n--)
+  {
+    MPU->RNR = (uint32_t)n;
+    uint32_t Rasr = MPU->RASR;
+    uint32_t Base = MPU->RBAR & MPU_RBAR_ADDR_Msk;
+    uint64_t Size = 2ULL << ((Rasr & MPU_RASR_SIZE_Msk) >> MPU_RASR_SIZE_Pos);
+
+    if (!(Rasr & MPU_RASR_ENABLE_Msk) || (uint64_t)(Start - Base) >= Size) continue;
+    if ((uint64_t)(End - 1U - Base) >= Size) return 0;
+    return (Rasr & (MPU_RASR_TEX_Msk | MPU_RASR_C_Msk | MPU_RASR_B_Msk)) == (1UL << MPU_RASR_TEX_Pos);
+  }
+  return 0; /* default memory map: SRAM is write-back cacheable */
+}
 /* USER CODE END 0 */
 
 /* USER CODE BEGIN 1 */
+/**
+ * @brief Configures the MPU regions and enables the I-cache and the D-cache.
+ */
+void MemoryMap_Config(void)
+{
+  MPU_Region_InitTypeDef MPU_InitStruct = {0};
+
+  HAL_MPU_Disable();
+
+  /* Region 0: no access to 0x60000000..0xDFFFFFFF (FMC, QUADSPI), nothing is mapped there */
+  MPU_InitStruct.Enable = MPU_REGION_ENABLE;
+  MPU_InitStruct.Number = MPU_REGION_NUMBER0;
+  MPU_InitStruct.BaseAddress = 0x00000000;
+  MPU_InitStruct.Size = MPU_REGION_SIZE_4GB;
+  MPU_InitStruct.SubRegionDisable = 0x87;
+  MPU_InitStruct.TypeExtField = MPU_TEX_LEVEL0;
+  MPU_InitStruct.AccessPermission = MPU_REGION_NO_ACCESS;
+  MPU_InitStruct.DisableExec = MPU_INSTRUCTION_ACCESS_DISABLE;
+  MPU_InitStruct.IsShareable = MPU_ACCESS_SHAREABLE;
+  MPU_InitStruct.IsCacheable = MPU_ACCESS_NOT_CACHEABLE;
+  MPU_InitStruct.IsBufferable = MPU_ACCESS_NOT_BUFFERABLE;
+  HAL_MPU_ConfigRegion(&MPU_InitStruct);
+
+  /* Region 1: DMA buffers, the DMA always sees what the core wrote and vice versa */
+  MemoryMap_ConfigNonCacheable(MPU_REGION_NUMBER1, MEMORYMAP_SRAM3_BASE, MPU_REGION_SIZE_32KB, MPU_ACCESS_NOT_SHAREABLE);
+  /* Region 2: mailbox, HIL readings and inter-core rings, also written by the CM4 */
+  MemoryMap_ConfigNonCacheable(MPU_REGION_NUMBER2, MEMORYMAP_SRAM4_BASE, MPU_REGION_SIZE_64KB, MPU_ACCESS_SHAREABLE);
+
+  HAL_MPU_Enable(MPU_PRIVILEGED_DEFAULT);
+
+  SCB_EnableICache();
+  SCB_EnableDCache();
+}
+
+/**
+ * @brief Checks that the caches, the MPU and the linker placement agree with the policy.
+ * @return 0 if everything is in place, otherwise MEMORYMAP_ERROR_x bits.
+ */
+uint32_t MemoryMap_SelfCheck(void)
+{
+  uint32_t Errors = 0;
+  uint32_t ItcmSize = (uint32_t)&_eitcm - (uint32_t)&_sitcm;
+  uint32_t DtcmSize = (uint32_t)&_edtcm_data - (uint32_t)&_sdtcm_data;
+
+  if (!(MPU->CTRL & MPU_CTRL_ENABLE_Msk)) Errors |= MEMORYMAP_ERROR_MPU;
+  if ((SCB->CCR & (SCB_CCR_IC_Msk | SCB_CCR_DC_Msk)) != (SCB_CCR_IC_Msk | SCB_CCR_DC_Msk)) Errors |= MEMORYMAP_ERROR_CACHE;
+
+  /* Code in ITCM and still equal to the flash image: copied by the startup, not overwritten since */
+  if (ItcmSize > 0U && (!MEMORYMAP_IN_ITCM(&_sitcm) || !MEMORYMAP_IN_ITCM((uint32_t)&_eitcm - 1U)
+                        || memcmp(&_sitcm, &_siitcm, ItcmSize) != 0))
+  {
+    Errors |= MEMORYMAP_ERROR_ITCM;
+  }
+  /* Nothing at address 0, and the HAL interrupt path placed by section name actually got there
+     (the linker scripts also assert it, including the static ADC DMA callbacks) */
+  if ((uint32_t)&_sitcm == D1_ITCMRAM_BASE || !MEMORYMAP_IN_ITCM(DMA1_Stream0_IRQHandler)
+      || !MEMORYMAP_IN_ITCM(HAL_DMA_IRQHandler))
+  {
+    Errors |= MEMORYMAP_ERROR_ITCM;
+  }
+
+  if (!MEMORYMAP_IN_DTCM(__get_MSP())
+      || (DtcmSize > 0U && (!MEMORYMAP_IN_DTCM(&_sdtcm_data) || !MEMORYMAP_IN_DTCM((uint32_t)&_edtcm_data - 1U))))
+  {
+    Errors |= MEMORYMAP_ERROR_DTCM;
+  }
+
+  if (!MemoryMap_IsNonCacheable((uint32_t)&_sdma_buffer, (uint32_t)&_edma_buffer)) Errors |= MEMORYMAP_ERROR_DMA;
+  if (!MemoryMap_IsNonCacheable((uint32_t)&_sshared, (uint32_t)&_eipc)) Errors |= MEMORYMAP_ERROR_SHARED;
 
+  return Errors;
+}
 /* USER CODE END 1 */
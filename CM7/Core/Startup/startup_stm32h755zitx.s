@@ -95,6 +95,43 @@ LoopFillZerobss:
   cmp r2, r4
   bcc FillZerobss
 
+/* Copy the ITCM code from flash to ITCMRAM */
+  ldr r0, =_sitcm
+  ldr r1, =_eitcm
+  ldr r2, =_siitcm
+  movs r3, #0
+  b LoopCopyItcmInit
+
+CopyItcmInit:
+  ldr r4, [r2, r3]
+  str r4, [r0, r3]
+  adds r3, r3, #4
+
+LoopCopyItcmInit:
+  adds r4, r0, r3
+  cmp r4, r1
+  bcc CopyItcmInit
+
+/* Copy the DTCM data initializers from flash to DTCMRAM */
+  ldr r0, =_sdtcm_data
+  ldr r1, =_edtcm_data
+  ldr r2, =_sidtcm_data
+  movs r3, #0
+  b LoopCopyDtcmInit
+
+CopyDtcmInit:
+  ldr r4, [r2, r3]
+  str r4, [r0, r3]
+  adds r3, r3, #4
+
+LoopCopyDtcmInit:
+  adds r4, r0, r3
+  cmp r4, r1
+  bcc CopyDtcmInit
+/* The copied code is fetched only after the writes complete */
+  dsb
+  isb
+
 /* Call static constructors */
     bl __libc_init_array
 /* Call the application's entry point.*/
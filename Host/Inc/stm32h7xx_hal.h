@@ -0,0 +1,392 @@
+/**
+  ******************************************************************************
+  * @file     : stm32h7xx_hal.h
+  * @author   : MS    Mateusz.Stasiak@student.put.poznan.pl
+  * @version  : 1.0.0
+  * @date     : Oct 17, 2026
+  * @brief    : Minimal STM32H7 HAL stub for building CM7/Components on a PC.
+  *
+  *             Only the types, constants and calls used by the Components are
+  *             provided. Time advances only through HOST_Advance() and busy-wait
+  *             reads of SysTick, DWT and HAL_GetTick, so runs are deterministic.
+  *
+  ******************************************************************************
+  */
+
+#ifndef HOST_STM32H7XX_HAL_H_
+#define HOST_STM32H7XX_HAL_H_
+
+/* Public includes -----------------------------------------------------------*/
+#include <stdint.h>
+#include <stddef.h>
+
+/* Public typedef ------------------------------------------------------------*/
+typedef enum {
+	HAL_OK = 0x00U,
+	HAL_ERROR = 0x01U,
+	HAL_BUSY = 0x02U,
+	HAL_TIMEOUT = 0x03U
+} HAL_StatusTypeDef;
+
+typedef enum {
+	DISABLE = 0U,
+	ENABLE = !DISABLE
+} FunctionalState;
+
+/* Core peripherals read by the utility macros */
+typedef struct {
+	volatile uint32_t CTRL, LOAD, VAL, CALIB;
+} SysTick_Type;
+
+typedef struct {
+	volatile uint32_t CTRL, CYCCNT, LAR;
+} DWT_Type;
+
+typedef struct {
+	volatile uint32_t DEMCR;
+} CoreDebug_Type;
+
+/* DMA */
+typedef struct {
+	volatile uint32_t Counter; // NDTR, remaining transfers of the current cycle
+} DMA_HandleTypeDef;
+
+/* ADC */
+typedef struct {
+	uint32_t Ratio;
+	uint32_t RightBitShift;
+	uint32_t TriggeredMode;
+	uint32_t OversamplingStopReset;
+} ADC_OversamplingTypeDef;
+
+typedef struct {
+	FunctionalState OversamplingMode;
+	ADC_OversamplingTypeDef Oversampling;
+} ADC_InitTypeDef;
+
+typedef struct {
+	uint32_t Channel;
+	uint32_t Rank;
+	uint32_t SamplingTime;
+	uint32_t SingleDiff;
+	uint32_t OffsetNumber;
+	uint32_t Offset;
+	FunctionalState OffsetSignedSaturation;
+} ADC_ChannelConfTypeDef;
+
+typedef struct {
+	ADC_InitTypeDef Init;
+	DMA_HandleTypeDef *DMA_Handle;
+	uint32_t Channel, SamplingTime; // last applied channel configuration
+	uint32_t Value;                 // DR, last conversion result
+	uint16_t *DmaBuffer;            // circular DMA target set by HAL_ADC_Start_DMA
+	uint32_t DmaLength;
+	uint8_t Running;
+} ADC_HandleTypeDef;
+
+/* RCC, the clock tree as far as the clock profiles use it */
+typedef struct {
+	volatile uint32_t CR, CFGR, D1CFGR, D2CFGR, D3CFGR;
+} RCC_TypeDef;
+
+typedef struct {
+	uint32_t PLLState;
+	uint32_t PLLSource;
+	uint32_t PLLM, PLLN, PLLP, PLLQ, PLLR;
+	uint32_t PLLRGE;
+	uint32_t PLLVCOSEL;
+	uint32_t PLLFRACN;
+} RCC_PLLInitTypeDef;
+
+typedef struct {
+	uint32_t OscillatorType;
+	RCC_PLLInitTypeDef PLL;
+} RCC_OscInitTypeDef;
+
+typedef struct {
+	uint32_t ClockType;
+	uint32_t SYSCLKSource;
+	uint32_t SYSCLKDivider;
+	uint32_t AHBCLKDivider;
+	uint32_t APB3CLKDivider;
+	uint32_t APB1CLKDivider;
+	uint32_t APB2CLKDivider;
+	uint32_t APB4CLKDivider;
+} RCC_ClkInitTypeDef;
+
+/* TIM */
+typedef struct {
+	volatile uint32_t PSC;
+} TIM_TypeDef;
+
+typedef struct {
+	uint32_t Prescaler;
+} TIM_Base_InitTypeDef;
+
+typedef struct {
+	TIM_TypeDef *Instance;         // registers, only for the clock retiming
+	TIM_Base_InitTypeDef Init;
+	uint32_t ARR;
+	uint32_t CNT;
+	uint32_t CCR[4];
+	uint8_t Running;
+} TIM_HandleTypeDef;
+
+/* I2C */
+typedef struct {
+	uint32_t TxBytes;   // total bytes written, for bus load estimates
+	uint32_t TxTransfers;
+	uint8_t Busy;       // an IT transfer was started; the caller delivers its completion callback
+	uint8_t RxData;     // value returned by every received byte
+	uint8_t Receive;    // the IT transfer in progress is a read
+	uint8_t *pBuffPtr;  // buffer of the IT transfer in progress, for tests decoding the bus
+	uint16_t XferSize;
+} I2C_HandleTypeDef;
+
+/* UART */
+typedef enum {
+	HAL_UART_STATE_READY = 0x20U,
+	HAL_UART_STATE_BUSY_TX = 0x21U,
+	HAL_UART_STATE_BUSY_RX = 0x22U
+} HAL_UART_StateTypeDef;
+
+typedef struct {
+	volatile uint32_t CR1, BRR;
+} USART_TypeDef;
+
+typedef struct {
+	uint32_t BaudRate;
+	uint32_t OverSampling;
+	uint32_t ClockPrescaler;
+} UART_InitTypeDef;
+
+typedef struct {
+	USART_TypeDef *Instance;       // registers, only for SERIAL_Retime
+	UART_InitTypeDef Init;
+	uint32_t TxBytes;
+	uint8_t Echo;                  // copy transmitted bytes to stdout
+	HAL_UART_StateTypeDef gState;  // BUSY_TX while a DMA transfer runs; the caller delivers its completion
+	HAL_UART_StateTypeDef RxState; // BUSY_RX while the circular reception runs
+	uint8_t *RxBuffer;             // reception target; the caller writes it and delivers the events
+	uint16_t RxSize;
+} UART_HandleTypeDef;
+
+/* Public define -------------------------------------------------------------*/
+#define HOST_CORE_CLOCK                     64000000U
+
+#define CoreDebug_DEMCR_TRCENA_Msk          (1UL << 24)
+#define DWT_CTRL_CYCCNTENA_Msk              (1UL << 0)
+
+#define ADC_CFGR2_OVSS_Pos                  (5U)
+#define ADC_RIGHTBITSHIFT_NONE              (0UL << ADC_CFGR2_OVSS_Pos)
+#define ADC_RIGHTBITSHIFT_1                 (1UL << ADC_CFGR2_OVSS_Pos)
+#define ADC_RIGHTBITSHIFT_2                 (2UL << ADC_CFGR2_OVSS_Pos)
+#define ADC_RIGHTBITSHIFT_3                 (3UL << ADC_CFGR2_OVSS_Pos)
+#define ADC_RIGHTBITSHIFT_4                 (4UL << ADC_CFGR2_OVSS_Pos)
+#define ADC_RIGHTBITSHIFT_5                 (5UL << ADC_CFGR2_OVSS_Pos)
+#define ADC_RIGHTBITSHIFT_6                 (6UL << ADC_CFGR2_OVSS_Pos)
+#define ADC_RIGHTBITSHIFT_7                 (7UL << ADC_CFGR2_OVSS_Pos)
+#define ADC_RIGHTBITSHIFT_8                 (8UL << ADC_CFGR2_OVSS_Pos)
+#define ADC_TRIGGEREDMODE_SINGLE_TRIGGER    (0x0UL)
+#define ADC_TRIGGEREDMODE_MULTI_TRIGGER     (0x1UL)
+#define ADC_REGOVERSAMPLING_CONTINUED_MODE  (0x0UL)
+#define ADC_REGULAR_RANK_1                  (0x1UL)
+#define ADC_SINGLE_ENDED                    (0x0UL)
+#define ADC_OFFSET_NONE                     (0x4UL)
+#define ADC_CHANNEL_0                       (0x0UL)
+#define ADC_CHANNEL_2                       (0x2UL)
+#define ADC_SAMPLETIME_1CYCLE_5             (0x0UL)
+#define ADC_SAMPLETIME_64CYCLES_5           (0x4UL)
+#define ADC_SAMPLETIME_387CYCLES_5          (0x6UL)
+
+#define HOST_HSI_CLOCK                      64000000U
+
+#define RCC_CR_PLL1RDY                      (1UL << 25)
+#define RCC_CFGR_SW                         (0x7UL)
+#define RCC_CFGR_SWS                        (0x38UL)
+#define RCC_CFGR_SWS_Pos                    (3U)
+#define RCC_CFGR_TIMPRE                     (1UL << 15)
+#define RCC_D1CFGR_HPRE                     (0xFUL)
+#define RCC_D1CFGR_D1PPRE                   (0x70UL)
+#define RCC_D1CFGR_D1CPRE                   (0xF00UL)
+#define RCC_D1CFGR_D1CPRE_Pos               (8U)
+#define RCC_D2CFGR_D2PPRE1                  (0x70UL)
+#define RCC_D2CFGR_D2PPRE1_Pos              (4U)
+#define RCC_D2CFGR_D2PPRE2                  (0x700UL)
+#define RCC_D2CFGR_D2PPRE2_Pos              (8U)
+#define RCC_D3CFGR_D3PPRE                   (0x70UL)
+
+#define RCC_CLOCKTYPE_SYSCLK                (0x01UL)
+#define RCC_CLOCKTYPE_HCLK                  (0x02UL)
+#define RCC_CLOCKTYPE_D1PCLK1               (0x04UL)
+#define RCC_CLOCKTYPE_PCLK1                 (0x08UL)
+#define RCC_CLOCKTYPE_PCLK2                 (0x10UL)
+#define RCC_CLOCKTYPE_D3PCLK1               (0x20UL)
+#define RCC_SYSCLKSOURCE_HSI                (0x0UL)
+#define RCC_SYSCLKSOURCE_PLLCLK             (0x3UL)
+#define RCC_SYSCLKSOURCE_STATUS_HSI         (0x0UL)
+#define RCC_SYSCLKSOURCE_STATUS_PLLCLK      (0x18UL)
+#define RCC_SYSCLK_DIV1                     (0x000UL)
+#define RCC_SYSCLK_DIV2                     (0x800UL)
+#define RCC_SYSCLK_DIV4                     (0x900UL)
+#define RCC_HCLK_DIV1                       (0x0UL)
+#define RCC_HCLK_DIV2                       (0x8UL)
+#define RCC_APB3_DIV1                       (0x00UL)
+#define RCC_APB3_DIV2                       (0x40UL)
+#define RCC_APB1_DIV1                       (0x00UL)
+#define RCC_APB1_DIV2                       (0x40UL)
+#define RCC_APB1_DIV4                       (0x50UL)
+#define RCC_APB1_DIV8                       (0x60UL)
+#define RCC_APB1_DIV16                      (0x70UL)
+#define RCC_APB2_DIV1                       (0x000UL)
+#define RCC_APB2_DIV2                       (0x400UL)
+#define RCC_APB2_DIV4                       (0x500UL)
+#define RCC_APB2_DIV8                       (0x600UL)
+#define RCC_APB2_DIV16                      (0x700UL)
+#define RCC_APB4_DIV1                       (0x00UL)
+#define RCC_APB4_DIV2                       (0x40UL)
+#define RCC_OSCILLATORTYPE_NONE             (0x0UL)
+#define RCC_PLL_NONE                        (0x0UL)
+#define RCC_PLL_OFF                         (0x1UL)
+#define RCC_PLL_ON                          (0x2UL)
+#define RCC_PLLSOURCE_HSI                   (0x0UL)
+#define RCC_PLL1VCIRANGE_3                  (0xCUL)
+#define RCC_PLL1VCOWIDE                     (0x0UL)
+
+#define FLASH_LATENCY_0                     (0x0UL)
+#define FLASH_LATENCY_1                     (0x1UL)
+#define FLASH_LATENCY_2                     (0x2UL)
+
+#define PWR_REGULATOR_VOLTAGE_SCALE1        (0xC000UL)
+#define PWR_REGULATOR_VOLTAGE_SCALE3        (0x4000UL)
+#define PWR_FLAG_VOSRDY                     (0x2000UL)
+
+#define TIM_CHANNEL_1                       (0x0U)
+#define TIM_CHANNEL_2                       (0x4U)
+#define TIM_CHANNEL_3                       (0x8U)
+#define TIM_CHANNEL_4                       (0xCU)
+#define TIM_FLAG_UPDATE                     (0x1U)
+
+#define I2C_TIMINGR_SCLL_Pos                (0U)
+#define I2C_TIMINGR_SCLH_Pos                (8U)
+#define I2C_TIMINGR_SDADEL_Pos              (16U)
+#define I2C_TIMINGR_SCLDEL_Pos              (20U)
+#define I2C_TIMINGR_PRESC_Pos               (28U)
+
+#define USART_CR1_UE                        (1UL << 0)
+#define UART_OVERSAMPLING_16                (0x0UL)
+#define UART_OVERSAMPLING_8                 (0x8000UL)
+#define UART_PRESCALER_DIV1                 (0x0UL)
+
+#define __weak                              __attribute__((weak))
+
+/* Public macro --------------------------------------------------------------*/
+#define SysTick    (HOST_SysTick())
+#define DWT        (HOST_DWT())
+#define CoreDebug  (&HOST_CoreDebug)
+#define RCC        (&HOST_Rcc)
+#define TIM1       (&HOST_Tim[1])
+#define TIM3       (&HOST_Tim[3])
+#define TIM6       (&HOST_Tim[6])
+#define TIM7       (&HOST_Tim[7])
+#define TIM8       (&HOST_Tim[8])
+#define TIM15      (&HOST_Tim[15])
+#define TIM16      (&HOST_Tim[16])
+#define TIM17      (&HOST_Tim[17])
+
+#define __HAL_RCC_GET_SYSCLK_SOURCE()                       (RCC->CFGR & RCC_CFGR_SWS)
+#define __HAL_PWR_VOLTAGESCALING_CONFIG(__REGULATOR__)      (HOST_VoltageScale = (__REGULATOR__))
+#define __HAL_PWR_GET_FLAG(__FLAG__)                        ((void)(__FLAG__), 1U)
+
+#define __HAL_DMA_GET_COUNTER(__HANDLE__)                   ((__HANDLE__)->Counter)
+#define __HAL_TIM_GET_AUTORELOAD(__HANDLE__)                ((__HANDLE__)->ARR)
+#define __HAL_TIM_SET_AUTORELOAD(__HANDLE__, __ARR__)       ((__HANDLE__)->ARR = (__ARR__))
+#define __HAL_TIM_SET_PRESCALER(__HANDLE__, __PSC__)       ((__HANDLE__)->Instance->PSC = (__PSC__))
+#define __HAL_TIM_SET_COUNTER(__HANDLE__, __CNT__)          ((__HANDLE__)->CNT = (__CNT__))
+#define __HAL_TIM_CLEAR_FLAG(__HANDLE__, __FLAG__)          ((void)(__HANDLE__), (void)(__FLAG__))
+#define __HAL_TIM_SET_COMPARE(__HANDLE__, __CH__, __CMP__)  ((__HANDLE__)->CCR[(__CH__) >> 2] = (__CMP__))
+#define __HAL_TIM_GET_COMPARE(__HANDLE__, __CH__)           ((__HANDLE__)->CCR[(__CH__) >> 2])
+#define __HAL_UART_ENABLE(__HANDLE__)                       ((__HANDLE__)->Instance->CR1 |= USART_CR1_UE)
+#define __HAL_UART_DISABLE(__HANDLE__)                      ((__HANDLE__)->Instance->CR1 &= ~USART_CR1_UE)
+#define UART_DIV_SAMPLING16(__PCLK__, __BAUD__, __PRESC__)  ((void)(__PRESC__), ((__PCLK__) + ((__BAUD__) / 2U)) / (__BAUD__))
+
+/* No interrupts on the host, the core intrinsics only keep the call sites */
+static inline uint32_t __get_PRIMASK(void) { return 0U; }
+static inline void __set_PRIMASK(uint32_t priMask) { (void)priMask; }
+static inline void __disable_irq(void) { }
+static inline void __DMB(void) { __sync_synchronize(); }
+static inline void __DSB(void) { __sync_synchronize(); }
+
+/* Public variables ----------------------------------------------------------*/
+extern uint32_t SystemCoreClock;
+extern CoreDebug_Type HOST_CoreDebug;
+extern RCC_TypeDef HOST_Rcc;             // reset state: the nominal profile (HSI, APB1 / 2)
+extern TIM_TypeDef HOST_Tim[18];
+extern uint32_t HOST_VoltageScale;
+extern uint32_t HOST_FlashLatency;
+
+/* Public function prototypes ------------------------------------------------*/
+/**
+ * @brief Advances the simulated time base.
+ * @param Cycles Number of core clock cycles to advance.
+ */
+void HOST_Advance(uint64_t Cycles);
+
+/**
+ * @brief Returns the simulated time in core clock cycles since start.
+ */
+uint64_t HOST_GetCycles(void);
+
+/**
+ * @brief Returns the SysTick register view; every access costs a few simulated cycles.
+ */
+SysTick_Type* HOST_SysTick(void);
+
+/**
+ * @brief Returns the DWT register view with CYCCNT synchronised to simulated time.
+ */
+DWT_Type* HOST_DWT(void);
+
+/**
+ * @brief Stores a new conversion result, as if a triggered conversion finished.
+ * @param hadc Pointer to the ADC_HandleTypeDef structure.
+ * @param Value The 16-bit conversion result.
+ * @note When DMA is running the result is also written to the circular buffer.
+ */
+void HOST_ADC_Convert(ADC_HandleTypeDef *hadc, uint16_t Value);
+
+uint32_t HAL_GetTick(void);
+
+HAL_StatusTypeDef HAL_RCC_OscConfig(RCC_OscInitTypeDef *RCC_OscInitStruct);
+HAL_StatusTypeDef HAL_RCC_ClockConfig(RCC_ClkInitTypeDef *RCC_ClkInitStruct, uint32_t FLatency);
+uint32_t HAL_RCC_GetSysClockFreq(void);
+uint32_t HAL_RCC_GetHCLKFreq(void);
+uint32_t HAL_RCC_GetPCLK1Freq(void);
+uint32_t HAL_RCC_GetPCLK2Freq(void);
+
+HAL_StatusTypeDef HAL_ADC_Init(ADC_HandleTypeDef *hadc);
+HAL_StatusTypeDef HAL_ADC_ConfigChannel(ADC_HandleTypeDef *hadc, ADC_ChannelConfTypeDef *sConfig);
+HAL_StatusTypeDef HAL_ADC_Start(ADC_HandleTypeDef *hadc);
+HAL_StatusTypeDef HAL_ADC_Stop(ADC_HandleTypeDef *hadc);
+HAL_StatusTypeDef HAL_ADC_Start_DMA(ADC_HandleTypeDef *hadc, uint32_t *pData, uint32_t Length);
+HAL_StatusTypeDef HAL_ADC_Stop_DMA(ADC_HandleTypeDef *hadc);
+HAL_StatusTypeDef HAL_ADC_PollForConversion(ADC_HandleTypeDef *hadc, uint32_t Timeout);
+uint32_t HAL_ADC_GetValue(ADC_HandleTypeDef *hadc);
+
+HAL_StatusTypeDef HAL_TIM_Base_Start(TIM_HandleTypeDef *htim);
+HAL_StatusTypeDef HAL_TIM_Base_Start_IT(TIM_HandleTypeDef *htim);
+HAL_StatusTypeDef HAL_TIM_Base_Stop_IT(TIM_HandleTypeDef *htim);
+HAL_StatusTypeDef HAL_TIM_PWM_Start(TIM_HandleTypeDef *htim, uint32_t Channel);
+
+HAL_StatusTypeDef HAL_I2C_Master_Transmit(I2C_HandleTypeDef *hi2c, uint16_t DevAddress, uint8_t *pData, uint16_t Size, uint32_t Timeout);
+HAL_StatusTypeDef HAL_I2C_Master_Transmit_IT(I2C_HandleTypeDef *hi2c, uint16_t DevAddress, uint8_t *pData, uint16_t Size);
+HAL_StatusTypeDef HAL_I2C_Master_Receive_IT(I2C_HandleTypeDef *hi2c, uint16_t DevAddress, uint8_t *pData, uint16_t Size);
+
+HAL_StatusTypeDef HAL_UART_Transmit(UART_HandleTypeDef *huart, const uint8_t *pData, uint16_t Size, uint32_t Timeout);
+HAL_StatusTypeDef HAL_UART_Transmit_DMA(UART_HandleTypeDef *huart, const uint8_t *pData, uint16_t Size);
+HAL_StatusTypeDef HAL_UARTEx_ReceiveToIdle_DMA(UART_HandleTypeDef *huart, uint8_t *pData, uint16_t Size);
+
+HAL_StatusTypeDef HAL_HSEM_FastTake(uint32_t SemID);
+void HAL_HSEM_Release(uint32_t SemID, uint32_t ProcessID);
+
+#endif /* HOST_STM32H7XX_HAL_H_ */
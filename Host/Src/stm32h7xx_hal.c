@@ -0,0 +1,378 @@
+/**
+  ******************************************************************************
+  * @file     : stm32h7xx_hal.c
+  * @author   : MS    Mateusz.Stasiak@student.put.poznan.pl
+  * @version  : 1.0.0
+  * @date     : Oct 17, 2026
+  * @brief    : Minimal STM32H7 HAL stub for building CM7/Components on a PC.
+  *
+  ******************************************************************************
+  */
+
+/* Private includes ----------------------------------------------------------*/
+#include <stdio.h>
+#include "stm32h7xx_hal.h"
+
+/* Private typedef -----------------------------------------------------------*/
+
+/* Private define ------------------------------------------------------------*/
+#define HOST_REG_ACCESS_CYCLES  4U       // cost of one polled register read
+#define HOST_I2C_BAUD           100000U  // [bit/s], standard mode as on the board
+#define HOST_UART_BAUD          115200U  // [bit/s]
+#define HOST_HSEM_COUNT         32U
+#define HOST_PLL_REF_MIN_HZ     1000000U   // PLL1 input after DIVM1
+#define HOST_PLL_REF_MAX_HZ     16000000U
+#define HOST_VCO_MIN_HZ         192000000U // wide VCO range
+#define HOST_VCO_MAX_HZ         836000000U
+
+/* Private macro -------------------------------------------------------------*/
+
+/* Private variables ---------------------------------------------------------*/
+static uint64_t HOST_Cycles;
+static SysTick_Type HOST_SysTickRegs;
+static DWT_Type HOST_DWTRegs;
+static uint8_t HOST_HsemTaken[HOST_HSEM_COUNT];
+static uint32_t HOST_Pll1PHz;
+
+/* Public variables ----------------------------------------------------------*/
+uint32_t SystemCoreClock = HOST_CORE_CLOCK;
+CoreDebug_Type HOST_CoreDebug;
+RCC_TypeDef HOST_Rcc = { .D2CFGR = RCC_APB1_DIV2 };
+TIM_TypeDef HOST_Tim[18];
+uint32_t HOST_VoltageScale = PWR_REGULATOR_VOLTAGE_SCALE3;
+uint32_t HOST_FlashLatency = FLASH_LATENCY_1;
+
+/* Private function prototypes -----------------------------------------------*/
+
+/* Public function prototypes ------------------------------------------------*/
+
+/* Private functions ---------------------------------------------------------*/
+static void HOST_AdvanceBits(uint32_t Bits, uint32_t Baud)
+{
+	HOST_Advance((uint64_t)Bits * SystemCoreClock / Baud);
+}
+
+/**
+ * @brief Decodes a 4-bit AHB/CPU (HPRE, D1CPRE) or 3-bit APB (DxPPRE) prescaler field.
+ */
+static uint32_t HOST_AhbDivider(uint32_t Field)
+{
+	static const uint8_t Shift[8] = { 1, 2, 3, 4, 6, 7, 8, 9 };
+	return (Field < 8U) ? 1U : (1UL << Shift[Field - 8U]);
+}
+
+static uint32_t HOST_ApbDivider(uint32_t Field)
+{
+	return (Field < 4U) ? 1U : (1UL << (Field - 3U));
+}
+
+/* Public functions ----------------------------------------------------------*/
+/**
+ * @brief Advances the simulated time base.
+ * @param Cycles Number of core clock cycles to advance.
+ */
+void HOST_Advance(uint64_t Cycles)
+{
+	HOST_Cycles += Cycles;
+}
+
+/**
+ * @brief Returns the simulated time in core clock cycles since start.
+ */
+uint64_t HOST_GetCycles(void)
+{
+	return HOST_Cycles;
+}
+
+/**
+ * @brief Returns the SysTick register view; every access costs a few simulated cycles.
+ * @note Lets the DELAY_US/DELAY_MS busy-waits from utils.h terminate on the host.
+ */
+SysTick_Type* HOST_SysTick(void)
+{
+	uint32_t load = SystemCoreClock / 1000U - 1U;
+
+	HOST_Advance(HOST_REG_ACCESS_CYCLES);
+	HOST_SysTickRegs.LOAD = load;
+	HOST_SysTickRegs.VAL = load - (uint32_t)(HOST_Cycles % (load + 1U));
+	return &HOST_SysTickRegs;
+}
+
+/**
+ * @brief Returns the DWT register view with CYCCNT synchronised to simulated time.
+ */
+DWT_Type* HOST_DWT(void)
+{
+	HOST_DWTRegs.CYCCNT = (uint32_t)HOST_Cycles;
+	return &HOST_DWTRegs;
+}
+
+uint32_t HAL_GetTick(void)
+{
+	HOST_Advance(HOST_REG_ACCESS_CYCLES);
+	return (uint32_t)(HOST_Cycles / (SystemCoreClock / 1000U));
+}
+
+/**
+ * @note Only PLL1 from the HSI; like the HAL, refuses to touch the PLL the system runs from.
+ */
+HAL_StatusTypeDef HAL_RCC_OscConfig(RCC_OscInitTypeDef *RCC_OscInitStruct)
+{
+	RCC_PLLInitTypeDef *Pll = &RCC_OscInitStruct->PLL;
+
+	if (Pll->PLLState == RCC_PLL_NONE) return HAL_OK;
+	if (__HAL_RCC_GET_SYSCLK_SOURCE() == RCC_SYSCLKSOURCE_STATUS_PLLCLK) return HAL_ERROR;
+
+	HOST_Rcc.CR &= ~RCC_CR_PLL1RDY;
+	HOST_Pll1PHz = 0;
+	if (Pll->PLLState == RCC_PLL_OFF) return HAL_OK;
+
+	if (Pll->PLLSource != RCC_PLLSOURCE_HSI || Pll->PLLM == 0U || Pll->PLLP == 0U) return HAL_ERROR;
+	uint32_t Ref = HOST_HSI_CLOCK / Pll->PLLM;
+	uint64_t Vco = (uint64_t)Ref * Pll->PLLN;
+	if (Ref < HOST_PLL_REF_MIN_HZ || Ref > HOST_PLL_REF_MAX_HZ || Vco < HOST_VCO_MIN_HZ || Vco > HOST_VCO_MAX_HZ)
+	{
+		return HAL_ERROR;
+	}
+	HOST_Pll1PHz = (uint32_t)(Vco / Pll->PLLP);
+	HOST_Rcc.CR |= RCC_CR_PLL1RDY;
+	return HAL_OK;
+}
+
+/**
+ * @note Writes the selected prescalers and the source, then updates SystemCoreClock (CM7 view).
+ */
+HAL_StatusTypeDef HAL_RCC_ClockConfig(RCC_ClkInitTypeDef *RCC_ClkInitStruct, uint32_t FLatency)
+{
+	RCC_ClkInitTypeDef *Clk = RCC_ClkInitStruct;
+
+	if (Clk->ClockType & RCC_CLOCKTYPE_SYSCLK)
+	{
+		if (Clk->SYSCLKSource == RCC_SYSCLKSOURCE_PLLCLK && !(HOST_Rcc.CR & RCC_CR_PLL1RDY)) return HAL_ERROR;
+		HOST_Rcc.D1CFGR = (HOST_Rcc.D1CFGR & ~RCC_D1CFGR_D1CPRE) | Clk->SYSCLKDivider;
+		HOST_Rcc.CFGR = (HOST_Rcc.CFGR & ~(RCC_CFGR_SW | RCC_CFGR_SWS))
+		              | Clk->SYSCLKSource | (Clk->SYSCLKSource << RCC_CFGR_SWS_Pos);
+	}
+	if (Clk->ClockType & RCC_CLOCKTYPE_HCLK) HOST_Rcc.D1CFGR = (HOST_Rcc.D1CFGR & ~RCC_D1CFGR_HPRE) | Clk->AHBCLKDivider;
+	if (Clk->ClockType & RCC_CLOCKTYPE_D1PCLK1) HOST_Rcc.D1CFGR = (HOST_Rcc.D1CFGR & ~RCC_D1CFGR_D1PPRE) | Clk->APB3CLKDivider;
+	if (Clk->ClockType & RCC_CLOCKTYPE_PCLK1) HOST_Rcc.D2CFGR = (HOST_Rcc.D2CFGR & ~RCC_D2CFGR_D2PPRE1) | Clk->APB1CLKDivider;
+	if (Clk->ClockType & RCC_CLOCKTYPE_PCLK2) HOST_Rcc.D2CFGR = (HOST_Rcc.D2CFGR & ~RCC_D2CFGR_D2PPRE2) | Clk->APB2CLKDivider;
+	if (Clk->ClockType & RCC_CLOCKTYPE_D3PCLK1) HOST_Rcc.D3CFGR = (HOST_Rcc.D3CFGR & ~RCC_D3CFGR_D3PPRE) | Clk->APB4CLKDivider;
+
+	HOST_FlashLatency = FLatency;
+	SystemCoreClock = HAL_RCC_GetSysClockFreq() / HOST_AhbDivider((HOST_Rcc.D1CFGR & RCC_D1CFGR_D1CPRE) >> RCC_D1CFGR_D1CPRE_Pos);
+	return HAL_OK;
+}
+
+uint32_t HAL_RCC_GetSysClockFreq(void)
+{
+	return (__HAL_RCC_GET_SYSCLK_SOURCE() == RCC_SYSCLKSOURCE_STATUS_PLLCLK) ? HOST_Pll1PHz : HOST_HSI_CLOCK;
+}
+
+uint32_t HAL_RCC_GetHCLKFreq(void)
+{
+	return HAL_RCC_GetSysClockFreq() / HOST_AhbDivider((HOST_Rcc.D1CFGR & RCC_D1CFGR_D1CPRE) >> RCC_D1CFGR_D1CPRE_Pos)
+	                                 / HOST_AhbDivider(HOST_Rcc.D1CFGR & RCC_D1CFGR_HPRE);
+}
+
+uint32_t HAL_RCC_GetPCLK1Freq(void)
+{
+	return HAL_RCC_GetHCLKFreq() / HOST_ApbDivider((HOST_Rcc.D2CFGR & RCC_D2CFGR_D2PPRE1) >> RCC_D2CFGR_D2PPRE1_Pos);
+}
+
+uint32_t HAL_RCC_GetPCLK2Freq(void)
+{
+	return HAL_RCC_GetHCLKFreq() / HOST_ApbDivider((HOST_Rcc.D2CFGR & RCC_D2CFGR_D2PPRE2) >> RCC_D2CFGR_D2PPRE2_Pos);
+}
+
+/**
+ * @brief Stores a new conversion result, as if a triggered conversion finished.
+ * @param hadc Pointer to the ADC_HandleTypeDef structure.
+ * @param Value The 16-bit conversion result.
+ * @note When DMA is running the result is also written to the circular buffer.
+ */
+void HOST_ADC_Convert(ADC_HandleTypeDef *hadc, uint16_t Value)
+{
+	if (!hadc->Running) return;
+
+	hadc->Value = Value;
+	if (hadc->DmaBuffer != NULL && hadc->DMA_Handle != NULL)
+	{
+		uint32_t idx = hadc->DmaLength - hadc->DMA_Handle->Counter;
+		hadc->DmaBuffer[idx] = Value;
+		hadc->DMA_Handle->Counter = (hadc->DMA_Handle->Counter > 1U) ? hadc->DMA_Handle->Counter - 1U : hadc->DmaLength;
+	}
+}
+
+HAL_StatusTypeDef HAL_ADC_Init(ADC_HandleTypeDef *hadc)
+{
+	return hadc->Running ? HAL_ERROR : HAL_OK;
+}
+
+HAL_StatusTypeDef HAL_ADC_ConfigChannel(ADC_HandleTypeDef *hadc, ADC_ChannelConfTypeDef *sConfig)
+{
+	if (hadc->Running) return HAL_ERROR;
+	hadc->Channel = sConfig->Channel;
+	hadc->SamplingTime = sConfig->SamplingTime;
+	return HAL_OK;
+}
+
+HAL_StatusTypeDef HAL_ADC_Start(ADC_HandleTypeDef *hadc)
+{
+	hadc->Running = 1;
+	return HAL_OK;
+}
+
+HAL_StatusTypeDef HAL_ADC_Stop(ADC_HandleTypeDef *hadc)
+{
+	hadc->Running = 0;
+	return HAL_OK;
+}
+
+HAL_StatusTypeDef HAL_ADC_Start_DMA(ADC_HandleTypeDef *hadc, uint32_t *pData, uint32_t Length)
+{
+	if (hadc->DMA_Handle == NULL || Length == 0U) return HAL_ERROR;
+
+	hadc->DmaBuffer = (uint16_t*)pData;
+	hadc->DmaLength = Length;
+	hadc->DMA_Handle->Counter = Length;
+	hadc->Running = 1;
+	return HAL_OK;
+}
+
+HAL_StatusTypeDef HAL_ADC_Stop_DMA(ADC_HandleTypeDef *hadc)
+{
+	hadc->DmaBuffer = NULL;
+	hadc->Running = 0;
+	return HAL_OK;
+}
+
+HAL_StatusTypeDef HAL_ADC_PollForConversion(ADC_HandleTypeDef *hadc, uint32_t Timeout)
+{
+	(void)Timeout;
+	return hadc->Running ? HAL_OK : HAL_ERROR;
+}
+
+uint32_t HAL_ADC_GetValue(ADC_HandleTypeDef *hadc)
+{
+	return hadc->Value;
+}
+
+HAL_StatusTypeDef HAL_TIM_Base_Start(TIM_HandleTypeDef *htim)
+{
+	htim->Running = 1;
+	return HAL_OK;
+}
+
+HAL_StatusTypeDef HAL_TIM_Base_Start_IT(TIM_HandleTypeDef *htim)
+{
+	if (htim->Running) return HAL_ERROR;
+	htim->Running = 1;
+	return HAL_OK;
+}
+
+HAL_StatusTypeDef HAL_TIM_Base_Stop_IT(TIM_HandleTypeDef *htim)
+{
+	htim->Running = 0;
+	return HAL_OK;
+}
+
+HAL_StatusTypeDef HAL_TIM_PWM_Start(TIM_HandleTypeDef *htim, uint32_t Channel)
+{
+	(void)Channel;
+	htim->Running = 1;
+	return HAL_OK;
+}
+
+HAL_StatusTypeDef HAL_I2C_Master_Transmit(I2C_HandleTypeDef *hi2c, uint16_t DevAddress, uint8_t *pData, uint16_t Size, uint32_t Timeout)
+{
+	(void)DevAddress; (void)pData; (void)Timeout;
+	hi2c->TxBytes += Size;
+	hi2c->TxTransfers++;
+	// start + address + data bytes, 9 clocks per byte including ACK
+	HOST_AdvanceBits(9U * (Size + 1U) + 2U, HOST_I2C_BAUD);
+	return HAL_OK;
+}
+
+/**
+ * @note Only accounts the bytes; the bus time is not advanced and the caller must clear
+ *       Busy and call the completion callback itself, as the interrupt would on the target.
+ */
+HAL_StatusTypeDef HAL_I2C_Master_Transmit_IT(I2C_HandleTypeDef *hi2c, uint16_t DevAddress, uint8_t *pData, uint16_t Size)
+{
+	(void)DevAddress;
+	if (hi2c->Busy) return HAL_BUSY;
+	hi2c->Busy = 1;
+	hi2c->Receive = 0;
+	hi2c->pBuffPtr = pData;
+	hi2c->XferSize = Size;
+	hi2c->TxBytes += Size;
+	hi2c->TxTransfers++;
+	return HAL_OK;
+}
+
+/**
+ * @note Fills the buffer with RxData; completion is delivered by the caller as for transmit.
+ */
+HAL_StatusTypeDef HAL_I2C_Master_Receive_IT(I2C_HandleTypeDef *hi2c, uint16_t DevAddress, uint8_t *pData, uint16_t Size)
+{
+	(void)DevAddress;
+	if (hi2c->Busy) return HAL_BUSY;
+	hi2c->Busy = 1;
+	hi2c->Receive = 1;
+	hi2c->pBuffPtr = pData;
+	hi2c->XferSize = Size;
+	for (uint16_t i = 0; i < Size; i++) pData[i] = hi2c->RxData;
+	return HAL_OK;
+}
+
+HAL_StatusTypeDef HAL_UART_Transmit(UART_HandleTypeDef *huart, const uint8_t *pData, uint16_t Size, uint32_t Timeout)
+{
+	(void)Timeout;
+	huart->TxBytes += Size;
+	if (huart->Echo) fwrite(pData, 1, Size, stdout);
+	HOST_AdvanceBits(10U * Size, HOST_UART_BAUD);
+	return HAL_OK;
+}
+
+/**
+ * @note Writes the bytes at once; the line time is not advanced and the caller must set
+ *       gState back to HAL_UART_STATE_READY and call the completion callback itself.
+ */
+HAL_StatusTypeDef HAL_UART_Transmit_DMA(UART_HandleTypeDef *huart, const uint8_t *pData, uint16_t Size)
+{
+	if (huart->gState == HAL_UART_STATE_BUSY_TX) return HAL_BUSY;
+	huart->gState = HAL_UART_STATE_BUSY_TX;
+	huart->TxBytes += Size;
+	if (huart->Echo) fwrite(pData, 1, Size, stdout);
+	return HAL_OK;
+}
+
+/**
+ * @note Only records the buffer; the caller writes the received bytes into it and calls
+ *       the receive event callback with the DMA write index, as the interrupts would.
+ */
+HAL_StatusTypeDef HAL_UARTEx_ReceiveToIdle_DMA(UART_HandleTypeDef *huart, uint8_t *pData, uint16_t Size)
+{
+	if (huart->RxState == HAL_UART_STATE_BUSY_RX) return HAL_BUSY;
+	huart->RxState = HAL_UART_STATE_BUSY_RX;
+	huart->RxBuffer = pData;
+	huart->RxSize = Size;
+	return HAL_OK;
+}
+
+/**
+ * @note Single process on the host: a semaphore is only busy between a take and its release.
+ */
+HAL_StatusTypeDef HAL_HSEM_FastTake(uint32_t SemID)
+{
+	if (SemID >= HOST_HSEM_COUNT || HOST_HsemTaken[SemID]) return HAL_ERROR;
+	HOST_HsemTaken[SemID] = 1;
+	return HAL_OK;
+}
+
+void HAL_HSEM_Release(uint32_t SemID, uint32_t ProcessID)
+{
+	(void)ProcessID;
+	if (SemID < HOST_HSEM_COUNT) HOST_HsemTaken[SemID] = 0;
+}
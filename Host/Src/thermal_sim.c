@@ -0,0 +1,236 @@
+/**
+  ******************************************************************************
+  * @file     : thermal_sim.c
+  * @author   : MS    Mateusz.Stasiak@student.put.poznan.pl
+  * @version  : 1.0.0
+  * @date     : Oct 17, 2026
+  * @brief    : Closed-loop simulator: CM7 control path against the thermal plant model.
+  *
+  *             Each period runs CONTROL_Step, the step Control_Task calls on the
+  *             CM7, with the unmodified LM35, PID and PWM drivers on the HAL stub.
+  *             The plant and the emulated sensor are the HIL glue the CM4 runs in
+  *             HIL_MODE, here stepped as fast as the host allows.
+  *             The setpoint alternates between two values to produce step responses.
+  *
+  ******************************************************************************
+  */
+
+/* Private includes ----------------------------------------------------------*/
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <time.h>
+#include <unistd.h>
+#include "stm32h7xx_hal.h"
+#include "control.h"
+#include "plant.h"
+#include "hil.h"
+
+/* Private typedef -----------------------------------------------------------*/
+typedef struct {
+	double Hours;          // simulated time [h]
+	float SetPointLow;     // [degC]
+	float SetPointHigh;    // [degC]
+	float StepPeriod;      // [s], time between setpoint changes
+	float NoiseMv;         // [mV rms], LM35 + ADC input noise before oversampling
+	float Band;            // [degC], settling band
+	const char *CsvPath;
+	uint32_t CsvDecimation;
+} SIM_ConfigTypeDef;
+
+typedef struct {
+	double IAE;            // integral of |error| [degC*s]
+	double SettleSum;      // [s]
+	double OvershootSum;   // [degC]
+	float OvershootMax;    // [degC]
+	uint32_t Steps;        // completed setpoint steps
+	uint32_t Unsettled;    // steps that never entered the band
+	uint64_t DutyChanges;  // PWM compare updates that changed the duty
+} SIM_StatsTypeDef;
+
+/* Private define ------------------------------------------------------------*/
+#define SIM_CONTROL_PERIOD  0.1f   // [s], TIM6 TRGO at 1 kHz, DMA half buffer of 100 samples
+#define SIM_PWM_PERIOD      999U   // TIM3 ARR
+
+/* Private macro -------------------------------------------------------------*/
+
+/* Private variables ---------------------------------------------------------*/
+static DMA_HandleTypeDef hdma_adc1;
+static ADC_HandleTypeDef hadc1 = { .DMA_Handle = &hdma_adc1 };
+static TIM_HandleTypeDef htim3 = { .ARR = SIM_PWM_PERIOD };
+
+static LM35_Filter_HandleTypeDef hfilter1 = LM35_FILTER_INIT_HANDLE(0.5f);
+static PWM_HandleTypeDef hpwm1 = PWM_INIT_HANDLE(&htim3, TIM_CHANNEL_1);
+static PID_HandleTypeDef hpid1 = PID_INIT_HANDLE(60, 40, 0.8f, 20, 100, 0);
+static CONTROL_HandleTypeDef hcontrol1 = CONTROL_INIT_HANDLE(&hadc1, &hfilter1, &hpid1, &hpwm1);
+
+/* Resistor 47R at 12 V dissipates ~3 W; estimates for the bare 5 W package, override with -K/-T/-L */
+static PLANT_HandleTypeDef hplant1 = {
+	.Gain = 0.37f,
+	.Tau = 90.0f,
+	.DeadTime = 4.0f,
+	.Ambient = 22.0f,
+	.Ts = SIM_CONTROL_PERIOD
+};
+
+static HIL_SharedTypeDef hil1;
+static HIL_HandleTypeDef hhil1 = HIL_INIT_HANDLE(&hil1, &hplant1, 0.0f);
+
+/* Public variables ----------------------------------------------------------*/
+
+/* Private function prototypes -----------------------------------------------*/
+
+/* Public function prototypes ------------------------------------------------*/
+
+/* Private functions ---------------------------------------------------------*/
+
+static void SIM_Usage(const char *Name)
+{
+	fprintf(stderr,
+		"usage: %s [-t hours] [-l sp_low] [-H sp_high] [-p step_period_s]\n"
+		"          [-n noise_mV] [-b band] [-K gain] [-T tau] [-L dead_time]\n"
+		"          [-c out.csv] [-d csv_decimation]\n", Name);
+}
+
+/* Public functions ----------------------------------------------------------*/
+
+int main(int argc, char **argv)
+{
+	SIM_ConfigTypeDef cfg = {
+		.Hours = 1000.0,
+		.SetPointLow = 30.0f,
+		.SetPointHigh = 45.0f,
+		.StepPeriod = 1800.0f,
+		.NoiseMv = 2.0f,
+		.Band = 0.5f,
+		.CsvPath = NULL,
+		.CsvDecimation = 10
+	};
+	SIM_StatsTypeDef stats = { 0 };
+	int opt;
+
+	while ((opt = getopt(argc, argv, "t:l:H:p:n:b:K:T:L:c:d:")) != -1)
+	{
+		switch (opt)
+		{
+		case 't': cfg.Hours = atof(optarg); break;
+		case 'l': cfg.SetPointLow = strtof(optarg, NULL); break;
+		case 'H': cfg.SetPointHigh = strtof(optarg, NULL); break;
+		case 'p': cfg.StepPeriod = strtof(optarg, NULL); break;
+		case 'n': cfg.NoiseMv = strtof(optarg, NULL); break;
+		case 'b': cfg.Band = strtof(optarg, NULL); break;
+		case 'K': hplant1.Gain = strtof(optarg, NULL); break;
+		case 'T': hplant1.Tau = strtof(optarg, NULL); break;
+		case 'L': hplant1.DeadTime = strtof(optarg, NULL); break;
+		case 'c': cfg.CsvPath = optarg; break;
+		case 'd': cfg.CsvDecimation = (uint32_t)strtoul(optarg, NULL, 10); break;
+		default: SIM_Usage(argv[0]); return 2;
+		}
+	}
+	if (cfg.CsvDecimation == 0) cfg.CsvDecimation = 1;
+
+	FILE *csv = NULL;
+	if (cfg.CsvPath != NULL)
+	{
+		csv = fopen(cfg.CsvPath, "w");
+		if (csv == NULL)
+		{
+			perror(cfg.CsvPath);
+			return 1;
+		}
+		fprintf(csv, "t_s,setpoint,temperature,measured,duty\n");
+	}
+
+	// Same ADC1 configuration as MX_ADC1_Init
+	hadc1.Init.OversamplingMode = ENABLE;
+	hadc1.Init.Oversampling.Ratio = 64;
+	hadc1.Init.Oversampling.RightBitShift = ADC_RIGHTBITSHIFT_6;
+
+	// Averaging N samples divides uncorrelated noise by sqrt(N)
+	const uint32_t ratio = hadc1.Init.OversamplingMode ? hadc1.Init.Oversampling.Ratio : 1U;
+	hhil1.NoiseMv = cfg.NoiseMv / sqrtf((float)ratio);
+
+	HIL_Init(&hhil1);
+	hfilter1.filtered_value = hplant1.Ambient;
+	DWT_Init();
+	PWM_Init(&hpwm1);
+	PID_SetAntiWindup(&hpid1, PID_ANTIWINDUP_BACKCALC, 5.0f);
+	if (LM35_Start(&hadc1) != HAL_OK) return 1;
+
+	const uint64_t period_cycles = (uint64_t)(SIM_CONTROL_PERIOD * (float)SystemCoreClock);
+	const uint64_t n_steps = (uint64_t)(cfg.Hours * 3600.0 / SIM_CONTROL_PERIOD);
+	const uint32_t steps_per_sp = (uint32_t)(cfg.StepPeriod / SIM_CONTROL_PERIOD);
+
+	float setpoint = cfg.SetPointLow;
+	float step_from = hplant1.Ambient;
+	uint32_t since_step = 0, last_outside = 0;
+	float peak_excursion = 0.0f;
+	int last_duty = -1;
+
+	PID_SetReference(&hpid1, setpoint);
+	clock_t wall_start = clock();
+
+	for (uint64_t k = 0; k < n_steps; k++)
+	{
+		if (steps_per_sp > 0 && since_step == steps_per_sp)
+		{
+			// Close the finished step before switching the setpoint
+			stats.Steps++;
+			if (last_outside + 1 >= since_step) stats.Unsettled++;
+			else stats.SettleSum += (last_outside + 1) * SIM_CONTROL_PERIOD;
+			stats.OvershootSum += peak_excursion;
+			if (peak_excursion > stats.OvershootMax) stats.OvershootMax = peak_excursion;
+
+			step_from = setpoint;
+			setpoint = (setpoint == cfg.SetPointLow) ? cfg.SetPointHigh : cfg.SetPointLow;
+			PID_SetReference(&hpid1, setpoint);
+			since_step = 0;
+			last_outside = 0;
+			peak_excursion = 0.0f;
+		}
+
+		HOST_Advance(period_cycles);
+		HOST_ADC_Convert(&hadc1, (uint16_t)hil1.AdcRaw);
+
+		uint16_t adc_raw;
+		float measured;
+		int duty = CONTROL_Step(&hcontrol1, DWT_GET_CYCLES(), &adc_raw, &measured);
+		if (duty != last_duty) stats.DutyChanges++;
+		last_duty = duty;
+
+		HIL_Update(&hhil1, (float)duty, SIM_CONTROL_PERIOD);
+		float temperature = hil1.Temperature;
+		float error = setpoint - temperature;
+		stats.IAE += fabsf(error) * SIM_CONTROL_PERIOD;
+
+		// Overshoot is measured past the setpoint in the direction of the step
+		float excursion = (setpoint > step_from) ? -error : error;
+		if (excursion > peak_excursion) peak_excursion = excursion;
+		if (fabsf(error) > cfg.Band) last_outside = since_step;
+		since_step++;
+
+		if (csv != NULL && k % cfg.CsvDecimation == 0)
+		{
+			fprintf(csv, "%.1f,%.2f,%.3f,%.3f,%d\n", k * SIM_CONTROL_PERIOD, setpoint,
+					temperature, measured, duty);
+		}
+	}
+
+	double wall = (double)(clock() - wall_start) / CLOCKS_PER_SEC;
+	if (csv != NULL) fclose(csv);
+
+	printf("simulated: %.1f h in %.2f s (%.0f h/s)\n", cfg.Hours, wall, (wall > 0) ? cfg.Hours / wall : 0.0);
+	printf("plant: K=%.3f degC/%%, tau=%.1f s, L=%.1f s, ambient=%.1f degC\n",
+			hplant1.Gain, hplant1.Tau, hplant1.DeadTime, hplant1.Ambient);
+	printf("IAE: %.1f degC*s per hour\n", (cfg.Hours > 0) ? stats.IAE / cfg.Hours : 0.0);
+	if (stats.Steps > 0)
+	{
+		uint32_t settled = stats.Steps - stats.Unsettled;
+		printf("steps: %u, unsettled: %u, mean settle (+-%.2f degC): %.1f s\n", stats.Steps,
+				stats.Unsettled, cfg.Band, settled ? stats.SettleSum / settled : 0.0);
+		printf("overshoot: mean %.2f degC, max %.2f degC\n", stats.OvershootSum / stats.Steps, stats.OvershootMax);
+	}
+	printf("duty changes: %.1f per hour\n", (cfg.Hours > 0) ? stats.DutyChanges / cfg.Hours : 0.0);
+	return 0;
+}
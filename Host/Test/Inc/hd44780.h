@@ -0,0 +1,64 @@
+/**
+  ******************************************************************************
+  * @file     : hd44780.h
+  * @author   : MS    Mateusz.Stasiak@student.put.poznan.pl
+  * @version  : 1.0.0
+  * @date     : Oct 17, 2026
+  * @brief    : HD44780 behind a PCF8574 backpack, decoded from the expander bytes.
+  *
+  *             Every byte written to the expander sets its pins: P7..P4 = D7..D4,
+  *             P3 backlight, P2 EN, P1 RW, P0 RS. The controller latches on the
+  *             falling edge of EN, in 8-bit mode after reset and in 4-bit mode
+  *             (high nibble first) once a function set clears DL. Only the state
+  *             the LCD driver relies on is modelled: DDRAM, the address counter,
+  *             CGRAM selection and the display control bits.
+  *
+  ******************************************************************************
+  */
+
+#ifndef HOST_TEST_HD44780_H_
+#define HOST_TEST_HD44780_H_
+
+/* Public includes -----------------------------------------------------------*/
+#include <stdint.h>
+
+/* Public typedef ------------------------------------------------------------*/
+typedef struct {
+	uint8_t Pins;          // expander output latch
+	uint8_t FourBit;       // DL cleared by a function set
+	uint8_t HalfWrite;     // high nibble latched, low nibble pending
+	uint8_t HalfRead;      // high nibble read, low nibble pending
+	uint8_t HighNibble;
+	uint8_t Address;       // address counter
+	uint8_t Cgram;         // the address counter points into CGRAM
+	uint8_t DisplayCtrl;   // D, C, B bits of the last display control command
+	char Ddram[128];
+	uint32_t Commands;     // instructions executed, RS = 0
+	uint32_t DataWrites;   // data bytes written, RS = 1
+	uint32_t Reads;        // complete busy flag / address reads
+	uint32_t Errors;       // a read interleaved with a half-written byte or the reverse
+} HD44780_ModelTypeDef;
+
+/* Public define -------------------------------------------------------------*/
+
+/* Public macro --------------------------------------------------------------*/
+
+/* Public variables ----------------------------------------------------------*/
+
+/* Public function prototypes ------------------------------------------------*/
+/**
+ * @brief Puts the model into the power-on state: 8-bit interface, DDRAM filled with 0.
+ */
+void HD44780_Init(HD44780_ModelTypeDef* hlcd);
+
+/**
+ * @brief Applies the bytes of one I2C write to the expander pins.
+ */
+void HD44780_Write(HD44780_ModelTypeDef* hlcd, const uint8_t* Bytes, uint16_t Size);
+
+/**
+ * @brief Returns the character shown at a cell of a 16x2 or 20x4 display.
+ */
+char HD44780_Cell(const HD44780_ModelTypeDef* hlcd, uint8_t Col, uint8_t Row);
+
+#endif /* HOST_TEST_HD44780_H_ */
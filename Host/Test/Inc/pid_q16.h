@@ -0,0 +1,69 @@
+/**
+  ******************************************************************************
+  * @file     : pid_q16.h
+  * @author   : MS    Mateusz.Stasiak@student.put.poznan.pl
+  * @version  : 1.0.0
+  * @date     : Oct 17, 2026
+  * @brief    : Q16.16 build of pid.c, linked next to the float one.
+  *
+  *             pid_q16.c compiles CM7/Components/Src/pid.c a second time with
+  *             PID_USE_FIXED_POINT and renamed symbols, so one host program can
+  *             run both builds of the controller side by side. The handle is
+  *             opaque; only the calls the tests need are wrapped.
+  *
+  ******************************************************************************
+  */
+
+#ifndef HOST_TEST_PID_Q16_H_
+#define HOST_TEST_PID_Q16_H_
+
+/* Public includes -----------------------------------------------------------*/
+#include "pid.h"
+
+/* Public typedef ------------------------------------------------------------*/
+typedef struct PIDQ_Handle PIDQ_HandleTypeDef;
+
+/* Public define -------------------------------------------------------------*/
+
+/* Public macro --------------------------------------------------------------*/
+
+/* Public variables ----------------------------------------------------------*/
+
+/* Public function prototypes ------------------------------------------------*/
+/**
+ * @brief Allocates a fixed-point controller and initializes it as PID_Init does.
+ * @return The handle, NULL when out of memory.
+ */
+PIDQ_HandleTypeDef* PIDQ_Create(float Kp, float Ki, float Kd, float SetPoint, float anti_windup_upperLimit, float anti_windup_lowerLimit);
+
+/**
+ * @brief Frees a controller returned by PIDQ_Create.
+ */
+void PIDQ_Destroy(PIDQ_HandleTypeDef* hpidq);
+
+/**
+ * @brief Fixed-point PID_SetReference.
+ */
+void PIDQ_SetReference(PIDQ_HandleTypeDef* hpidq, float SetPoint);
+
+/**
+ * @brief Fixed-point PID_SetDerivativeFilter.
+ */
+void PIDQ_SetDerivativeFilter(PIDQ_HandleTypeDef* hpidq, float Tf);
+
+/**
+ * @brief Fixed-point PID_SetAntiWindup.
+ */
+void PIDQ_SetAntiWindup(PIDQ_HandleTypeDef* hpidq, PID_AntiWindupTypeDef Mode, float Kt);
+
+/**
+ * @brief Fixed-point PID_TrackOutput.
+ */
+void PIDQ_TrackOutput(PIDQ_HandleTypeDef* hpidq, float Applied);
+
+/**
+ * @brief Fixed-point PID_CalculateDt.
+ */
+float PIDQ_CalculateDt(PIDQ_HandleTypeDef* hpidq, float y, float dt);
+
+#endif /* HOST_TEST_PID_Q16_H_ */
@@ -0,0 +1,56 @@
+/**
+  ******************************************************************************
+  * @file     : test.h
+  * @author   : MS    Mateusz.Stasiak@student.put.poznan.pl
+  * @version  : 1.0.0
+  * @date     : Oct 17, 2026
+  * @brief    : Minimal check macros for the host tests in Host/Test.
+  *
+  *             Every Host/Test/test_*.c is a standalone program: it counts
+  *             failed checks, keeps going, and returns TEST_RESULT() from main,
+  *             so the build loop in the README stops at the first failing test.
+  *
+  ******************************************************************************
+  */
+
+#ifndef HOST_TEST_H_
+#define HOST_TEST_H_
+
+/* Public includes -----------------------------------------------------------*/
+#include <stdio.h>
+#include <stdint.h>
+
+/* Public typedef ------------------------------------------------------------*/
+
+/* Public define -------------------------------------------------------------*/
+
+/* Public macro --------------------------------------------------------------*/
+/* Records a failure with a printf-style message when COND is false */
+#define TEST_CHECK(COND, ...)                                       \
+  do {                                                              \
+    TEST_Checks++;                                                  \
+    if (!(COND))                                                    \
+    {                                                               \
+      TEST_Failures++;                                              \
+      fprintf(stderr, "%s:%d: check failed: ", __FILE__, __LINE__); \
+      fprintf(stderr, __VA_ARGS__);                                 \
+      fputc('\n', stderr);                                          \
+    }                                                               \
+  } while (0)
+
+#define TEST_CHECK_EQ(A, B) \
+  TEST_CHECK((A) == (B), "%s == %s (%lld != %lld)", #A, #B, (long long)(A), (long long)(B))
+
+/* Prints the summary, evaluates to the process exit code */
+#define TEST_RESULT()                                                      \
+  (printf("%s: %lu checks, %lu failed\n", (TEST_Failures ? "FAIL" : "PASS"), \
+          (unsigned long)TEST_Checks, (unsigned long)TEST_Failures),         \
+   (TEST_Failures ? 1 : 0))
+
+/* Public variables ----------------------------------------------------------*/
+static uint64_t TEST_Checks;
+static uint64_t TEST_Failures;
+
+/* Public function prototypes ------------------------------------------------*/
+
+#endif /* HOST_TEST_H_ */
@@ -0,0 +1,142 @@
+/**
+  ******************************************************************************
+  * @file     : hd44780.c
+  * @author   : MS    Mateusz.Stasiak@student.put.poznan.pl
+  * @version  : 1.0.0
+  * @date     : Oct 17, 2026
+  * @brief    : HD44780 behind a PCF8574 backpack, decoded from the expander bytes.
+  *
+  ******************************************************************************
+  */
+
+/* Private includes ----------------------------------------------------------*/
+#include <string.h>
+#include "hd44780.h"
+
+/* Private typedef -----------------------------------------------------------*/
+
+/* Private define ------------------------------------------------------------*/
+#define HD44780_RS  0x01
+#define HD44780_RW  0x02
+#define HD44780_EN  0x04
+
+/* Private macro -------------------------------------------------------------*/
+
+/* Private variables ---------------------------------------------------------*/
+static const uint8_t HD44780_RowOffsets[4] = { 0x00, 0x40, 0x14, 0x54 };
+
+/* Private function prototypes -----------------------------------------------*/
+
+/* Private functions ---------------------------------------------------------*/
+
+/**
+ * @brief Executes one complete instruction or data byte.
+ */
+static void HD44780_Execute(HD44780_ModelTypeDef* hlcd, uint8_t Val, uint8_t Rs)
+{
+	if (Rs)
+	{
+		hlcd->DataWrites++;
+		if (!hlcd->Cgram) hlcd->Ddram[hlcd->Address] = (char)Val;
+		hlcd->Address = (hlcd->Address + 1) & 0x7F;
+		return;
+	}
+
+	hlcd->Commands++;
+	if (Val & 0x80)
+	{
+		hlcd->Address = Val & 0x7F;
+		hlcd->Cgram = 0;
+	}
+	else if (Val & 0x40)
+	{
+		hlcd->Address = Val & 0x3F;
+		hlcd->Cgram = 1;
+	}
+	else if (Val & 0x20)
+	{
+		if (!hlcd->FourBit && !(Val & 0x10))
+		{
+			hlcd->FourBit = 1;
+			hlcd->HalfWrite = 0;
+		}
+	}
+	else if (Val & 0x08)
+	{
+		hlcd->DisplayCtrl = Val & 0x07;
+	}
+	else if (Val & 0x02)
+	{
+		hlcd->Address = 0;
+		hlcd->Cgram = 0;
+	}
+	else if (Val & 0x01)
+	{
+		memset(hlcd->Ddram, ' ', sizeof(hlcd->Ddram));
+		hlcd->Address = 0;
+		hlcd->Cgram = 0;
+	}
+}
+
+/**
+ * @brief Handles one falling edge of EN.
+ */
+static void HD44780_Strobe(HD44780_ModelTypeDef* hlcd, uint8_t Pins)
+{
+	uint8_t Nibble = Pins >> 4;
+
+	if (Pins & HD44780_RW)
+	{
+		if (hlcd->HalfWrite) hlcd->Errors++;
+		if (!hlcd->FourBit || hlcd->HalfRead)
+		{
+			hlcd->HalfRead = 0;
+			hlcd->Reads++;
+		}
+		else
+		{
+			hlcd->HalfRead = 1;
+		}
+		return;
+	}
+
+	if (hlcd->HalfRead) hlcd->Errors++;
+	if (!hlcd->FourBit)
+	{
+		HD44780_Execute(hlcd, (uint8_t)(Nibble << 4), Pins & HD44780_RS);
+	}
+	else if (!hlcd->HalfWrite)
+	{
+		hlcd->HighNibble = Nibble;
+		hlcd->HalfWrite = 1;
+	}
+	else
+	{
+		hlcd->HalfWrite = 0;
+		HD44780_Execute(hlcd, (uint8_t)((hlcd->HighNibble << 4) | Nibble), Pins & HD44780_RS);
+	}
+}
+
+/* Public functions ----------------------------------------------------------*/
+
+void HD44780_Init(HD44780_ModelTypeDef* hlcd)
+{
+	memset(hlcd, 0, sizeof(*hlcd));
+}
+
+void HD44780_Write(HD44780_ModelTypeDef* hlcd, const uint8_t* Bytes, uint16_t Size)
+{
+	for (uint16_t i = 0; i < Size; i++)
+	{
+		if ((hlcd->Pins & HD44780_EN) && !(Bytes[i] & HD44780_EN))
+		{
+			HD44780_Strobe(hlcd, hlcd->Pins);
+		}
+		hlcd->Pins = Bytes[i];
+	}
+}
+
+char HD44780_Cell(const HD44780_ModelTypeDef* hlcd, uint8_t Col, uint8_t Row)
+{
+	return hlcd->Ddram[(HD44780_RowOffsets[Row & 3] + Col) & 0x7F];
+}
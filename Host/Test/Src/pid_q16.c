@@ -0,0 +1,85 @@
+/**
+  ******************************************************************************
+  * @file     : pid_q16.c
+  * @author   : MS    Mateusz.Stasiak@student.put.poznan.pl
+  * @version  : 1.0.0
+  * @date     : Oct 17, 2026
+  * @brief    : Q16.16 build of pid.c, linked next to the float one.
+  *
+  ******************************************************************************
+  */
+
+/* Private includes ----------------------------------------------------------*/
+#include <stdlib.h>
+
+/* The float build keeps the PID_ names; this one gets Q16PID_ */
+#define PID_USE_FIXED_POINT
+#define PID_Init                 Q16PID_Init
+#define PID_Reset                Q16PID_Reset
+#define PID_ResetTime            Q16PID_ResetTime
+#define PID_SetTunings           Q16PID_SetTunings
+#define PID_SetReference         Q16PID_SetReference
+#define PID_SetWeighting         Q16PID_SetWeighting
+#define PID_SetDerivativeFilter  Q16PID_SetDerivativeFilter
+#define PID_SetAntiWindup        Q16PID_SetAntiWindup
+#define PID_SetLimits            Q16PID_SetLimits
+#define PID_TrackOutput          Q16PID_TrackOutput
+#define PID_Calculate            Q16PID_Calculate
+#define PID_CalculateAt          Q16PID_CalculateAt
+#define PID_CalculateDt          Q16PID_CalculateDt
+#define PID_CalculateQ16         Q16PID_CalculateQ16
+#define PID_GetReference         Q16PID_GetReference
+#define PID_GetTunings           Q16PID_GetTunings
+#define PID_GetWeighting         Q16PID_GetWeighting
+#define PID_GetDerivativeFilter  Q16PID_GetDerivativeFilter
+#define PID_GetAntiWindup        Q16PID_GetAntiWindup
+#define PID_GetLimits            Q16PID_GetLimits
+#define PID_GetTerms             Q16PID_GetTerms
+#include "../../../CM7/Components/Src/pid.c"
+#include "pid_q16.h"
+
+/* Private typedef -----------------------------------------------------------*/
+struct PIDQ_Handle {
+	PID_HandleTypeDef Pid;
+};
+
+/* Public functions ----------------------------------------------------------*/
+
+PIDQ_HandleTypeDef* PIDQ_Create(float Kp, float Ki, float Kd, float SetPoint, float anti_windup_upperLimit, float anti_windup_lowerLimit)
+{
+	PIDQ_HandleTypeDef *hpidq = calloc(1, sizeof(*hpidq));
+	if (hpidq == NULL) return NULL;
+	PID_Init(&hpidq->Pid, Kp, Ki, Kd, SetPoint, anti_windup_upperLimit, anti_windup_lowerLimit);
+	PID_Reset(&hpidq->Pid);
+	return hpidq;
+}
+
+void PIDQ_Destroy(PIDQ_HandleTypeDef* hpidq)
+{
+	free(hpidq);
+}
+
+void PIDQ_SetReference(PIDQ_HandleTypeDef* hpidq, float SetPoint)
+{
+	PID_SetReference(&hpidq->Pid, SetPoint);
+}
+
+void PIDQ_SetDerivativeFilter(PIDQ_HandleTypeDef* hpidq, float Tf)
+{
+	PID_SetDerivativeFilter(&hpidq->Pid, Tf);
+}
+
+void PIDQ_SetAntiWindup(PIDQ_HandleTypeDef* hpidq, PID_AntiWindupTypeDef Mode, float Kt)
+{
+	PID_SetAntiWindup(&hpidq->Pid, Mode, Kt);
+}
+
+void PIDQ_TrackOutput(PIDQ_HandleTypeDef* hpidq, float Applied)
+{
+	PID_TrackOutput(&hpidq->Pid, Applied);
+}
+
+float PIDQ_CalculateDt(PIDQ_HandleTypeDef* hpidq, float y, float dt)
+{
+	return PID_CalculateDt(&hpidq->Pid, y, dt);
+}
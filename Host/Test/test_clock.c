@@ -0,0 +1,263 @@
+/**
+  ******************************************************************************
+  * @file     : test_clock.c
+  * @author   : MS    Mateusz.Stasiak@student.put.poznan.pl
+  * @version  : 1.0.0
+  * @date     : Oct 17, 2026
+  * @brief    : Clock profiles and the peripheral retiming that follows a switch.
+  *
+  *             Every profile is entered from every other one on the RCC model of
+  *             the HAL stub; the bus clocks must match the table in clock.h, and
+  *             the retiming both cores do afterwards must give the same timer
+  *             ticks, a standard-mode I2C bus and the UART baud rate again.
+  *             The I2C timing is also checked against the I2C specification
+  *             over the whole kernel clock range.
+  *
+  ******************************************************************************
+  */
+
+/* Private includes ----------------------------------------------------------*/
+#include "test.h"
+#include "clock.h"
+#include "serial.h"
+
+/* Private typedef -----------------------------------------------------------*/
+typedef struct {
+	uint32_t Core;     // CM7 [Hz]
+	uint32_t Hclk;     // [Hz]
+	uint32_t Pclk1;    // [Hz]
+	uint32_t Pclk2;    // [Hz]
+	uint32_t Vos;
+} TEST_ProfileTypeDef;
+
+/* Private define ------------------------------------------------------------*/
+#define TEST_TICK_HZ        1000000U   // TIM3, TIM6 and TIM7 count microseconds in every profile
+#define TEST_BAUD           115200U
+#define TEST_BAUD_ERROR     0.01       // largest relative baud rate error
+#define TEST_I2C_MIN_HZ     4000000U   // kernel clock sweep; slower clocks eat the data valid time
+#define TEST_I2C_MAX_HZ     120000000U // APB1 limit
+#define TEST_I2C_STEP_HZ    125000U
+
+/* Standard-mode I2C and the STM32H7 I2C timing rules (RM0399), in ns */
+#define TEST_I2C_LOW_MIN    4700.0
+#define TEST_I2C_HIGH_MIN   4000.0
+#define TEST_I2C_SETUP_MIN  250.0      // tSU;DAT
+#define TEST_I2C_VALID_MAX  3450.0     // tVD;DAT
+#define TEST_I2C_RISE_MAX   1000.0
+#define TEST_I2C_FALL_MAX   300.0
+#define TEST_I2C_AF_MIN     50.0       // analog filter delay
+#define TEST_I2C_AF_MAX     260.0
+
+/* Private macro -------------------------------------------------------------*/
+
+/* Private variables ---------------------------------------------------------*/
+static const TEST_ProfileTypeDef Profiles[CLK_PROFILE_COUNT] = {
+	[CLK_PROFILE_NOMINAL]     = {  64000000U,  64000000U,  32000000U,  64000000U, PWR_REGULATOR_VOLTAGE_SCALE3 },
+	[CLK_PROFILE_PERFORMANCE] = { 400000000U, 200000000U, 100000000U, 100000000U, PWR_REGULATOR_VOLTAGE_SCALE1 },
+	[CLK_PROFILE_LOW_POWER]   = {  16000000U,  16000000U,  16000000U,  16000000U, PWR_REGULATOR_VOLTAGE_SCALE3 },
+};
+
+static TIM_HandleTypeDef htim3 = { .Instance = TIM3 };
+static TIM_HandleTypeDef htim6 = { .Instance = TIM6 };
+static TIM_HandleTypeDef htim7 = { .Instance = TIM7 };
+static TIM_HandleTypeDef htim1 = { .Instance = TIM1 };
+
+static USART_TypeDef Usart3 = { .CR1 = USART_CR1_UE };
+static UART_HandleTypeDef huart3 = {
+	.Instance = &Usart3,
+	.Init = { .BaudRate = TEST_BAUD, .OverSampling = UART_OVERSAMPLING_16, .ClockPrescaler = UART_PRESCALER_DIV1 }
+};
+static uint8_t TxBuffer[64], RxBuffer[64];
+static SERIAL_HandleTypeDef hserial3 = SERIAL_INIT_HANDLE(&huart3, TxBuffer, sizeof(TxBuffer), RxBuffer, sizeof(RxBuffer));
+
+/* Private function prototypes -----------------------------------------------*/
+
+/* Private functions ---------------------------------------------------------*/
+
+/**
+ * @brief Checks a TIMINGR value against the standard-mode limits.
+ * @return 1 if every limit holds.
+ */
+static uint8_t TEST_I2CTimingValid(uint32_t KernelHz, uint32_t Timing)
+{
+	double Kernel = 1e9 / KernelHz;                                    // tI2CCLK [ns]
+	double Tick = (double)(((Timing >> I2C_TIMINGR_PRESC_Pos) & 0xFU) + 1U) * Kernel;
+	double Low = (double)(((Timing >> I2C_TIMINGR_SCLL_Pos) & 0xFFU) + 1U) * Tick;
+	double High = (double)(((Timing >> I2C_TIMINGR_SCLH_Pos) & 0xFFU) + 1U) * Tick;
+	double Setup = (double)(((Timing >> I2C_TIMINGR_SCLDEL_Pos) & 0xFU) + 1U) * Tick;
+	double Hold = (double)((Timing >> I2C_TIMINGR_SDADEL_Pos) & 0xFU) * Tick;
+
+	// Fastest possible clock: no rise or fall time, the shortest synchronisation on both edges
+	double Period = Low + High + 2.0 * (TEST_I2C_AF_MIN + 2.0 * Kernel);
+	uint8_t Valid = 1;
+
+	if (Low < TEST_I2C_LOW_MIN || High < TEST_I2C_HIGH_MIN) Valid = 0;
+	if (Setup < TEST_I2C_RISE_MAX + TEST_I2C_SETUP_MIN) Valid = 0;
+	if (Hold < TEST_I2C_FALL_MAX - TEST_I2C_AF_MIN - 3.0 * Kernel) Valid = 0;
+	if (Hold > TEST_I2C_VALID_MAX - TEST_I2C_RISE_MAX - TEST_I2C_AF_MAX - 4.0 * Kernel) Valid = 0;
+	if (Period < 1e9 / CLK_I2C_STANDARD_HZ) Valid = 0;
+	if (!Valid)
+	{
+		fprintf(stderr, "I2C at %u Hz: low %.0f, high %.0f, setup %.0f, hold %.0f, period %.0f ns\n",
+				KernelHz, Low, High, Setup, Hold, Period);
+	}
+	return Valid;
+}
+
+/**
+ * @brief The retiming of Clock_Retime on both cores, checked against the new clocks.
+ */
+static void TEST_Retime(CLK_ProfileTypeDef Profile)
+{
+	const TEST_ProfileTypeDef *p = &Profiles[Profile];
+	uint32_t TimerHz = (p->Pclk1 == p->Hclk) ? p->Pclk1 : 2U * p->Pclk1;
+
+	TEST_CHECK_EQ(CLK_GetTimerFreq(&htim6), TimerHz);
+	TEST_CHECK_EQ(CLK_SetTimerTick(&htim3, TEST_TICK_HZ), HAL_OK);
+	TEST_CHECK_EQ(CLK_SetTimerTick(&htim6, TEST_TICK_HZ), HAL_OK);
+	TEST_CHECK_EQ(CLK_SetTimerTick(&htim7, TEST_TICK_HZ), HAL_OK);
+	TEST_CHECK_EQ((TIM6->PSC + 1U) * TEST_TICK_HZ, TimerHz);
+	TEST_CHECK_EQ(TIM3->PSC, TIM6->PSC);
+	TEST_CHECK_EQ(TIM7->PSC, TIM6->PSC);
+	TEST_CHECK_EQ(htim6.Init.Prescaler, TIM6->PSC);
+
+	uint32_t Timing = CLK_GetI2CTiming(HAL_RCC_GetPCLK1Freq());
+	TEST_CHECK(TEST_I2CTimingValid(HAL_RCC_GetPCLK1Freq(), Timing), "I2C timing 0x%08X, profile %d", Timing, Profile);
+
+	Usart3.BRR = 0;
+	TEST_CHECK_EQ(SERIAL_Retime(&hserial3, HAL_RCC_GetPCLK1Freq()), HAL_OK);
+	double Baud = (double)HAL_RCC_GetPCLK1Freq() / Usart3.BRR;
+	TEST_CHECK(Baud > TEST_BAUD * (1.0 - TEST_BAUD_ERROR) && Baud < TEST_BAUD * (1.0 + TEST_BAUD_ERROR),
+			"%.0f bit/s, profile %d", Baud, Profile);
+	TEST_CHECK(Usart3.CR1 & USART_CR1_UE, "UART left disabled");
+}
+
+/**
+ * @brief Enters every profile from every other one.
+ */
+static void TEST_Profiles(void)
+{
+	TEST_CHECK_EQ(CLK_GetProfile(), CLK_PROFILE_NOMINAL);
+
+	for (int From = 0; From < CLK_PROFILE_COUNT; From++)
+	{
+		for (int To = 0; To < CLK_PROFILE_COUNT; To++)
+		{
+			const TEST_ProfileTypeDef *p = &Profiles[To];
+
+			TEST_CHECK_EQ(CLK_SetProfile((CLK_ProfileTypeDef)From), HAL_OK);
+			TEST_CHECK_EQ(CLK_SetProfile((CLK_ProfileTypeDef)To), HAL_OK);
+			TEST_CHECK_EQ(CLK_GetProfile(), To);
+			TEST_CHECK_EQ(SystemCoreClock, p->Core);
+			TEST_CHECK_EQ(HAL_RCC_GetHCLKFreq(), p->Hclk);
+			TEST_CHECK_EQ(HAL_RCC_GetPCLK1Freq(), p->Pclk1);
+			TEST_CHECK_EQ(HAL_RCC_GetPCLK2Freq(), p->Pclk2);
+			TEST_CHECK_EQ(HOST_VoltageScale, p->Vos);
+			TEST_Retime((CLK_ProfileTypeDef)To);
+		}
+	}
+
+	// An unknown profile changes nothing
+	TEST_CHECK_EQ(CLK_SetProfile(CLK_PROFILE_PERFORMANCE), HAL_OK);
+	TEST_CHECK_EQ(CLK_SetProfile(CLK_PROFILE_COUNT), HAL_ERROR);
+	TEST_CHECK_EQ(CLK_GetProfile(), CLK_PROFILE_PERFORMANCE);
+	TEST_CHECK_EQ(SystemCoreClock, Profiles[CLK_PROFILE_PERFORMANCE].Core);
+}
+
+/**
+ * @brief Timer kernel clocks for every APB divider, with and without TIMPRE.
+ */
+static void TEST_TimerFreq(void)
+{
+	static const uint32_t Apb1[] = { RCC_APB1_DIV1, RCC_APB1_DIV2, RCC_APB1_DIV4, RCC_APB1_DIV8, RCC_APB1_DIV16 };
+	static const uint32_t Apb2[] = { RCC_APB2_DIV1, RCC_APB2_DIV2, RCC_APB2_DIV4, RCC_APB2_DIV8, RCC_APB2_DIV16 };
+	uint32_t D2cfgr = RCC->D2CFGR;
+
+	TEST_CHECK_EQ(CLK_SetProfile(CLK_PROFILE_PERFORMANCE), HAL_OK);
+	uint32_t Hclk = HAL_RCC_GetHCLKFreq();
+
+	for (uint32_t Timpre = 0; Timpre < 2; Timpre++)
+	{
+		if (Timpre) RCC->CFGR |= RCC_CFGR_TIMPRE;
+		else RCC->CFGR &= ~RCC_CFGR_TIMPRE;
+
+		for (uint32_t i = 0; i < 5; i++)
+		{
+			uint32_t Divider = 1UL << i;
+			uint32_t Pclk = Hclk / Divider;
+			// RM0399 timer clock table: x1 or x2 of PCLK, with TIMPRE x4 but never above HCLK
+			uint32_t Expected = Timpre ? ((Divider <= 4U) ? Hclk : 4U * Pclk) : ((Divider == 1U) ? Pclk : 2U * Pclk);
+
+			RCC->D2CFGR = Apb1[i] | Apb2[4U - i];
+			TEST_CHECK_EQ(HAL_RCC_GetPCLK1Freq(), Pclk);
+			TEST_CHECK_EQ(CLK_GetTimerFreq(&htim6), Expected);
+
+			uint32_t Divider2 = 1UL << (4U - i);
+			uint32_t Pclk2 = Hclk / Divider2;
+			Expected = Timpre ? ((Divider2 <= 4U) ? Hclk : 4U * Pclk2) : ((Divider2 == 1U) ? Pclk2 : 2U * Pclk2);
+			TEST_CHECK_EQ(CLK_GetTimerFreq(&htim1), Expected);
+		}
+	}
+	RCC->CFGR &= ~RCC_CFGR_TIMPRE;
+	RCC->D2CFGR = D2cfgr;
+
+	// Ticks the 16-bit prescaler cannot reach leave the timer as it was
+	TEST_CHECK_EQ(CLK_SetTimerTick(&htim6, TEST_TICK_HZ), HAL_OK);
+	uint32_t Psc = TIM6->PSC;
+	TEST_CHECK_EQ(CLK_SetTimerTick(&htim6, 0), HAL_ERROR);
+	TEST_CHECK_EQ(CLK_SetTimerTick(&htim6, CLK_GetTimerFreq(&htim6) + 1U), HAL_ERROR);
+	TEST_CHECK_EQ(CLK_SetTimerTick(&htim6, CLK_GetTimerFreq(&htim6) / 0x10001U), HAL_ERROR);
+	TEST_CHECK_EQ(TIM6->PSC, Psc);
+	uint32_t Slowest = (CLK_GetTimerFreq(&htim6) + 0xFFFFU) / 0x10000U;
+	TEST_CHECK_EQ(CLK_SetTimerTick(&htim6, Slowest), HAL_OK);
+	TEST_CHECK_EQ(TIM6->PSC, CLK_GetTimerFreq(&htim6) / Slowest - 1U);
+	TEST_CHECK_EQ(CLK_SetTimerTick(&htim6, CLK_GetTimerFreq(&htim6)), HAL_OK);
+	TEST_CHECK_EQ(TIM6->PSC, 0);
+	TEST_CHECK_EQ(CLK_SetProfile(CLK_PROFILE_NOMINAL), HAL_OK);
+}
+
+static void TEST_I2CTiming(void)
+{
+	uint32_t Invalid = 0, Count = 0;
+
+	for (uint32_t Hz = TEST_I2C_MIN_HZ; Hz <= TEST_I2C_MAX_HZ; Hz += TEST_I2C_STEP_HZ)
+	{
+		Invalid += !TEST_I2CTimingValid(Hz, CLK_GetI2CTiming(Hz));
+		Count++;
+	}
+	printf("I2C timing: %u kernel clocks from %u to %u Hz, %u out of specification\n",
+			Count, TEST_I2C_MIN_HZ, TEST_I2C_MAX_HZ, Invalid);
+	TEST_CHECK_EQ(Invalid, 0);
+	TEST_CHECK_EQ(CLK_GetI2CTiming(0), 0);
+}
+
+/**
+ * @brief The baud rate divider is only rewritten on an idle line and with 16x oversampling.
+ */
+static void TEST_SerialRetime(void)
+{
+	Usart3.BRR = 1234U;
+	hserial3.TxHead = 1;
+	TEST_CHECK_EQ(SERIAL_Retime(&hserial3, 32000000U), HAL_BUSY);
+	hserial3.TxTail = 1;
+	hserial3.TxBusy = 1;
+	TEST_CHECK_EQ(SERIAL_Retime(&hserial3, 32000000U), HAL_BUSY);
+	hserial3.TxBusy = 0;
+	huart3.Init.OverSampling = UART_OVERSAMPLING_8;
+	TEST_CHECK_EQ(SERIAL_Retime(&hserial3, 32000000U), HAL_ERROR);
+	TEST_CHECK_EQ(Usart3.BRR, 1234U);
+	huart3.Init.OverSampling = UART_OVERSAMPLING_16;
+	TEST_CHECK_EQ(SERIAL_Retime(&hserial3, 32000000U), HAL_OK);
+	TEST_CHECK_EQ(Usart3.BRR, 278U);
+}
+
+/* Public functions ----------------------------------------------------------*/
+
+int main(void)
+{
+	TEST_Profiles();
+	TEST_TimerFreq();
+	TEST_I2CTiming();
+	TEST_SerialRetime();
+	return TEST_RESULT();
+}
@@ -0,0 +1,297 @@
+/**
+  ******************************************************************************
+  * @file     : test_cmd.c
+  * @author   : MS    Mateusz.Stasiak@student.put.poznan.pl
+  * @version  : 1.0.0
+  * @date     : Oct 17, 2026
+  * @brief    : Command line assembler, tokenizer, CMD_ParseFloat and the
+  *             get/set/list commands of the parameter registry.
+  *
+  *             CMD_ParseFloat is compared with strtof on random decimal strings;
+  *             it rounds twice (power of ten, then the division or product), so
+  *             it may differ from the correctly rounded result by one float ulp,
+  *             never more.
+  *
+  ******************************************************************************
+  */
+
+/* Private includes ----------------------------------------------------------*/
+#include <string.h>
+#include <stdlib.h>
+#include <math.h>
+#include "test.h"
+#include "cmd.h"
+#include "param.h"
+
+/* Private typedef -----------------------------------------------------------*/
+
+/* Private define ------------------------------------------------------------*/
+#define TEST_RANDOM_NUMBERS  1000000U
+#define TEST_REPLY_LINES     8U
+#define TEST_REPLY_MAX       400U
+
+/* Private macro -------------------------------------------------------------*/
+
+/* Private variables ---------------------------------------------------------*/
+static uint64_t Seed = 0x2545F4914F6CDD1DULL;
+
+static const PARAM_EntryTypeDef Entries[] = {
+	PARAM_ENTRY("pid.kp", PARAM_TYPE_FLOAT, 0, 1000),
+	PARAM_ENTRY("pid.imin", PARAM_TYPE_FLOAT, -100, 100),
+	PARAM_ENTRY("pid.imax", PARAM_TYPE_FLOAT, -100, 100),
+	PARAM_ENTRY("loop.ms", PARAM_TYPE_INT, 1, 1000),
+};
+static float Values[] = { 60.0f, 0.0f, 100.0f, 100.0f };
+static uint32_t Writes;
+
+static char Replies[TEST_REPLY_LINES][TEST_REPLY_MAX];
+static uint8_t nReplies;
+
+/* Private function prototypes -----------------------------------------------*/
+static float TEST_Get(uint8_t Id);
+static uint8_t TEST_Set(uint8_t Id, float Value);
+
+static const PARAM_HandleTypeDef hparam = PARAM_INIT_HANDLE(Entries, 4, TEST_Get, TEST_Set);
+
+/* Private functions ---------------------------------------------------------*/
+
+static uint64_t TEST_Random(void)
+{
+	Seed ^= Seed << 13;
+	Seed ^= Seed >> 7;
+	Seed ^= Seed << 17;
+	return Seed;
+}
+
+static float TEST_Get(uint8_t Id)
+{
+	return Values[Id];
+}
+
+/**
+ * @brief Refuses an integrator lower limit above the upper one, as main.c does.
+ */
+static uint8_t TEST_Set(uint8_t Id, float Value)
+{
+	if ((Id == 1 && Value > Values[2]) || (Id == 2 && Value < Values[1])) return 0;
+	Values[Id] = Value;
+	Writes++;
+	return 1;
+}
+
+static void TEST_Write(const char* Line, size_t Length)
+{
+	TEST_CHECK(Length == strlen(Line) && Length > 0 && Line[Length - 1] == '\n', "reply not one terminated line");
+	if (nReplies < TEST_REPLY_LINES)
+	{
+		strncpy(Replies[nReplies], Line, TEST_REPLY_MAX - 1);
+		nReplies++;
+	}
+}
+
+/**
+ * @brief Feeds a string and returns the number of complete lines it produced.
+ */
+static uint32_t TEST_Feed(CMD_HandleTypeDef* hcmd, const char* Str)
+{
+	uint32_t Lines = 0;
+	while (*Str) Lines += CMD_Feed(hcmd, *Str++);
+	return Lines;
+}
+
+/**
+ * @brief Runs one line through the assembler, the tokenizer and the registry.
+ */
+static void TEST_Command(const char* Line, const char* Expected)
+{
+	CMD_HandleTypeDef hcmd = CMD_INIT_HANDLE();
+	CMD_ArgTypeDef Args[CMD_ARGS_MAX];
+
+	nReplies = 0;
+	TEST_CHECK(TEST_Feed(&hcmd, Line) == 1, "\"%s\" is not one line", Line);
+	uint8_t Count = CMD_Tokenize(&hcmd, Args, CMD_ARGS_MAX);
+	TEST_CHECK(PARAM_Command(&hparam, Args, Count, TEST_Write) == 1, "\"%s\" not a registry command", Line);
+	TEST_CHECK(nReplies > 0 && strcmp(Replies[nReplies - 1], Expected) == 0, "\"%s\" answered \"%s\", expected \"%s\"",
+			Line, nReplies ? Replies[nReplies - 1] : "", Expected);
+}
+
+static void TEST_Lines(void)
+{
+	CMD_HandleTypeDef hcmd = CMD_INIT_HANDLE();
+	char Long[CMD_LINE_MAX + 8];
+
+	// One line per terminator, CR LF gives no empty second line
+	TEST_CHECK_EQ(TEST_Feed(&hcmd, "s=35.5\r\n"), 1);
+	TEST_CHECK(strcmp(hcmd.Line, "s=35.5") == 0, "line \"%s\"", hcmd.Line);
+	TEST_CHECK_EQ(TEST_Feed(&hcmd, "\n\n\r"), 0);
+	TEST_CHECK_EQ(TEST_Feed(&hcmd, "p=60\ni=40\n"), 2);
+	TEST_CHECK(strcmp(hcmd.Line, "i=40") == 0, "line \"%s\"", hcmd.Line);
+
+	// The longest line that fits, then one character more
+	memset(Long, 'a', CMD_LINE_MAX - 1);
+	strcpy(&Long[CMD_LINE_MAX - 1], "\n");
+	TEST_CHECK_EQ(TEST_Feed(&hcmd, Long), 1);
+	TEST_CHECK_EQ(strlen(hcmd.Line), CMD_LINE_MAX - 1);
+	uint32_t Rejected = hcmd.Rejected;
+	memset(Long, 'a', CMD_LINE_MAX);
+	strcpy(&Long[CMD_LINE_MAX], "\n");
+	TEST_CHECK_EQ(TEST_Feed(&hcmd, Long), 0);
+	TEST_CHECK_EQ(hcmd.Rejected - Rejected, 1);
+
+	// A corrupted line is dropped whole and does not merge with the next one
+	TEST_CHECK_EQ(TEST_Feed(&hcmd, "s=3\x01" "5\nd=1\n"), 1);
+	TEST_CHECK(strcmp(hcmd.Line, "d=1") == 0, "line after noise \"%s\"", hcmd.Line);
+	TEST_CHECK_EQ(TEST_Feed(&hcmd, "k=\x7F" "1\n\xFF\n"), 0);
+	TEST_CHECK_EQ(hcmd.Rejected - Rejected, 4);
+	TEST_CHECK_EQ(TEST_Feed(&hcmd, "a\tb\n"), 1);
+}
+
+static void TEST_Tokenize(void)
+{
+	CMD_HandleTypeDef hcmd = CMD_INIT_HANDLE();
+	CMD_ArgTypeDef Args[CMD_ARGS_MAX];
+
+	// Tokenizing needs a complete line
+	TEST_Feed(&hcmd, "s=1");
+	TEST_CHECK_EQ(CMD_Tokenize(&hcmd, Args, CMD_ARGS_MAX), 0);
+
+	TEST_Feed(&hcmd, "\n");
+	TEST_CHECK_EQ(CMD_Tokenize(&hcmd, Args, CMD_ARGS_MAX), 1);
+
+	TEST_Feed(&hcmd, "  s=35.5 p=60,i=40.25;;d=-1\tkp= j \n");
+	TEST_CHECK_EQ(CMD_Tokenize(&hcmd, Args, CMD_ARGS_MAX), 6);
+	TEST_CHECK(CMD_IsName(&Args[0], "s") && strcmp(Args[0].Value, "35.5") == 0, "arg 0");
+	TEST_CHECK(CMD_IsName(&Args[1], "p") && strcmp(Args[1].Value, "60") == 0, "arg 1");
+	TEST_CHECK(CMD_IsName(&Args[2], "i") && strcmp(Args[2].Value, "40.25") == 0, "arg 2");
+	TEST_CHECK(CMD_IsName(&Args[3], "d") && strcmp(Args[3].Value, "-1") == 0, "arg 3");
+	TEST_CHECK(CMD_IsName(&Args[4], "kp") && Args[4].Value[0] == '\0', "arg 4, empty value");
+	TEST_CHECK(CMD_IsName(&Args[5], "j") && Args[5].Value[0] == '\0', "arg 5, no value");
+
+	// Short form only for one letter directly followed by a number
+	TEST_Feed(&hcmd, "s35.5 p-2 i.5 d+.5 list t1x get\n");
+	TEST_CHECK_EQ(CMD_Tokenize(&hcmd, Args, CMD_ARGS_MAX), 7);
+	TEST_CHECK(CMD_IsName(&Args[0], "s") && strcmp(Args[0].Value, "35.5") == 0, "short s");
+	TEST_CHECK(CMD_IsName(&Args[1], "p") && strcmp(Args[1].Value, "-2") == 0, "short p");
+	TEST_CHECK(CMD_IsName(&Args[2], "i") && strcmp(Args[2].Value, ".5") == 0, "short i");
+	TEST_CHECK(CMD_IsName(&Args[3], "d") && strcmp(Args[3].Value, "+.5") == 0, "short d");
+	TEST_CHECK(CMD_IsName(&Args[4], "list") && Args[4].Value[0] == '\0', "list is not l=ist");
+	TEST_CHECK(CMD_IsName(&Args[5], "t") && strcmp(Args[5].Value, "1x") == 0, "short t");
+	TEST_CHECK(CMD_IsName(&Args[6], "get"), "get");
+
+	// Names compare whole, not as prefixes
+	TEST_CHECK(!CMD_IsName(&Args[6], "ge"), "prefix matched");
+	TEST_CHECK(!CMD_IsName(&Args[6], "gets"), "longer name matched");
+
+	// Arguments beyond the capacity are ignored
+	TEST_Feed(&hcmd, "a b c d e f g h i j\n");
+	TEST_CHECK_EQ(CMD_Tokenize(&hcmd, Args, 3), 3);
+	TEST_CHECK(CMD_IsName(&Args[2], "c"), "third argument");
+}
+
+static void TEST_ParseFloat(void)
+{
+	static const char* const Bad[] = { "", "-", "+", ".", "-.", "1.2.3", "1e5", "abc", "1 ", " 1", "--1", "1-", "0x10", "nan", "inf" };
+	static const struct { const char *Str; float Value; } Good[] = {
+		{ "0", 0.0f }, { "-12", -12.0f }, { "35.5", 35.5f }, { ".25", 0.25f }, { "5.", 5.0f }, { "+3", 3.0f },
+		{ "0.1", 0.1f }, { "1000", 1000.0f }, { "-0.001", -0.001f }, { "16777217", 16777216.0f },
+		{ "123456789012345678901234", 1.2345679e23f }, { "0.000000000000000000001", 1e-21f },
+		{ "00000000000000000000000000042.5", 42.5f }
+	};
+	float Value;
+
+	for (size_t i = 0; i < sizeof(Bad) / sizeof(Bad[0]); i++)
+	{
+		Value = 7.0f;
+		TEST_CHECK(!CMD_ParseFloat(Bad[i], &Value), "\"%s\" accepted", Bad[i]);
+		TEST_CHECK(Value == 7.0f, "\"%s\" wrote the output", Bad[i]);
+	}
+	for (size_t i = 0; i < sizeof(Good) / sizeof(Good[0]); i++)
+	{
+		TEST_CHECK(CMD_ParseFloat(Good[i].Str, &Value) && Value == Good[i].Value, "\"%s\" parsed as %.9g, expected %.9g",
+				Good[i].Str, (double)Value, (double)Good[i].Value);
+	}
+
+	// Random decimals against strtof: at most one ulp apart
+	uint32_t Exact = 0, OneUlp = 0, Worse = 0;
+	for (uint32_t n = 0; n < TEST_RANDOM_NUMBERS; n++)
+	{
+		char Str[48];
+		uint64_t r = TEST_Random();
+		uint32_t IntDigits = (uint32_t)(r % 12U), FracDigits = (uint32_t)((r >> 8) % 12U);
+		size_t k = 0;
+
+		if ((r >> 16) & 1U) Str[k++] = '-';
+		for (uint32_t i = 0; i < IntDigits; i++) Str[k++] = (char)('0' + TEST_Random() % 10U);
+		if (FracDigits > 0 || IntDigits == 0)
+		{
+			Str[k++] = '.';
+			for (uint32_t i = 0; i < FracDigits || (IntDigits == 0 && i == 0); i++) Str[k++] = (char)('0' + TEST_Random() % 10U);
+		}
+		Str[k] = '\0';
+
+		float Expected = strtof(Str, NULL);
+		if (!CMD_ParseFloat(Str, &Value))
+		{
+			TEST_CHECK(0, "\"%s\" rejected", Str);
+			continue;
+		}
+		if (Value == Expected) Exact++;
+		else if (Value == nextafterf(Expected, INFINITY) || Value == nextafterf(Expected, -INFINITY)) OneUlp++;
+		else if (Worse++ < 10) fprintf(stderr, "\"%s\" parsed as %.9g, strtof %.9g\n", Str, (double)Value, (double)Expected);
+	}
+	printf("CMD_ParseFloat: %u random decimals, %u equal to strtof, %u one ulp apart, %u worse\n",
+			TEST_RANDOM_NUMBERS, Exact, OneUlp, Worse);
+	TEST_CHECK_EQ(Worse, 0);
+}
+
+static void TEST_Registry(void)
+{
+	TEST_Command("get pid.kp loop.ms\n", "ok pid.kp=60 loop.ms=100\n");
+	TEST_Command("get\n", "ok pid.kp=60 pid.imin=0 pid.imax=100 loop.ms=100\n");
+	TEST_Command("get pid.kp pid.x\n", "err unknown pid.x\n");
+
+	// Values are read back after the write
+	TEST_Command("set pid.kp=55.5 loop.ms=20\n", "ok pid.kp=55.5 loop.ms=20\n");
+	TEST_Command("set pid.kp=0.1\n", "ok pid.kp=0.1\n");
+	TEST_Command("set pid.kp=123.4567\n", "ok pid.kp=123.4567\n");
+
+	// The whole line is checked before anything is written
+	uint32_t Before = Writes;
+	TEST_Command("set pid.kp=1 loop.ms=5000\n", "err range loop.ms=5000\n");
+	TEST_Command("set pid.kp=1 loop.ms=2.5\n", "err type loop.ms=2.5\n");
+	TEST_Command("set pid.kp=1 pid.kd=1\n", "err unknown pid.kd=1\n");
+	TEST_Command("set pid.kp=1 loop.ms\n", "err value loop.ms\n");
+	TEST_Command("set pid.kp=1 loop.ms=1x\n", "err value loop.ms=1x\n");
+	TEST_Command("set\n", "err value set\n");
+	TEST_CHECK_EQ(Writes, Before);
+	TEST_CHECK(Values[0] == 123.4567f, "pid.kp changed by a rejected set");
+
+	// A refusal stops the set; the arguments before it stay applied
+	TEST_Command("set pid.kp=2 pid.imin=150\n", "err range pid.imin=150\n");
+	TEST_Command("set pid.kp=2 pid.imin=100 pid.imax=50\n", "err refused pid.imax=50\n");
+	TEST_CHECK(Values[0] == 2.0f && Values[1] == 100.0f && Values[2] == 100.0f, "partial set not applied");
+
+	// One line per entry, then the count
+	TEST_Command("list\n", "ok 4\n");
+	TEST_CHECK_EQ(nReplies, 5);
+	TEST_CHECK(strcmp(Replies[0], "pid.kp=2 float 0..1000\n") == 0, "list line \"%s\"", Replies[0]);
+	TEST_CHECK(strcmp(Replies[1], "pid.imin=100 float -100..100\n") == 0, "list line \"%s\"", Replies[1]);
+	TEST_CHECK(strcmp(Replies[3], "loop.ms=20 int 1..1000\n") == 0, "list line \"%s\"", Replies[3]);
+
+	// Other commands are left to the caller
+	CMD_HandleTypeDef hcmd = CMD_INIT_HANDLE();
+	CMD_ArgTypeDef Args[CMD_ARGS_MAX];
+	TEST_Feed(&hcmd, "s=30\n");
+	TEST_CHECK_EQ(PARAM_Command(&hparam, Args, CMD_Tokenize(&hcmd, Args, CMD_ARGS_MAX), TEST_Write), 0);
+}
+
+/* Public functions ----------------------------------------------------------*/
+
+int main(void)
+{
+	TEST_Lines();
+	TEST_Tokenize();
+	TEST_ParseFloat();
+	TEST_Registry();
+	return TEST_RESULT();
+}
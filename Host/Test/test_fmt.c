@@ -0,0 +1,284 @@
+/**
+  ******************************************************************************
+  * @file     : test_fmt.c
+  * @author   : MS    Mateusz.Stasiak@student.put.poznan.pl
+  * @version  : 1.0.0
+  * @date     : Oct 17, 2026
+  * @brief    : FMT_Float, FMT_Int and FMT_UInt against the C library snprintf.
+  *
+  *             Random bit patterns and uniform values cover the whole float range
+  *             below FMT_FLOAT_LIMIT at 0..FMT_MAX_DECIMALS decimals, with field
+  *             widths and both pad characters; ties, signed zero and subnormals
+  *             are listed explicitly. NaN, infinities, the '#' overflow fill and
+  *             truncation at the end of the buffer are checked on their own.
+  *
+  ******************************************************************************
+  */
+
+/* Private includes ----------------------------------------------------------*/
+#include <string.h>
+#include <math.h>
+#include <float.h>
+#include "test.h"
+#include "fmt.h"
+
+/* Private typedef -----------------------------------------------------------*/
+
+/* Private define ------------------------------------------------------------*/
+#define TEST_RANDOM_FLOATS  150000U
+#define TEST_RANDOM_INTS    200000U
+#define TEST_MAX_WIDTH      16U
+#define TEST_MAX_REPORTS    10U      // mismatches printed in full
+
+/* Private macro -------------------------------------------------------------*/
+
+/* Private variables ---------------------------------------------------------*/
+static uint64_t Seed = 0x9E3779B97F4A7C15ULL;
+static uint64_t Compared, Mismatches;
+
+/* Special values formatted at every precision, width and pad */
+static const float Specials[] = {
+	0.0f, -0.0f, 0.5f, 1.5f, 2.5f, -2.5f, 0.05f, 0.125f, 0.375f, 9.5f, 99.5f, 0.999999f,
+	9.9999995f, 99.99995f, 123.456f, -123.456f, 1e-6f, 5e-7f, 4.9999999e-7f, 1e-7f,
+	FLT_MIN, -FLT_MIN, 1e-45f, 16777216.0f, 16777217.0f, 4294967040.0f, -4294967040.0f,
+	2147483648.0f, 4294967295.0f / 2.0f, 0.1f, 0.2f, 0.3f, 25.05f, 25.15f, 100.0f
+};
+
+/* Private function prototypes -----------------------------------------------*/
+
+/* Private functions ---------------------------------------------------------*/
+
+static uint64_t TEST_Random(void)
+{
+	Seed ^= Seed << 13;
+	Seed ^= Seed >> 7;
+	Seed ^= Seed << 17;
+	return Seed;
+}
+
+/**
+ * @brief Counts a comparison and reports the first mismatches in full.
+ */
+static void TEST_Compare(const char* Expected, const char* Got, size_t Length, const char* What)
+{
+	Compared++;
+	if (strcmp(Expected, Got) == 0 && Length == strlen(Expected)) return;
+	if (Mismatches++ < TEST_MAX_REPORTS)
+	{
+		fprintf(stderr, "%s: expected \"%s\", got \"%s\" (length %zu)\n", What, Expected, Got, Length);
+	}
+}
+
+static void TEST_Float(float Value, uint8_t Decimals, uint8_t Width, char Pad)
+{
+	char Expected[64], Got[64], What[64];
+	FMT_HandleTypeDef hfmt;
+
+	snprintf(Expected, sizeof(Expected), (Pad == '0') ? "%0*.*f" : "%*.*f", Width, Decimals, (double)Value);
+	FMT_Init(&hfmt, Got, sizeof(Got));
+	size_t Length = FMT_Float(&hfmt, Value, Decimals, Width, Pad);
+	snprintf(What, sizeof(What), "FMT_Float(%a, %u, %u, '%c')", (double)Value, Decimals, Width, Pad);
+	TEST_Compare(Expected, Got, Length, What);
+}
+
+static void TEST_FloatAll(float Value)
+{
+	for (uint8_t Decimals = 0; Decimals <= FMT_MAX_DECIMALS; Decimals++)
+	{
+		TEST_Float(Value, Decimals, 0, ' ');
+	}
+	uint8_t Width = (uint8_t)(TEST_Random() % (TEST_MAX_WIDTH + 1U));
+	uint8_t Decimals = (uint8_t)(TEST_Random() % (FMT_MAX_DECIMALS + 1U));
+	TEST_Float(Value, Decimals, Width, ' ');
+	TEST_Float(Value, Decimals, Width, '0');
+}
+
+static void TEST_Floats(void)
+{
+	uint64_t Before = Mismatches;
+
+	for (size_t i = 0; i < sizeof(Specials) / sizeof(Specials[0]); i++)
+	{
+		for (uint8_t Width = 0; Width <= TEST_MAX_WIDTH; Width += 4)
+		{
+			for (uint8_t Decimals = 0; Decimals <= FMT_MAX_DECIMALS; Decimals++)
+			{
+				TEST_Float(Specials[i], Decimals, Width, ' ');
+				TEST_Float(Specials[i], Decimals, Width, '0');
+			}
+		}
+	}
+
+	for (uint32_t i = 0; i < TEST_RANDOM_FLOATS; i++)
+	{
+		// Every binade: random bit patterns, limited to finite values below the limit
+		uint32_t Bits = (uint32_t)TEST_Random();
+		float Value;
+		memcpy(&Value, &Bits, sizeof(Value));
+		if (isfinite(Value) && fabs((double)Value) < FMT_FLOAT_LIMIT) TEST_FloatAll(Value);
+
+		// The display range, where ties at few decimals are common
+		Value = (float)((double)(TEST_Random() >> 11) * (1.0 / 9007199254740992.0) * 400.0 - 200.0);
+		TEST_FloatAll(Value);
+
+		// Values on a decimal grid hit the round half to even cases
+		Value = (float)((int32_t)(TEST_Random() % 2000001U) - 1000000) / 1000.0f;
+		TEST_FloatAll(Value);
+	}
+	TEST_CHECK(Mismatches == Before, "FMT_Float: %llu mismatches against snprintf",
+			(unsigned long long)(Mismatches - Before));
+}
+
+static void TEST_Int(int32_t Value, uint8_t Width, char Pad)
+{
+	char Expected[64], Got[64], What[64];
+	FMT_HandleTypeDef hfmt;
+
+	snprintf(Expected, sizeof(Expected), (Pad == '0') ? "%0*d" : "%*d", Width, (int)Value);
+	FMT_Init(&hfmt, Got, sizeof(Got));
+	size_t Length = FMT_Int(&hfmt, Value, Width, Pad);
+	snprintf(What, sizeof(What), "FMT_Int(%d, %u, '%c')", (int)Value, Width, Pad);
+	TEST_Compare(Expected, Got, Length, What);
+}
+
+static void TEST_UInt(uint32_t Value, uint8_t Width, char Pad)
+{
+	char Expected[64], Got[64], What[64];
+	FMT_HandleTypeDef hfmt;
+
+	snprintf(Expected, sizeof(Expected), (Pad == '0') ? "%0*u" : "%*u", Width, (unsigned)Value);
+	FMT_Init(&hfmt, Got, sizeof(Got));
+	size_t Length = FMT_UInt(&hfmt, Value, Width, Pad);
+	snprintf(What, sizeof(What), "FMT_UInt(%u, %u, '%c')", (unsigned)Value, Width, Pad);
+	TEST_Compare(Expected, Got, Length, What);
+}
+
+static void TEST_Ints(void)
+{
+	static const int32_t Specials[] = { 0, 1, -1, 9, 10, -10, 99, 100, 999999999, 1000000000, -1000000000, INT32_MAX, INT32_MIN };
+	uint64_t Before = Mismatches;
+
+	for (size_t i = 0; i < sizeof(Specials) / sizeof(Specials[0]); i++)
+	{
+		for (uint8_t Width = 0; Width <= TEST_MAX_WIDTH; Width++)
+		{
+			TEST_Int(Specials[i], Width, ' ');
+			TEST_Int(Specials[i], Width, '0');
+			TEST_UInt((uint32_t)Specials[i], Width, ' ');
+			TEST_UInt((uint32_t)Specials[i], Width, '0');
+		}
+	}
+	for (uint32_t i = 0; i < TEST_RANDOM_INTS; i++)
+	{
+		uint64_t r = TEST_Random();
+		// Spread over all magnitudes, not only ten-digit values
+		uint32_t Value = (uint32_t)r >> (uint32_t)((r >> 32) % 32U);
+		uint8_t Width = (uint8_t)((r >> 40) % (TEST_MAX_WIDTH + 1U));
+		char Pad = ((r >> 48) & 1U) ? '0' : ' ';
+		TEST_UInt(Value, Width, Pad);
+		TEST_Int((r >> 49) & 1U ? (int32_t)(0U - Value) : (int32_t)Value, Width, Pad);
+	}
+	TEST_CHECK(Mismatches == Before, "FMT_Int/FMT_UInt: %llu mismatches against snprintf",
+			(unsigned long long)(Mismatches - Before));
+}
+
+/**
+ * @brief NaN and infinities are padded with spaces even with '0', as printf does.
+ */
+static void TEST_NonFinite(void)
+{
+	uint64_t Before = Mismatches;
+
+	for (uint8_t Width = 0; Width <= 8; Width++)
+	{
+		for (uint8_t Decimals = 0; Decimals <= FMT_MAX_DECIMALS; Decimals += 3)
+		{
+			TEST_Float(NAN, Decimals, Width, ' ');
+			TEST_Float(NAN, Decimals, Width, '0');
+			TEST_Float(INFINITY, Decimals, Width, ' ');
+			TEST_Float(INFINITY, Decimals, Width, '0');
+			TEST_Float(-INFINITY, Decimals, Width, ' ');
+			TEST_Float(-INFINITY, Decimals, Width, '0');
+		}
+	}
+	TEST_CHECK(Mismatches == Before, "FMT_Float: %llu mismatches on NaN/inf", (unsigned long long)(Mismatches - Before));
+
+	// The sign of a NaN is not printed
+	char Buf[8];
+	FMT_HandleTypeDef hfmt;
+	FMT_Init(&hfmt, Buf, sizeof(Buf));
+	FMT_Float(&hfmt, -NAN, 1, 0, ' ');
+	TEST_CHECK(strcmp(Buf, "nan") == 0, "-NAN printed as \"%s\"", Buf);
+}
+
+/**
+ * @brief |Value| >= FMT_FLOAT_LIMIT fills the field, at least one cell, with '#'.
+ */
+static void TEST_Overflow(void)
+{
+	static const float Values[] = { 4294967296.0f, -4294967296.0f, 4294967296.0f * 1.0000001f, 1e10f, -1e20f, FLT_MAX, -FLT_MAX };
+	char Buf[32], Expected[32];
+	FMT_HandleTypeDef hfmt;
+
+	for (size_t i = 0; i < sizeof(Values) / sizeof(Values[0]); i++)
+	{
+		for (uint8_t Width = 0; Width <= TEST_MAX_WIDTH; Width++)
+		{
+			size_t n = (Width > 0) ? Width : 1U;
+			memset(Expected, '#', n);
+			Expected[n] = '\0';
+			FMT_Init(&hfmt, Buf, sizeof(Buf));
+			size_t Length = FMT_Float(&hfmt, Values[i], 2, Width, '0');
+			TEST_CHECK(strcmp(Buf, Expected) == 0 && Length == n, "FMT_Float(%g, 2, %u) gave \"%s\"",
+					(double)Values[i], Width, Buf);
+		}
+	}
+}
+
+/**
+ * @brief Output is cut at the end of the buffer and stays null-terminated.
+ */
+static void TEST_Truncation(void)
+{
+	char Buf[8];
+	FMT_HandleTypeDef hfmt;
+
+	memset(Buf, 'x', sizeof(Buf));
+	FMT_Init(&hfmt, Buf, sizeof(Buf));
+	FMT_String(&hfmt, "T: ");
+	size_t Length = FMT_Float(&hfmt, -123.456f, 3, 0, ' ');
+	TEST_CHECK(strcmp(Buf, "T: -123") == 0, "truncated text \"%s\"", Buf);
+	TEST_CHECK_EQ(Length, sizeof(Buf) - 1U);
+	TEST_CHECK_EQ(FMT_Char(&hfmt, 'C'), sizeof(Buf) - 1U);
+	TEST_CHECK_EQ(FMT_UInt(&hfmt, 42U, 4, '0'), sizeof(Buf) - 1U);
+
+	// A one-byte buffer only ever holds the terminator
+	char One[1] = { 'x' };
+	FMT_Init(&hfmt, One, sizeof(One));
+	TEST_CHECK_EQ(FMT_Int(&hfmt, -5, 3, ' '), 0);
+	TEST_CHECK_EQ(One[0], '\0');
+
+	// Pieces append to one line, as the LCD and UART paths build them
+	char Line[32];
+	FMT_Init(&hfmt, Line, sizeof(Line));
+	FMT_String(&hfmt, "T: ");
+	FMT_Float(&hfmt, 25.04f, 1, 5, ' ');
+	FMT_String(&hfmt, ", PWM: ");
+	FMT_Int(&hfmt, 7, 3, ' ');
+	FMT_Char(&hfmt, '%');
+	TEST_CHECK(strcmp(Line, "T:  25.0, PWM:   7%") == 0, "composed line \"%s\"", Line);
+}
+
+/* Public functions ----------------------------------------------------------*/
+
+int main(void)
+{
+	TEST_Floats();
+	TEST_Ints();
+	TEST_NonFinite();
+	TEST_Overflow();
+	TEST_Truncation();
+	printf("fmt: %llu outputs compared with snprintf, %llu mismatches\n",
+			(unsigned long long)Compared, (unsigned long long)Mismatches);
+	return TEST_RESULT();
+}
@@ -0,0 +1,376 @@
+/**
+  ******************************************************************************
+  * @file     : test_i2c_lcd.c
+  * @author   : MS    Mateusz.Stasiak@student.put.poznan.pl
+  * @version  : 1.0.0
+  * @date     : Oct 17, 2026
+  * @brief    : Transfer queue of the I2C LCD driver against a decoded HD44780.
+  *
+  *             The HAL stub only records the started I2C transfers and the wait
+  *             timer. TEST_Pump plays the interrupts: it feeds every finished
+  *             transfer to the HD44780 model and calls the driver callbacks until
+  *             the queue drains, so the display content can be compared with
+  *             what the driver was asked to show.
+  *
+  ******************************************************************************
+  */
+
+/* Private includes ----------------------------------------------------------*/
+#include <string.h>
+#include "test.h"
+#include "i2c_lcd.h"
+#include "hd44780.h"
+
+/* Private typedef -----------------------------------------------------------*/
+
+/* Private define ------------------------------------------------------------*/
+#define TEST_LCD_COLS      16
+#define TEST_LCD_ROWS      2
+#define TEST_MAX_EVENTS    256
+#define TEST_PUMP_LIMIT    10000  // callbacks before the queue is assumed stuck
+
+/* Private macro -------------------------------------------------------------*/
+
+/* Private variables ---------------------------------------------------------*/
+static I2C_HandleTypeDef hi2c;
+static TIM_HandleTypeDef htim;
+static I2C_LCD_HandleTypeDef hlcd = I2C_LCD_INIT_HANDLE(&hi2c, &htim, 0x27, TEST_LCD_COLS, TEST_LCD_ROWS);
+static HD44780_ModelTypeDef lcd;
+
+static uint32_t Waits[TEST_MAX_EVENTS];      // wait timer periods in start order [us]
+static uint16_t Sizes[TEST_MAX_EVENTS];      // written transfer sizes in start order [bytes]
+static uint32_t nWaits, nSizes, Idles;
+static uint32_t nReads;                      // busy flag reads completed
+static uint8_t FailReads;                    // deliver an error instead of the read completion
+
+/* Private function prototypes -----------------------------------------------*/
+
+/* Private functions ---------------------------------------------------------*/
+
+/**
+ * @brief Completes transfers and waits as the interrupts would, until the driver is idle.
+ * @return Number of callbacks delivered.
+ */
+static uint32_t TEST_Pump(void)
+{
+	uint32_t n = 0;
+
+	for (; n < TEST_PUMP_LIMIT; n++)
+	{
+		if (hi2c.Busy)
+		{
+			hi2c.Busy = 0;
+			if (hi2c.Receive)
+			{
+				if (FailReads)
+				{
+					I2C_LCD_ErrorCallback(&hlcd);
+					continue;
+				}
+				nReads++;
+				I2C_LCD_RxCpltCallback(&hlcd);
+				continue;
+			}
+			HD44780_Write(&lcd, hi2c.pBuffPtr, hi2c.XferSize);
+			if (nSizes < TEST_MAX_EVENTS) Sizes[nSizes++] = hi2c.XferSize;
+			I2C_LCD_TxCpltCallback(&hlcd);
+		}
+		else if (htim.Running)
+		{
+			if (nWaits < TEST_MAX_EVENTS) Waits[nWaits++] = htim.ARR;
+			I2C_LCD_WaitElapsedCallback(&hlcd);
+		}
+		else
+		{
+			break;
+		}
+	}
+	TEST_CHECK(n < TEST_PUMP_LIMIT, "queue did not drain");
+	TEST_CHECK(!I2C_LCD_IsBusy(&hlcd), "driver busy after the queue drained");
+	return n;
+}
+
+static void TEST_ClearLog(void)
+{
+	nWaits = nSizes = nReads = 0;
+}
+
+/**
+ * @brief Checks that the modelled display shows exactly the shadow framebuffer.
+ */
+static void TEST_CheckScreen(const char* Where)
+{
+	for (uint8_t Row = 0; Row < TEST_LCD_ROWS; Row++)
+	{
+		for (uint8_t Col = 0; Col < TEST_LCD_COLS; Col++)
+		{
+			char Shown = HD44780_Cell(&lcd, Col, Row);
+			TEST_CHECK(Shown == hlcd.Shadow[Row][Col], "%s: cell %u,%u shows 0x%02X, expected 0x%02X",
+					Where, Col, Row, (uint8_t)Shown, (uint8_t)hlcd.Shadow[Row][Col]);
+		}
+	}
+	TEST_CHECK(lcd.Errors == 0, "%s: %u interface errors", Where, lcd.Errors);
+}
+
+/**
+ * @brief Starts the display from power on and drains the init sequence.
+ */
+static void TEST_Start(void)
+{
+	memset(&hi2c, 0, sizeof(hi2c));
+	memset(&htim, 0, sizeof(htim));
+	HD44780_Init(&lcd);
+	hlcd.BusyPolling = 0;
+	I2C_LCD_Init(&hlcd);
+	TEST_Pump();
+	TEST_ClearLog();
+}
+
+static void TEST_Init(void)
+{
+	static const uint32_t Expected[] = { 50000, 5000, 5000, 150, 2000 };
+
+	memset(&hi2c, 0, sizeof(hi2c));
+	memset(&htim, 0, sizeof(htim));
+	HD44780_Init(&lcd);
+	TEST_ClearLog();
+	Idles = 0;
+
+	I2C_LCD_Init(&hlcd);
+	TEST_CHECK(I2C_LCD_IsBusy(&hlcd), "init must return with the sequence queued");
+	TEST_CHECK(hi2c.Busy, "init must start the first transfer");
+
+	TEST_Pump();
+	TEST_CHECK_EQ(nWaits, sizeof(Expected) / sizeof(Expected[0]));
+	for (uint32_t i = 0; i < nWaits && i < sizeof(Expected) / sizeof(Expected[0]); i++)
+	{
+		TEST_CHECK(Waits[i] == Expected[i], "init wait %u is %u us, expected %u us", i, Waits[i], Expected[i]);
+	}
+	TEST_CHECK(lcd.FourBit, "interface not switched to 4-bit mode");
+	TEST_CHECK_EQ(lcd.DisplayCtrl, 0x04);
+	TEST_CHECK_EQ(lcd.Pins & 0x08, 0x08);
+	TEST_CHECK_EQ(Idles, 1);
+	TEST_CHECK_EQ(hlcd.Dropped, 0);
+	TEST_CHECK_EQ(hlcd.Errors, 0);
+	TEST_CheckScreen("init");
+}
+
+static void TEST_Ordering(void)
+{
+	TEST_Start();
+
+	// Everything below is queued behind the first transfer, which stays in flight
+	I2C_LCD_SetCursor(&hlcd, 0, 0);
+	TEST_CHECK(hi2c.Busy, "no transfer in flight");
+	I2C_LCD_WriteString(&hlcd, "Temp");
+	I2C_LCD_SetCursor(&hlcd, 3, 1);
+	I2C_LCD_WriteString(&hlcd, "PWM 42%");
+	I2C_LCD_WriteChar(&hlcd, '!');
+	TEST_CHECK(I2C_LCD_IsBusy(&hlcd), "queue drained without interrupts");
+
+	TEST_Pump();
+	TEST_CheckScreen("ordering");
+	TEST_CHECK(memcmp(hlcd.Shadow[1], "   PWM 42%!     ", TEST_LCD_COLS) == 0, "shadow not updated by direct writes");
+}
+
+static void TEST_Overflow(void)
+{
+	TEST_Start();
+
+	// 70 commands while the first one is still on the bus: the queue keeps 64
+	uint32_t Dropped = hlcd.Dropped;
+	for (int i = 0; i < 70; i++) I2C_LCD_Display(&hlcd);
+	TEST_CHECK_EQ(hlcd.Dropped - Dropped, 70 - I2C_LCD_QUEUE_SIZE);
+	TEST_CHECK_EQ(hlcd.CursorRow, I2C_LCD_CURSOR_UNKNOWN);
+	TEST_Pump();
+	TEST_CHECK_EQ(lcd.Errors, 0);
+
+	// A flush that does not fit leaves the cells dirty, the next one completes them
+	for (int i = 0; i < 50; i++) I2C_LCD_Display(&hlcd);
+	I2C_LCD_Print(&hlcd, 0, 0, "0123456789ABCDEF");
+	I2C_LCD_Print(&hlcd, 0, 1, "fedcba9876543210");
+	TEST_CHECK_EQ(I2C_LCD_Flush(&hlcd), 0);
+	TEST_Pump();
+	TEST_CHECK_EQ(I2C_LCD_Flush(&hlcd), 2 * TEST_LCD_COLS);
+	TEST_Pump();
+	TEST_CheckScreen("overflow");
+	TEST_CHECK_EQ(hlcd.Dropped - Dropped, 70 - I2C_LCD_QUEUE_SIZE);
+}
+
+static void TEST_Flush(void)
+{
+	TEST_Start();
+
+	I2C_LCD_Print(&hlcd, 0, 0, "T: 25.0 C");
+	I2C_LCD_Print(&hlcd, 0, 1, "SP: 30.0 C");
+	TEST_CHECK_EQ(I2C_LCD_Flush(&hlcd), 9 + 10);
+	TEST_Pump();
+	TEST_CheckScreen("flush");
+
+	// Nothing changed: no transfer at all
+	uint32_t Transfers = hi2c.TxTransfers;
+	TEST_CHECK_EQ(I2C_LCD_Flush(&hlcd), 0);
+	TEST_CHECK_EQ(hi2c.TxTransfers, Transfers);
+
+	// One cell: one cursor move and one character
+	TEST_ClearLog();
+	I2C_LCD_Print(&hlcd, 5, 0, "1");
+	TEST_CHECK_EQ(I2C_LCD_Flush(&hlcd), 1);
+	TEST_Pump();
+	TEST_CHECK_EQ(nSizes, 1);
+	TEST_CHECK_EQ(Sizes[0], 2 * I2C_LCD_FRAME_SIZE);
+	TEST_CheckScreen("flush one cell");
+
+	// Two cells one apart are merged into one run over the unchanged one
+	I2C_LCD_Print(&hlcd, 0, 1, "sp");
+	I2C_LCD_Print(&hlcd, 3, 1, "4");
+	TEST_CHECK_EQ(I2C_LCD_Flush(&hlcd), 4);
+	TEST_Pump();
+	TEST_CheckScreen("flush merged run");
+}
+
+static void TEST_Burst(void)
+{
+	TEST_Start();
+	I2C_LCD_SetCursor(&hlcd, 0, 0);
+	TEST_Pump();
+
+	// A string leaves as one transfer of whole frames: data, data|EN, data per nibble
+	static const uint8_t FrameA[I2C_LCD_FRAME_SIZE] = { 0x49, 0x4D, 0x49, 0x19, 0x1D, 0x19 };
+	uint32_t Transfers = hi2c.TxTransfers;
+	I2C_LCD_WriteString(&hlcd, "AAAAAAAAAA");
+	TEST_CHECK_EQ(hi2c.TxTransfers - Transfers, 1);
+	TEST_CHECK_EQ(hi2c.XferSize, 10 * I2C_LCD_FRAME_SIZE);
+	for (int i = 0; i < 10; i++)
+	{
+		TEST_CHECK(memcmp(&hi2c.pBuffPtr[i * I2C_LCD_FRAME_SIZE], FrameA, I2C_LCD_FRAME_SIZE) == 0, "frame %d of 'A' differs", i);
+	}
+	TEST_Pump();
+	TEST_CheckScreen("burst");
+
+	// Longer runs are split at I2C_LCD_BURST_MAX entries
+	TEST_ClearLog();
+	I2C_LCD_SetCursor(&hlcd, 0, 0);
+	I2C_LCD_WriteString(&hlcd, "abcdefghijklmnopqrstuvwxy");
+	TEST_Pump();
+	TEST_CHECK_EQ(nSizes, 3);
+	TEST_CHECK_EQ(Sizes[0], 1 * I2C_LCD_FRAME_SIZE);
+	TEST_CHECK_EQ(Sizes[1], I2C_LCD_BURST_MAX * I2C_LCD_FRAME_SIZE);
+	TEST_CHECK_EQ(Sizes[2], (26 - 1 - I2C_LCD_BURST_MAX) * I2C_LCD_FRAME_SIZE);
+	TEST_CHECK_EQ(lcd.Errors, 0);
+
+	// A burst ends after an entry that needs a wait
+	TEST_ClearLog();
+	I2C_LCD_Clear(&hlcd);
+	I2C_LCD_WriteString(&hlcd, "Hi");
+	TEST_Pump();
+	TEST_CHECK_EQ(nSizes, 2);
+	TEST_CHECK_EQ(Sizes[0], I2C_LCD_FRAME_SIZE);
+	TEST_CHECK_EQ(Sizes[1], 2 * I2C_LCD_FRAME_SIZE);
+	TEST_CHECK_EQ(nWaits, 1);
+	TEST_CHECK_EQ(Waits[0], 2000);
+	TEST_CheckScreen("burst after clear");
+
+	// A full frame: two cursor moves and 32 characters in two bursts
+	TEST_ClearLog();
+	Transfers = hi2c.TxTransfers;
+	I2C_LCD_Print(&hlcd, 0, 0, "Temperature 25.0");
+	I2C_LCD_Print(&hlcd, 0, 1, "Duty 42% SP 30.0");
+	TEST_CHECK_EQ(I2C_LCD_Flush(&hlcd), 2 * TEST_LCD_COLS);
+	TEST_Pump();
+	TEST_CHECK_EQ(hi2c.TxTransfers - Transfers, 2);
+	TEST_CHECK_EQ(Sizes[0] + Sizes[1], (2 * TEST_LCD_COLS + 2) * I2C_LCD_FRAME_SIZE);
+	TEST_CheckScreen("burst frame");
+}
+
+static void TEST_BusyFlag(void)
+{
+	TEST_Start();
+
+	// Ready at the first read: the clear is followed by one read round and no timed wait
+	I2C_LCD_SetBusyPolling(&hlcd, 1);
+	hi2c.RxData = 0x00;
+	I2C_LCD_Clear(&hlcd);
+	I2C_LCD_WriteString(&hlcd, "ok");
+	uint32_t LcdReads = lcd.Reads;
+	TEST_Pump();
+	TEST_CHECK_EQ(nReads, 1);
+	TEST_CHECK_EQ(lcd.Reads - LcdReads, 1);
+	TEST_CHECK_EQ(nWaits, 0);
+	TEST_CHECK_EQ(nSizes, 4);
+	TEST_CHECK_EQ(Sizes[1], 2); // RW, RW|EN
+	TEST_CHECK_EQ(Sizes[2], 3); // RW, then the low nibble strobe
+	TEST_CHECK(hlcd.BusyPolling, "polling switched off while BF reads back clear");
+	TEST_CheckScreen("busy flag clear");
+
+	// Standard commands are not polled
+	TEST_ClearLog();
+	I2C_LCD_SetCursor(&hlcd, 0, 1);
+	I2C_LCD_WriteString(&hlcd, "x");
+	TEST_Pump();
+	TEST_CHECK_EQ(nReads, 0);
+
+	// BF stuck high, as with RW not wired: polling gives up and the timed wait follows
+	TEST_ClearLog();
+	hi2c.RxData = 0x80;
+	I2C_LCD_Home(&hlcd);
+	TEST_Pump();
+	TEST_CHECK_EQ(nReads, 8);
+	TEST_CHECK(!hlcd.BusyPolling, "polling still on with BF stuck high");
+	TEST_CHECK_EQ(nWaits, 1);
+	TEST_CHECK_EQ(Waits[0], 2000);
+
+	// From now on the long commands are timed without reads
+	TEST_ClearLog();
+	I2C_LCD_Clear(&hlcd);
+	TEST_Pump();
+	TEST_CHECK_EQ(nReads, 0);
+	TEST_CHECK_EQ(nWaits, 1);
+	TEST_CheckScreen("busy flag stuck");
+
+	// A failed read falls back to the timed wait of the command
+	TEST_ClearLog();
+	I2C_LCD_SetBusyPolling(&hlcd, 1);
+	FailReads = 1;
+	uint32_t Errors = hlcd.Errors;
+	I2C_LCD_Clear(&hlcd);
+	I2C_LCD_WriteString(&hlcd, "err");
+	TEST_Pump();
+	FailReads = 0;
+	TEST_CHECK_EQ(hlcd.Errors - Errors, 1);
+	TEST_CHECK_EQ(nWaits, 1);
+	TEST_CHECK_EQ(Waits[0], 2000);
+	TEST_CheckScreen("busy flag read error");
+
+	// The reset steps stay timed with polling enabled, BF is not valid before 4-bit mode
+	static const uint32_t Expected[] = { 50000, 5000, 5000, 150 };
+	memset(&hi2c, 0, sizeof(hi2c));
+	HD44780_Init(&lcd);
+	TEST_ClearLog();
+	I2C_LCD_SetBusyPolling(&hlcd, 1);
+	I2C_LCD_Init(&hlcd);
+	TEST_Pump();
+	TEST_CHECK_EQ(nWaits, 4);
+	for (uint32_t i = 0; i < nWaits && i < 4; i++) TEST_CHECK_EQ(Waits[i], Expected[i]);
+	TEST_CHECK_EQ(nReads, 1);
+	TEST_CheckScreen("busy flag init");
+}
+
+/* Public functions ----------------------------------------------------------*/
+
+void I2C_LCD_IdleCallback(I2C_LCD_HandleTypeDef* hi2c_lcd)
+{
+	(void)hi2c_lcd;
+	Idles++;
+}
+
+int main(void)
+{
+	TEST_Init();
+	TEST_Ordering();
+	TEST_Overflow();
+	TEST_Flush();
+	TEST_Burst();
+	TEST_BusyFlag();
+	return TEST_RESULT();
+}
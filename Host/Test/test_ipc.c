@@ -0,0 +1,299 @@
+/**
+  ******************************************************************************
+  * @file     : test_ipc.c
+  * @author   : MS    Mateusz.Stasiak@student.put.poznan.pl
+  * @version  : 1.0.0
+  * @date     : Oct 17, 2026
+  * @brief    : IPC ring layout, index wrap-around and a two-thread stress run.
+  *
+  *             A producer thread pushes numbered items while the consumer pops
+  *             them with irregular pauses, so the ring runs both empty and full.
+  *             Blocks of items alternate between dropping a refused push and
+  *             retrying it; every item must arrive exactly once, in order and
+  *             intact, or be one of the counted drops. The free-running indices
+  *             start just below 2^32 so they wrap during the run.
+  *
+  ******************************************************************************
+  */
+
+/* Private includes ----------------------------------------------------------*/
+#include <string.h>
+#include <stddef.h>
+#include <pthread.h>
+#include <sched.h>
+#include "test.h"
+#include "ipc.h"
+
+/* Private typedef -----------------------------------------------------------*/
+typedef struct {
+	uint32_t Seq;
+	uint32_t Words[8];
+	uint32_t Sum;
+} TEST_ItemTypeDef; // 40 B, so each slot has 24 B of padding
+
+/* Private define ------------------------------------------------------------*/
+#define TEST_RING_SIZE   16U
+#define TEST_SEM_ID      5U
+#define TEST_ITEMS       (1U << 22)
+#define TEST_BLOCK       4096U        // items per drop or retry block
+#define TEST_START       0xFFFFFFF0U  // initial Head and Tail
+#define TEST_PAD         0xA5U        // fill of the slot padding
+
+#define TEST_NONE        0U
+#define TEST_RECEIVED    1U
+#define TEST_LOST        2U
+
+/* Private macro -------------------------------------------------------------*/
+
+/* Private variables ---------------------------------------------------------*/
+IPC_RING_DEFINE(test_ring, sizeof(TEST_ItemTypeDef), TEST_RING_SIZE);
+static IPC_HandleTypeDef hipc = IPC_INIT_HANDLE(test_ring, sizeof(TEST_ItemTypeDef), TEST_SEM_ID);
+
+static uint8_t State[TEST_ITEMS];
+static uint32_t Refused;             // HAL_BUSY returns seen by the producer
+static uint32_t Lost;                // items given up after a refusal
+static volatile uint32_t Done;
+
+/* Private function prototypes -----------------------------------------------*/
+
+/* Private functions ---------------------------------------------------------*/
+
+static void TEST_Fill(TEST_ItemTypeDef* Item, uint32_t Seq)
+{
+	Item->Seq = Seq;
+	Item->Sum = Seq;
+	for (uint32_t i = 0; i < 8; i++)
+	{
+		Item->Words[i] = (Seq * 2654435761U) ^ (i * 0x01010101U);
+		Item->Sum += Item->Words[i];
+	}
+}
+
+static uint8_t TEST_Intact(const TEST_ItemTypeDef* Item)
+{
+	TEST_ItemTypeDef Expected;
+
+	TEST_Fill(&Expected, Item->Seq);
+	return memcmp(Item, &Expected, sizeof(Expected)) == 0;
+}
+
+/**
+ * @brief Starts an empty ring with both indices at Start and marked slot padding.
+ */
+static void TEST_Reset(uint32_t Start)
+{
+	IPC_Init(&hipc);
+	memset(test_ring.Data, TEST_PAD, sizeof(test_ring.Data));
+	test_ring.Ring.Head = Start;
+	test_ring.Ring.Tail = Start;
+}
+
+/**
+ * @brief Checks that nothing was written outside the indices and the item bytes.
+ */
+static void TEST_CheckPadding(void)
+{
+	const IPC_RingTypeDef *Ring = &test_ring.Ring;
+	uint32_t Bad = 0;
+
+	for (uint32_t i = 0; i < sizeof(Ring->Reserved0); i++) Bad += Ring->Reserved0[i] != 0;
+	for (uint32_t i = 0; i < sizeof(Ring->Reserved1); i++) Bad += Ring->Reserved1[i] != 0;
+	for (uint32_t i = 0; i < sizeof(Ring->Reserved2); i++) Bad += Ring->Reserved2[i] != 0;
+	TEST_CHECK_EQ(Bad, 0);
+
+	Bad = 0;
+	for (uint32_t s = 0; s < TEST_RING_SIZE; s++)
+	{
+		for (uint32_t i = sizeof(TEST_ItemTypeDef); i < hipc.Stride; i++)
+		{
+			Bad += test_ring.Data[s * hipc.Stride + i] != TEST_PAD;
+		}
+	}
+	TEST_CHECK_EQ(Bad, 0);
+}
+
+static void TEST_Layout(void)
+{
+	// Head, Tail and every slot each start a cache line of their own
+	TEST_CHECK_EQ(offsetof(IPC_RingTypeDef, Head), IPC_CACHE_LINE);
+	TEST_CHECK_EQ(offsetof(IPC_RingTypeDef, Dropped), IPC_CACHE_LINE + 4U);
+	TEST_CHECK_EQ(offsetof(IPC_RingTypeDef, Tail), 2U * IPC_CACHE_LINE);
+	TEST_CHECK_EQ(sizeof(IPC_RingTypeDef), 3U * IPC_CACHE_LINE);
+	TEST_CHECK_EQ((uintptr_t)&test_ring % IPC_CACHE_LINE, 0);
+	TEST_CHECK_EQ((uintptr_t)test_ring.Data % IPC_CACHE_LINE, 0);
+
+	TEST_CHECK_EQ(hipc.Stride, 2U * IPC_CACHE_LINE);
+	TEST_CHECK_EQ(hipc.Count, TEST_RING_SIZE);
+	TEST_CHECK_EQ(sizeof(test_ring.Data), TEST_RING_SIZE * hipc.Stride);
+
+	// The consumer accepts only the geometry it was built with
+	TEST_CHECK_EQ(IPC_IsReady(&hipc), 0);
+	IPC_Init(&hipc);
+	TEST_CHECK_EQ(IPC_IsReady(&hipc), 1);
+	IPC_HandleTypeDef Other = hipc;
+	Other.Count = TEST_RING_SIZE / 2U;
+	TEST_CHECK_EQ(IPC_IsReady(&Other), 0);
+	Other = hipc;
+	Other.Stride = IPC_CACHE_LINE;
+	TEST_CHECK_EQ(IPC_IsReady(&Other), 0);
+}
+
+/**
+ * @brief Fills and drains the ring in one thread while the indices wrap past 2^32.
+ */
+static void TEST_Wrap(void)
+{
+	TEST_ItemTypeDef Item;
+	uint32_t Seq = 0, Next = 0;
+
+	TEST_Reset(TEST_START);
+	TEST_CHECK_EQ(IPC_Pop(&hipc, &Item), 0);
+
+	for (uint32_t Round = 0; Round < 4; Round++)
+	{
+		for (uint32_t i = 0; i < TEST_RING_SIZE; i++)
+		{
+			TEST_Fill(&Item, Seq++);
+			TEST_CHECK_EQ(IPC_Push(&hipc, &Item), HAL_OK);
+		}
+		TEST_CHECK_EQ(IPC_Pending(&hipc), TEST_RING_SIZE);
+
+		// A full ring refuses and counts the push, and keeps what it holds
+		TEST_Fill(&Item, 0xDEADU);
+		TEST_CHECK_EQ(IPC_Push(&hipc, &Item), HAL_BUSY);
+		TEST_CHECK_EQ(test_ring.Ring.Dropped, Round + 1U);
+
+		// Leave part of the ring filled so the next round starts mid-ring
+		uint32_t Keep = Round & 1U ? 0U : 5U;
+		while (IPC_Pending(&hipc) > Keep)
+		{
+			TEST_CHECK_EQ(IPC_Pop(&hipc, &Item), 1);
+			TEST_CHECK(Item.Seq == Next && TEST_Intact(&Item), "item %u, expected %u", Item.Seq, Next);
+			Next++;
+		}
+		while (IPC_Pending(&hipc) < TEST_RING_SIZE)
+		{
+			TEST_Fill(&Item, Seq++);
+			TEST_CHECK_EQ(IPC_Push(&hipc, &Item), HAL_OK);
+		}
+		while (IPC_Pop(&hipc, &Item))
+		{
+			TEST_CHECK(Item.Seq == Next && TEST_Intact(&Item), "item %u, expected %u", Item.Seq, Next);
+			Next++;
+		}
+	}
+
+	TEST_CHECK_EQ(Next, Seq);
+	TEST_CHECK_EQ(test_ring.Ring.Head, TEST_START + Seq);
+	TEST_CHECK_EQ(test_ring.Ring.Tail, test_ring.Ring.Head);
+	TEST_CHECK(test_ring.Ring.Head < TEST_START, "indices did not wrap");
+	TEST_CheckPadding();
+}
+
+static void* TEST_Producer(void* Arg)
+{
+	TEST_ItemTypeDef Item;
+
+	(void)Arg;
+	for (uint32_t Seq = 0; Seq < TEST_ITEMS; Seq++)
+	{
+		uint8_t Retry = (Seq / TEST_BLOCK) & 1U;
+
+		TEST_Fill(&Item, Seq);
+		while (IPC_Push(&hipc, &Item) != HAL_OK)
+		{
+			Refused++;
+			if (!Retry)
+			{
+				State[Seq] = TEST_LOST;
+				Lost++;
+				break;
+			}
+			sched_yield();
+		}
+	}
+	__DMB();
+	Done = 1;
+	return NULL;
+}
+
+/**
+ * @brief Pops everything the producer thread pushes, pausing now and then.
+ */
+static void TEST_Stress(void)
+{
+	pthread_t Producer;
+	TEST_ItemTypeDef Item;
+	uint32_t Received = 0, Torn = 0, Duplicated = 0, Unordered = 0;
+	int64_t Last = -1;
+
+	TEST_Reset(TEST_START - TEST_ITEMS / 2U);
+	memset(State, TEST_NONE, sizeof(State));
+	Done = 0;
+	TEST_CHECK_EQ(pthread_create(&Producer, NULL, TEST_Producer, NULL), 0);
+
+	for (;;)
+	{
+		if (!IPC_Pop(&hipc, &Item))
+		{
+			if (Done)
+			{
+				__DMB();
+				if (!IPC_Pop(&hipc, &Item)) break;
+			}
+			else
+			{
+				sched_yield(); // the HSEM interrupt on the target
+				continue;
+			}
+		}
+
+		if (!TEST_Intact(&Item) || Item.Seq >= TEST_ITEMS)
+		{
+			Torn++;
+			continue;
+		}
+		if ((int64_t)Item.Seq <= Last) Unordered++;
+		if (State[Item.Seq] != TEST_NONE) Duplicated++;
+		State[Item.Seq] = TEST_RECEIVED;
+		Last = Item.Seq;
+		Received++;
+
+		// A slow reader lets the ring fill up
+		if ((Item.Seq & 0x3FU) == 0)
+		{
+			for (volatile uint32_t i = 0; i < 2000U; i++);
+		}
+	}
+	pthread_join(Producer, NULL);
+
+	uint32_t Missing = 0;
+	for (uint32_t Seq = 0; Seq < TEST_ITEMS; Seq++) Missing += State[Seq] == TEST_NONE;
+
+	printf("IPC stress: %u items, %u received, %u dropped, %u refused pushes\n",
+			TEST_ITEMS, Received, Lost, Refused);
+	TEST_CHECK_EQ(Torn, 0);
+	TEST_CHECK_EQ(Unordered, 0);
+	TEST_CHECK_EQ(Duplicated, 0);
+	TEST_CHECK_EQ(Missing, 0);
+	TEST_CHECK_EQ(Received + Lost, TEST_ITEMS);
+	TEST_CHECK_EQ(test_ring.Ring.Dropped, Refused);
+	TEST_CHECK_EQ(test_ring.Ring.Head, TEST_START - TEST_ITEMS / 2U + Received);
+	TEST_CHECK_EQ(test_ring.Ring.Tail, test_ring.Ring.Head);
+	TEST_CHECK_EQ(IPC_Pending(&hipc), 0);
+	TEST_CheckPadding();
+
+	// Both the dropping and the retrying blocks must have met a full ring
+	TEST_CHECK(Lost > 0, "the ring never filled in a dropping block");
+	TEST_CHECK(Refused > Lost, "the ring never filled in a retrying block");
+}
+
+/* Public functions ----------------------------------------------------------*/
+
+int main(void)
+{
+	TEST_Layout();
+	TEST_Wrap();
+	TEST_Stress();
+	return TEST_RESULT();
+}
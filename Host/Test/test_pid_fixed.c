@@ -0,0 +1,128 @@
+/**
+  ******************************************************************************
+  * @file     : test_pid_fixed.c
+  * @author   : MS    Mateusz.Stasiak@student.put.poznan.pl
+  * @version  : 1.0.0
+  * @date     : Oct 17, 2026
+  * @brief    : Equivalence of the float and PID_USE_FIXED_POINT controllers.
+  *
+  *             The float controller closes the loop around the thermal plant
+  *             model for a long run of setpoint steps with sensor noise. The
+  *             Q16.16 controller sees the same measurements, the same setpoints
+  *             and its own saturated output fed back, and its output must stay
+  *             within PID_FIXED_TOLERANCE of the float one at every step.
+  *
+  ******************************************************************************
+  */
+
+/* Private includes ----------------------------------------------------------*/
+#include <math.h>
+#include "test.h"
+#include "pid.h"
+#include "pid_q16.h"
+#include "plant.h"
+
+/* Private typedef -----------------------------------------------------------*/
+
+/* Private define ------------------------------------------------------------*/
+#define PID_FIXED_HOURS      200.0f
+#define PID_FIXED_PERIOD     0.1f    // [s], control period of Control_Task
+#define PID_FIXED_STEP       1800.0f // [s], time between setpoint changes
+#define PID_FIXED_NOISE      0.05f   // [degC rms] on the measurement
+#define PID_FIXED_TOLERANCE  0.05f   // [%], max |u_float - u_fixed|, half a TIM3 compare step (ARR 999)
+
+/* Private macro -------------------------------------------------------------*/
+
+/* Private variables ---------------------------------------------------------*/
+static const float SetPoints[] = { 30.0f, 45.0f, 60.0f, 35.0f, 50.0f, 25.0f };
+
+/* Private function prototypes -----------------------------------------------*/
+
+/* Private functions ---------------------------------------------------------*/
+
+/**
+ * @brief Approximately normal noise with unit variance (sum of four uniforms).
+ */
+static float TEST_Noise(uint32_t *Seed)
+{
+	float sum = 0.0f;
+	for (int i = 0; i < 4; i++)
+	{
+		*Seed = *Seed * 1664525U + 1013904223U;
+		sum += (float)(*Seed >> 8) * (1.0f / 16777216.0f);
+	}
+	return (sum - 2.0f) * 1.7320508f;
+}
+
+static float TEST_Saturate(float u)
+{
+	return (u > 100.0f) ? 100.0f : (u < 0.0f) ? 0.0f : u;
+}
+
+/* Public functions ----------------------------------------------------------*/
+
+int main(void)
+{
+	PLANT_HandleTypeDef plant = {
+		.Gain = 0.37f, .Tau = 90.0f, .DeadTime = 4.0f, .Ambient = 22.0f, .Ts = PID_FIXED_PERIOD
+	};
+	PID_HandleTypeDef pidf = { 0 };
+	PIDQ_HandleTypeDef *pidq = PIDQ_Create(60, 40, 0.8f, SetPoints[0], 100, 0);
+	uint32_t seed = 1;
+
+	TEST_CHECK(pidq != NULL, "PIDQ_Create");
+	if (pidq == NULL) return TEST_RESULT();
+
+	// Same tuning as hpid1 in CM7/Core/Src/main.c
+	PID_Init(&pidf, 60, 40, 0.8f, SetPoints[0], 100, 0);
+	PID_SetAntiWindup(&pidf, PID_ANTIWINDUP_BACKCALC, 5.0f);
+	PIDQ_SetAntiWindup(pidq, PID_ANTIWINDUP_BACKCALC, 5.0f);
+	PLANT_Init(&plant);
+
+	const uint32_t n_steps = (uint32_t)(PID_FIXED_HOURS * 3600.0f / PID_FIXED_PERIOD);
+	const uint32_t steps_per_sp = (uint32_t)(PID_FIXED_STEP / PID_FIXED_PERIOD);
+	const uint32_t n_sp = sizeof(SetPoints) / sizeof(SetPoints[0]);
+	float max_diff = 0.0f, max_applied_diff = 0.0f;
+	double sum_diff = 0.0;
+	uint32_t max_at = 0, saturated = 0;
+
+	for (uint32_t k = 0; k < n_steps; k++)
+	{
+		if (k % steps_per_sp == 0)
+		{
+			float sp = SetPoints[(k / steps_per_sp) % n_sp];
+			PID_SetReference(&pidf, sp);
+			PIDQ_SetReference(pidq, sp);
+		}
+
+		float y = plant.Temperature + PID_FIXED_NOISE * TEST_Noise(&seed);
+		float uf = PID_CalculateDt(&pidf, y, PID_FIXED_PERIOD);
+		float uq = PIDQ_CalculateDt(pidq, y, PID_FIXED_PERIOD);
+		float af = TEST_Saturate(uf), aq = TEST_Saturate(uq);
+		PID_TrackOutput(&pidf, af);
+		PIDQ_TrackOutput(pidq, aq);
+		if (af != uf) saturated++;
+
+		float diff = fabsf(uf - uq);
+		if (diff > max_diff)
+		{
+			max_diff = diff;
+			max_at = k;
+		}
+		if (fabsf(af - aq) > max_applied_diff) max_applied_diff = fabsf(af - aq);
+		sum_diff += diff;
+
+		PLANT_Step(&plant, af);
+	}
+
+	printf("pid fixed vs float: %u steps (%.0f h), %u saturated\n", n_steps, PID_FIXED_HOURS, saturated);
+	printf("  max |u_float - u_fixed| = %.5f %% at t = %.1f s, mean %.6f %%, tolerance %.5f %%\n",
+			max_diff, max_at * PID_FIXED_PERIOD, sum_diff / n_steps, PID_FIXED_TOLERANCE);
+	printf("  max applied duty difference = %.5f %%\n", max_applied_diff);
+
+	TEST_CHECK(max_diff <= PID_FIXED_TOLERANCE, "max output difference %.5f %% exceeds %.5f %%", max_diff, PID_FIXED_TOLERANCE);
+	TEST_CHECK(max_applied_diff <= PID_FIXED_TOLERANCE, "max applied difference %.5f %% exceeds %.5f %%", max_applied_diff, PID_FIXED_TOLERANCE);
+
+	PIDQ_Destroy(pidq);
+	return TEST_RESULT();
+}
@@ -0,0 +1,282 @@
+/**
+  ******************************************************************************
+  * @file     : test_telemetry.c
+  * @author   : MS    Mateusz.Stasiak@student.put.poznan.pl
+  * @version  : 1.0.0
+  * @date     : Oct 17, 2026
+  * @brief    : Telemetry frames: CRC-16, COBS and the sample codec.
+  *
+  *             Random samples, most of them full of zero bytes, must survive
+  *             an encode / decode round trip bit for bit. COBS is checked on its
+  *             own for blocks around and beyond the 254-byte run limit, and
+  *             every truncated, bit-flipped or malformed frame must be refused
+  *             with its reason.
+  *
+  ******************************************************************************
+  */
+
+/* Private includes ----------------------------------------------------------*/
+#include <string.h>
+#include "test.h"
+#include "telemetry.h"
+
+/* Private typedef -----------------------------------------------------------*/
+
+/* Private define ------------------------------------------------------------*/
+#define TEST_SAMPLES     200000U
+#define TEST_COBS_MAX    1100U    // longest COBS block, more than four full runs
+#define TEST_COBS_RANDOM 20000U
+
+/* Private macro -------------------------------------------------------------*/
+
+/* Private variables ---------------------------------------------------------*/
+static uint64_t Seed = 0x9E3779B97F4A7C15ULL;
+
+/* Private function prototypes -----------------------------------------------*/
+
+/* Private functions ---------------------------------------------------------*/
+
+static uint64_t TEST_Random(void)
+{
+	Seed ^= Seed << 13;
+	Seed ^= Seed >> 7;
+	Seed ^= Seed << 17;
+	return Seed;
+}
+
+/**
+ * @brief A random 32-bit field, zero byte by byte with the given chance in 1/256.
+ */
+static uint32_t TEST_RandomBytes(uint32_t ZeroChance)
+{
+	uint32_t Value = 0;
+
+	for (uint32_t i = 0; i < 4; i++)
+	{
+		uint32_t Byte = (TEST_Random() & 0xFFU) < ZeroChance ? 0U : (uint32_t)(TEST_Random() & 0xFFU);
+		Value |= Byte << (8U * i);
+	}
+	return Value;
+}
+
+static float TEST_RandomFloat(uint32_t ZeroChance)
+{
+	uint32_t Bits = TEST_RandomBytes(ZeroChance);
+	float Value;
+
+	memcpy(&Value, &Bits, sizeof(Value));
+	return Value;
+}
+
+/**
+ * @brief Compares two samples field by field, floats by their bits (NaN included).
+ */
+static uint8_t TEST_SameSample(const TELEMETRY_SampleTypeDef* a, const TELEMETRY_SampleTypeDef* b)
+{
+	return a->Sequence == b->Sequence && a->TimeMs == b->TimeMs && a->AdcRaw == b->AdcRaw && a->Duty == b->Duty &&
+			memcmp(&a->Temperature, &b->Temperature, sizeof(float)) == 0 &&
+			memcmp(&a->SetPoint, &b->SetPoint, sizeof(float)) == 0 &&
+			memcmp(&a->P, &b->P, sizeof(float)) == 0 &&
+			memcmp(&a->I, &b->I, sizeof(float)) == 0 &&
+			memcmp(&a->D, &b->D, sizeof(float)) == 0;
+}
+
+static void TEST_Crc(void)
+{
+	const uint8_t Check[] = "123456789";
+
+	TEST_CHECK_EQ(TELEMETRY_Crc16(Check, 9), 0x29B1);
+	TEST_CHECK_EQ(TELEMETRY_Crc16(Check, 0), 0xFFFF);
+
+	// Bit by bit reference for random lengths
+	uint8_t Data[64];
+	uint32_t Bad = 0;
+	for (uint32_t n = 0; n < 1000U; n++)
+	{
+		size_t Length = (size_t)(TEST_Random() % sizeof(Data));
+		uint16_t Crc = 0xFFFFU;
+		for (size_t i = 0; i < Length; i++)
+		{
+			Data[i] = (uint8_t)TEST_Random();
+			Crc ^= (uint16_t)(Data[i] << 8);
+			for (uint32_t Bit = 0; Bit < 8; Bit++) Crc = (uint16_t)((Crc & 0x8000U) ? (Crc << 1) ^ 0x1021U : Crc << 1);
+		}
+		Bad += TELEMETRY_Crc16(Data, Length) != Crc;
+	}
+	TEST_CHECK_EQ(Bad, 0);
+}
+
+/**
+ * @brief Encodes and decodes one block; the encoded form must be zero-free and within its bound.
+ * @return 1 if the block came back unchanged.
+ */
+static uint8_t TEST_CobsBlock(const uint8_t* In, size_t Length)
+{
+	static uint8_t Encoded[TEST_COBS_MAX + TEST_COBS_MAX / 254U + 1U];
+	static uint8_t Decoded[sizeof(Encoded)];
+
+	size_t EncodedLength = TELEMETRY_CobsEncode(In, Length, Encoded);
+	if (EncodedLength > Length + Length / 254U + 1U) return 0;
+	if (memchr(Encoded, 0, EncodedLength) != NULL) return 0;
+
+	// Decoded in place, as the decoder allows
+	memcpy(Decoded, Encoded, EncodedLength);
+	size_t DecodedLength = TELEMETRY_CobsDecode(Decoded, EncodedLength, Decoded);
+	return DecodedLength == Length && memcmp(Decoded, In, Length) == 0;
+}
+
+static void TEST_Cobs(void)
+{
+	static uint8_t Block[TEST_COBS_MAX];
+	uint32_t Bad = 0;
+
+	// Runs without a zero around the 254-byte limit of one code, and several of them
+	static const size_t Runs[] = { 1, 253, 254, 255, 256, 507, 508, 509, 762, 1016, TEST_COBS_MAX };
+	for (uint32_t r = 0; r < sizeof(Runs) / sizeof(Runs[0]); r++)
+	{
+		for (size_t i = 0; i < Runs[r]; i++) Block[i] = (uint8_t)(1U + TEST_Random() % 255U);
+		TEST_CHECK(TEST_CobsBlock(Block, Runs[r]), "%zu bytes without a zero", Runs[r]);
+
+		// A zero at either end or just past a full run
+		Block[0] = 0;
+		TEST_CHECK(TEST_CobsBlock(Block, Runs[r]), "%zu bytes, zero first", Runs[r]);
+		Block[0] = 1;
+		Block[Runs[r] - 1U] = 0;
+		TEST_CHECK(TEST_CobsBlock(Block, Runs[r]), "%zu bytes, zero last", Runs[r]);
+		if (Runs[r] > 254U)
+		{
+			Block[Runs[r] - 1U] = 1;
+			Block[254] = 0;
+			TEST_CHECK(TEST_CobsBlock(Block, Runs[r]), "%zu bytes, zero after a full run", Runs[r]);
+		}
+	}
+	memset(Block, 0, sizeof(Block));
+	TEST_CHECK(TEST_CobsBlock(Block, TEST_COBS_MAX), "all zero");
+	TEST_CHECK(TEST_CobsBlock(Block, 0), "empty block");
+
+	// Random lengths and zero densities
+	for (uint32_t n = 0; n < TEST_COBS_RANDOM; n++)
+	{
+		size_t Length = (size_t)(TEST_Random() % (TEST_COBS_MAX + 1U));
+		uint32_t ZeroChance = (uint32_t)(TEST_Random() % 4U) * 20U; // 0 %, 8 %, 16 % or 23 % zeros
+		for (size_t i = 0; i < Length; i++)
+		{
+			Block[i] = (TEST_Random() & 0xFFU) < ZeroChance ? 0U : (uint8_t)(1U + TEST_Random() % 255U);
+		}
+		Bad += !TEST_CobsBlock(Block, Length);
+	}
+	TEST_CHECK_EQ(Bad, 0);
+
+	// Malformed blocks
+	uint8_t Out[16];
+	const uint8_t CodeZero[] = { 0x03, 0x11, 0x22, 0x00, 0x33 };   // zero where a code belongs
+	const uint8_t ZeroInside[] = { 0x04, 0x11, 0x00, 0x22 };      // zero inside a run
+	const uint8_t PastEnd[] = { 0x05, 0x11, 0x22 };               // run longer than the block
+	TEST_CHECK_EQ(TELEMETRY_CobsDecode(CodeZero, sizeof(CodeZero), Out), 0);
+	TEST_CHECK_EQ(TELEMETRY_CobsDecode(ZeroInside, sizeof(ZeroInside), Out), 0);
+	TEST_CHECK_EQ(TELEMETRY_CobsDecode(PastEnd, sizeof(PastEnd), Out), 0);
+}
+
+static void TEST_RoundTrip(void)
+{
+	uint8_t Frame[TELEMETRY_FRAME_MAX];
+	uint32_t Bad = 0, Long = 0, Zeros = 0;
+
+	for (uint32_t n = 0; n < TEST_SAMPLES; n++)
+	{
+		uint32_t ZeroChance = (uint32_t)(TEST_Random() % 5U) * 64U; // 0 % .. 100 % zero bytes
+		TELEMETRY_SampleTypeDef In, Out;
+
+		memset(&Out, 0, sizeof(Out));
+		In.Sequence = (uint16_t)TEST_RandomBytes(ZeroChance);
+		In.TimeMs = TEST_RandomBytes(ZeroChance);
+		In.AdcRaw = (uint16_t)TEST_RandomBytes(ZeroChance);
+		In.Duty = (uint16_t)TEST_RandomBytes(ZeroChance);
+		In.Temperature = TEST_RandomFloat(ZeroChance);
+		In.SetPoint = TEST_RandomFloat(ZeroChance);
+		In.P = TEST_RandomFloat(ZeroChance);
+		In.I = TEST_RandomFloat(ZeroChance);
+		In.D = TEST_RandomFloat(ZeroChance);
+
+		size_t Length = TELEMETRY_Encode(&In, Frame);
+		Long += Length > TELEMETRY_FRAME_MAX;
+		Zeros += memchr(Frame, 0, Length - 1U) != NULL || Frame[Length - 1U] != TELEMETRY_DELIMITER;
+		Bad += TELEMETRY_Decode(Frame, Length - 1U, &Out) != TELEMETRY_OK || !TEST_SameSample(&In, &Out);
+	}
+	TEST_CHECK_EQ(Long, 0);
+	TEST_CHECK_EQ(Zeros, 0);
+	TEST_CHECK_EQ(Bad, 0);
+}
+
+/**
+ * @brief Every prefix and every single bit flip of valid frames is refused.
+ */
+static void TEST_Rejection(void)
+{
+	uint8_t Frame[TELEMETRY_FRAME_MAX], Copy[TELEMETRY_FRAME_MAX];
+	uint32_t Accepted = 0, Reasons[TELEMETRY_ERROR_VERSION + 1] = { 0 };
+	TELEMETRY_SampleTypeDef Sample, Out;
+
+	for (uint32_t n = 0; n < 200U; n++)
+	{
+		uint32_t ZeroChance = (uint32_t)(TEST_Random() % 5U) * 64U;
+		Sample.Sequence = (uint16_t)TEST_RandomBytes(ZeroChance);
+		Sample.TimeMs = TEST_RandomBytes(ZeroChance);
+		Sample.AdcRaw = (uint16_t)TEST_RandomBytes(ZeroChance);
+		Sample.Duty = (uint16_t)TEST_RandomBytes(ZeroChance);
+		Sample.Temperature = TEST_RandomFloat(ZeroChance);
+		Sample.SetPoint = TEST_RandomFloat(ZeroChance);
+		Sample.P = TEST_RandomFloat(ZeroChance);
+		Sample.I = TEST_RandomFloat(ZeroChance);
+		Sample.D = TEST_RandomFloat(ZeroChance);
+		size_t Length = TELEMETRY_Encode(&Sample, Frame) - 1U;
+
+		for (size_t Cut = 0; Cut < Length; Cut++)
+		{
+			TELEMETRY_StatusTypeDef Status = TELEMETRY_Decode(Frame, Cut, &Out);
+			Accepted += Status == TELEMETRY_OK;
+			Reasons[Status]++;
+		}
+		for (size_t Bit = 0; Bit < 8U * Length; Bit++)
+		{
+			memcpy(Copy, Frame, Length);
+			Copy[Bit / 8U] ^= (uint8_t)(1U << (Bit % 8U));
+			TELEMETRY_StatusTypeDef Status = TELEMETRY_Decode(Copy, Length, &Out);
+			Accepted += Status == TELEMETRY_OK;
+			Reasons[Status]++;
+		}
+	}
+	TEST_CHECK_EQ(Accepted, 0);
+	TEST_CHECK(Reasons[TELEMETRY_ERROR_COBS] > 0, "no COBS error seen");
+	TEST_CHECK(Reasons[TELEMETRY_ERROR_LENGTH] > 0, "no length error seen");
+	TEST_CHECK(Reasons[TELEMETRY_ERROR_CRC] > 0, "no CRC error seen");
+
+	// Too long to be a frame at all
+	memset(Copy, 0x01, sizeof(Copy));
+	TEST_CHECK_EQ(TELEMETRY_Decode(Copy, sizeof(Copy), &Out), TELEMETRY_ERROR_LENGTH);
+
+	// A correct CRC over an unknown version or frame type
+	uint8_t Raw[TELEMETRY_RAW_SIZE];
+	memset(Raw, 0x11, sizeof(Raw));
+	for (uint32_t Field = 0; Field < 2; Field++)
+	{
+		Raw[0] = Field == 0 ? TELEMETRY_VERSION + 1U : TELEMETRY_VERSION;
+		Raw[1] = Field == 1 ? TELEMETRY_TYPE_SAMPLE + 1U : TELEMETRY_TYPE_SAMPLE;
+		uint16_t Crc = TELEMETRY_Crc16(Raw, TELEMETRY_PAYLOAD_SIZE);
+		Raw[TELEMETRY_PAYLOAD_SIZE] = (uint8_t)Crc;
+		Raw[TELEMETRY_PAYLOAD_SIZE + 1U] = (uint8_t)(Crc >> 8);
+		size_t Length = TELEMETRY_CobsEncode(Raw, sizeof(Raw), Frame);
+		TEST_CHECK_EQ(TELEMETRY_Decode(Frame, Length, &Out), TELEMETRY_ERROR_VERSION);
+	}
+}
+
+/* Public functions ----------------------------------------------------------*/
+
+int main(void)
+{
+	TEST_Crc();
+	TEST_Cobs();
+	TEST_RoundTrip();
+	TEST_Rejection();
+	return TEST_RESULT();
+}
@@ -0,0 +1,179 @@
+/**
+  ******************************************************************************
+  * @file     : test_telemetry_log.cpp
+  * @author   : MS    Mateusz.Stasiak@student.put.poznan.pl
+  * @version  : 1.0.0
+  * @date     : Oct 17, 2026
+  * @brief    : Stream splitter of the telemetry logger on synthetic streams.
+  *
+  *             Frames whose COBS code byte is '\n' (first zero 9 bytes in, the
+  *             high byte of AdcRaw below 256) must not be split as text lines.
+  *             Frames are mixed with report and sample text lines, blank lines
+  *             and random chunking of the input; every frame and line must be
+  *             decoded exactly once.
+  *
+  ******************************************************************************
+  */
+
+/* Private includes ----------------------------------------------------------*/
+#include <cstdlib>
+#include <cstring>
+#include "test.h"
+#include "telemetry_stream.h"
+
+/* Private typedef -----------------------------------------------------------*/
+
+/* Private define ------------------------------------------------------------*/
+#define TEST_FRAMES     3000U
+#define TEST_SKIPPED    1234U   // sequence never sent, one lost frame
+#define TEST_PERIOD_MS  100U
+#define TEST_START_MS   0x01010101U // TimeMs has no zero byte in most frames
+
+/* Private macro -------------------------------------------------------------*/
+
+/* Private variables ---------------------------------------------------------*/
+static const char TEST_TextSample[] = "T: 25.1, PWM: 40, S: 30.0, P: 60.000, I: 40.000, D: 0.800\n";
+static const char TEST_Report[] = "J: N: 100, MIN: 99.9, MAX: 100.1, MEAN: 100.0, STD: 0.05 [us]\n";
+
+/* Private function prototypes -----------------------------------------------*/
+
+/* Private functions ---------------------------------------------------------*/
+
+static void TEST_AppendFrame(std::vector<uint8_t>& Stream, uint32_t Seq)
+{
+	TELEMETRY_SampleTypeDef Raw = {};
+	uint8_t Frame[TELEMETRY_FRAME_MAX];
+
+	Raw.Sequence = (uint16_t)Seq;
+	Raw.TimeMs = TEST_START_MS + Seq * TEST_PERIOD_MS;
+	Raw.AdcRaw = (uint16_t)(Seq % 256U);   // high byte zero: COBS code 0x0A
+	Raw.Duty = (uint16_t)(Seq % 101U);
+	Raw.Temperature = 20.0f + (float)Seq * 0.01f;
+	Raw.SetPoint = 30.0f;
+	Raw.P = 1.0f;
+	Raw.I = 2.0f;
+	Raw.D = 3.0f;
+	size_t Length = TELEMETRY_Encode(&Raw, Frame);
+	Stream.insert(Stream.end(), Frame, Frame + Length);
+}
+
+static void TEST_Append(std::vector<uint8_t>& Stream, const char *Text)
+{
+	Stream.insert(Stream.end(), Text, Text + std::strlen(Text));
+}
+
+/**
+ * @brief Feeds the stream in random chunks of 1..MaxChunk bytes.
+ */
+static Counters TEST_Decode(const std::vector<uint8_t>& Stream, size_t MaxChunk, std::vector<Sample>& Out)
+{
+	Config Cfg;
+	StreamDecoder Decoder(Cfg);
+
+	for (size_t Pos = 0; Pos < Stream.size();)
+	{
+		size_t Chunk = 1U + (size_t)std::rand() % MaxChunk;
+		if (Chunk > Stream.size() - Pos) Chunk = Stream.size() - Pos;
+		Decoder.Feed(Stream.data() + Pos, Chunk, [&](const Sample& S) { Out.push_back(S); });
+		Pos += Chunk;
+	}
+	return Decoder.GetStats();
+}
+
+/**
+ * @brief Frames only, nearly all starting with the code byte '\n'.
+ */
+static void TEST_Frames(void)
+{
+	std::vector<uint8_t> Stream;
+	uint32_t Newline = 0;
+
+	for (uint32_t Seq = 0; Seq < TEST_FRAMES; Seq++)
+	{
+		if (Seq == TEST_SKIPPED) continue;
+		size_t Start = Stream.size();
+		TEST_AppendFrame(Stream, Seq);
+		Newline += Stream[Start] == '\n';
+	}
+	TEST_CHECK(Newline > TEST_FRAMES * 9U / 10U, "only %u frames start with '\\n'", Newline);
+
+	for (size_t MaxChunk : { (size_t)1, (size_t)7, (size_t)64 * 1024 })
+	{
+		std::vector<Sample> Out;
+		Counters C = TEST_Decode(Stream, MaxChunk, Out);
+
+		TEST_CHECK_EQ(C.Frames, TEST_FRAMES - 1U);
+		TEST_CHECK_EQ(C.LostFrames, 1);
+		TEST_CHECK_EQ(C.BadFrames[TELEMETRY_ERROR_COBS] + C.BadFrames[TELEMETRY_ERROR_LENGTH] +
+				C.BadFrames[TELEMETRY_ERROR_CRC] + C.BadFrames[TELEMETRY_ERROR_VERSION], 0);
+		TEST_CHECK_EQ(C.OtherLines, 0);
+		TEST_CHECK_EQ(C.NoiseBytes, 0);
+		TEST_CHECK_EQ(Out.size(), TEST_FRAMES - 1U);
+		if (Out.size() != TEST_FRAMES - 1U) continue;
+
+		// The first frame starts the time base, the skipped one leaves a gap of one period
+		TEST_CHECK_EQ(Out.front().Sequence, 0);
+		TEST_CHECK(Out.front().Time == 0.0, "first frame at %g s", Out.front().Time);
+		uint32_t Bad = 0;
+		for (size_t i = 0; i < Out.size(); i++)
+		{
+			uint32_t Seq = (uint32_t)i + (i >= TEST_SKIPPED ? 1U : 0U);
+			Bad += !Out[i].Binary || Out[i].Sequence != Seq || Out[i].AdcRaw != (int32_t)(Seq % 256U) ||
+					std::fabs(Out[i].Time - Seq * TEST_PERIOD_MS * 1e-3) > 1e-9;
+		}
+		TEST_CHECK_EQ(Bad, 0);
+	}
+}
+
+/**
+ * @brief Frames, sample lines, reports and blank lines in one stream.
+ */
+static void TEST_Mixed(void)
+{
+	std::vector<uint8_t> Stream;
+	uint32_t Lines = 0, Reports = 0;
+
+	for (uint32_t Seq = 0; Seq < TEST_FRAMES; Seq++)
+	{
+		TEST_AppendFrame(Stream, Seq);
+		switch (Seq % 5U)
+		{
+		case 0: TEST_Append(Stream, TEST_TextSample); Lines++; break;
+		case 1: TEST_Append(Stream, TEST_Report); Reports++; break;
+		case 2: TEST_Append(Stream, "\n"); break;                                  // blank line after a frame
+		case 3: TEST_Append(Stream, "\n\n"); TEST_Append(Stream, TEST_TextSample); Lines++; break;
+		default: break;
+		}
+	}
+
+	for (size_t MaxChunk : { (size_t)1, (size_t)13, (size_t)64 * 1024 })
+	{
+		std::vector<Sample> Out;
+		Counters C = TEST_Decode(Stream, MaxChunk, Out);
+
+		TEST_CHECK_EQ(C.Frames, TEST_FRAMES);
+		TEST_CHECK_EQ(C.LostFrames, 0);
+		TEST_CHECK_EQ(C.BadFrames[TELEMETRY_ERROR_COBS] + C.BadFrames[TELEMETRY_ERROR_LENGTH] +
+				C.BadFrames[TELEMETRY_ERROR_CRC] + C.BadFrames[TELEMETRY_ERROR_VERSION], 0);
+		TEST_CHECK_EQ(C.TextSamples, Lines);
+		TEST_CHECK_EQ(C.OtherLines, Reports);
+		TEST_CHECK_EQ(Out.size(), TEST_FRAMES + Lines);
+
+		uint32_t Bad = 0;
+		for (const Sample& S : Out)
+		{
+			if (!S.Binary) Bad += S.Duty != 40 || S.SetPoint != 30.0f || S.Kd != 0.8f;
+		}
+		TEST_CHECK_EQ(Bad, 0);
+	}
+}
+
+/* Public functions ----------------------------------------------------------*/
+
+int main(void)
+{
+	std::srand(1);
+	TEST_Frames();
+	TEST_Mixed();
+	return TEST_RESULT();
+}
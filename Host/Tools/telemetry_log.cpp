@@ -0,0 +1,420 @@
+/**
+  ******************************************************************************
+  * @file     : telemetry_log.cpp
+  * @author   : MS    Mateusz.Stasiak@student.put.poznan.pl
+  * @version  : 1.0.0
+  * @date     : Oct 17, 2026
+  * @brief    : Telemetry decoder and logger with step-response analytics.
+  *
+  *             Reads the CM7 USART3 stream from a serial device, a recorded file
+  *             or stdin. COBS frames (telemetry.h) and the "T: .., PWM: .." text
+  *             lines may be mixed in one stream; other text lines (jitter and
+  *             probe reports) are counted and skipped. Every sample becomes one
+  *             CSV row, and each setpoint change is scored by rise time,
+  *             overshoot, settling time, IAE and ISE.
+  *
+  ******************************************************************************
+  */
+
+/* Private includes ----------------------------------------------------------*/
+#include <cerrno>
+#include <charconv>
+#include <cmath>
+#include <csignal>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string_view>
+#include <vector>
+#include <fcntl.h>
+#include <termios.h>
+#include <unistd.h>
+#include "telemetry_stream.h"
+
+/* Private typedef -----------------------------------------------------------*/
+namespace {
+
+constexpr size_t ReadChunk = 64 * 1024;
+constexpr size_t WriterBuffer = 1 << 20;
+constexpr float SetPointEpsilon = 1e-3f;  // [degC], smaller changes are not steps
+
+struct StepResult {
+	double Start = 0.0;     // [s]
+	double Duration = 0.0;  // [s] until the next step or the end of the log
+	float From = Nan, To = Nan;
+	float Initial = Nan;    // temperature when the step was applied
+	double RiseTime = Nan;  // [s] 10 % -> 90 % of To - Initial
+	float Overshoot = Nan;  // [degC] past To in the step direction, 0 if none
+	double SettlingTime = Nan; // [s] until the error stays within the band, NaN if it never does
+	double IAE = 0.0;       // [degC*s]
+	double ISE = 0.0;       // [degC^2*s]
+};
+
+/* Private variables ---------------------------------------------------------*/
+volatile std::sig_atomic_t StopRequested = 0;
+
+/* Private functions ---------------------------------------------------------*/
+
+/**
+ * @brief Buffered CSV output; numbers go through to_chars, floats in their shortest exact form.
+ */
+class CsvWriter {
+public:
+	explicit CsvWriter(FILE *File) : File(File) { Buffer.reserve(WriterBuffer); }
+	~CsvWriter() { Flush(); }
+
+	void Text(std::string_view Str) { Buffer.insert(Buffer.end(), Str.begin(), Str.end()); }
+	void Separator() { Buffer.push_back(','); }
+	void EndRow()
+	{
+		Buffer.push_back('\n');
+		if (Buffer.size() > WriterBuffer - 256) Flush();
+	}
+
+	template <typename T> void Number(T Value)
+	{
+		char Tmp[64];
+		auto Result = std::to_chars(Tmp, Tmp + sizeof(Tmp), Value);
+		Buffer.insert(Buffer.end(), Tmp, Result.ptr);
+	}
+
+	/* Missing values (NaN or negative markers) are written as empty fields */
+	void Float(double Value) { if (!std::isnan(Value)) Number(Value); }
+	void Float(float Value) { if (!std::isnan(Value)) Number(Value); }
+	void Optional(int64_t Value) { if (Value >= 0) Number(Value); }
+
+	void Flush()
+	{
+		if (File != nullptr && !Buffer.empty()) fwrite(Buffer.data(), 1, Buffer.size(), File);
+		Buffer.clear();
+	}
+
+private:
+	FILE *File;
+	std::vector<char> Buffer;
+};
+
+/**
+ * @brief Scores each setpoint step from the samples that follow it.
+ * @note Binary and text samples have separate time bases, so a log should hold one kind.
+ */
+class StepAnalyzer {
+public:
+	explicit StepAnalyzer(float Band) : Band(Band) {}
+
+	void Add(const Sample& S)
+	{
+		if (std::isnan(S.SetPoint) || std::isnan(S.Temperature)) return;
+
+		if (!HaveSetPoint)
+		{
+			HaveSetPoint = true;
+			SetPoint = S.SetPoint;
+		}
+		else if (std::fabs(S.SetPoint - SetPoint) > SetPointEpsilon)
+		{
+			if (Active) Close(S.Time);
+			Open(S, SetPoint);
+			SetPoint = S.SetPoint;
+		}
+		if (Active) Update(S);
+		LastTime = S.Time;
+	}
+
+	void Finish()
+	{
+		if (Active) Close(LastTime);
+	}
+
+	const std::vector<StepResult>& Results() const { return Steps; }
+
+private:
+	void Open(const Sample& S, float From)
+	{
+		Current = StepResult();
+		Current.Start = S.Time;
+		Current.From = From;
+		Current.To = S.SetPoint;
+		Current.Initial = S.Temperature;
+		Current.Overshoot = 0.0f;
+		PrevTime = S.Time;
+		Time10 = Nan;
+		EnteredBand = Nan;
+		Active = true;
+	}
+
+	void Update(const Sample& S)
+	{
+		double Dt = S.Time - PrevTime;
+		PrevTime = S.Time;
+		double Elapsed = S.Time - Current.Start;
+		float Error = Current.To - S.Temperature;
+
+		Current.IAE += std::fabs(Error) * Dt;
+		Current.ISE += (double)Error * Error * Dt;
+
+		float Amplitude = Current.To - Current.Initial;
+		float Direction = (Amplitude >= 0.0f) ? 1.0f : -1.0f;
+		if (std::fabs(Amplitude) > Band && std::isnan(Current.RiseTime))
+		{
+			float Progress = (S.Temperature - Current.Initial) / Amplitude;
+			if (std::isnan(Time10) && Progress >= 0.1f) Time10 = Elapsed;
+			if (!std::isnan(Time10) && Progress >= 0.9f) Current.RiseTime = Elapsed - Time10;
+		}
+
+		float Excursion = -Error * Direction;
+		if (Excursion > Current.Overshoot) Current.Overshoot = Excursion;
+
+		// Settling time is the start of the last run of samples inside the band
+		if (std::fabs(Error) > Band) EnteredBand = Nan;
+		else if (std::isnan(EnteredBand)) EnteredBand = Elapsed;
+	}
+
+	void Close(double End)
+	{
+		Current.Duration = End - Current.Start;
+		Current.SettlingTime = EnteredBand;
+		Steps.push_back(Current);
+		Active = false;
+	}
+
+	float Band;
+	bool HaveSetPoint = false, Active = false;
+	float SetPoint = Nan;
+	double LastTime = 0.0, PrevTime = 0.0;
+	double Time10 = Nan, EnteredBand = Nan;
+	StepResult Current;
+	std::vector<StepResult> Steps;
+};
+
+void OnSignal(int)
+{
+	StopRequested = 1;
+}
+
+speed_t BaudToSpeed(unsigned Baud)
+{
+	switch (Baud)
+	{
+	case 9600: return B9600;
+	case 19200: return B19200;
+	case 38400: return B38400;
+	case 57600: return B57600;
+	case 115200: return B115200;
+	case 230400: return B230400;
+	case 460800: return B460800;
+	case 921600: return B921600;
+	default: return 0;
+	}
+}
+
+/**
+ * @brief Opens the input; serial devices are switched to raw 8N1 at the requested baud rate.
+ * @return File descriptor or -1.
+ */
+int OpenInput(const Config& Cfg)
+{
+	if (std::strcmp(Cfg.Input, "-") == 0) return STDIN_FILENO;
+
+	int Fd = open(Cfg.Input, O_RDONLY | O_NOCTTY);
+	if (Fd < 0 || !isatty(Fd)) return Fd;
+
+	termios Tty;
+	speed_t Speed = BaudToSpeed(Cfg.Baud);
+	if (Speed == 0)
+	{
+		std::fprintf(stderr, "unsupported baud rate %u\n", Cfg.Baud);
+		close(Fd);
+		return -1;
+	}
+	if (tcgetattr(Fd, &Tty) != 0)
+	{
+		close(Fd);
+		return -1;
+	}
+	cfmakeraw(&Tty);
+	cfsetispeed(&Tty, Speed);
+	cfsetospeed(&Tty, Speed);
+	Tty.c_cflag |= CLOCAL | CREAD;
+	Tty.c_cc[VMIN] = 1;
+	Tty.c_cc[VTIME] = 0;
+	if (tcsetattr(Fd, TCSANOW, &Tty) != 0)
+	{
+		close(Fd);
+		return -1;
+	}
+	tcflush(Fd, TCIFLUSH);
+	return Fd;
+}
+
+void WriteSampleHeader(CsvWriter& Csv)
+{
+	Csv.Text("t_s,source,seq,adc_raw,temperature,setpoint,duty,p_term,i_term,d_term,kp,ki,kd");
+	Csv.EndRow();
+}
+
+void WriteSample(CsvWriter& Csv, const Sample& S)
+{
+	Csv.Number(S.Time);          Csv.Separator();
+	Csv.Text(S.Binary ? "bin" : "text"); Csv.Separator();
+	Csv.Optional(S.Sequence);    Csv.Separator();
+	Csv.Optional(S.AdcRaw);      Csv.Separator();
+	Csv.Float(S.Temperature);    Csv.Separator();
+	Csv.Float(S.SetPoint);       Csv.Separator();
+	Csv.Optional(S.Duty);        Csv.Separator();
+	Csv.Float(S.P);              Csv.Separator();
+	Csv.Float(S.I);              Csv.Separator();
+	Csv.Float(S.D);              Csv.Separator();
+	Csv.Float(S.Kp);             Csv.Separator();
+	Csv.Float(S.Ki);             Csv.Separator();
+	Csv.Float(S.Kd);
+	Csv.EndRow();
+}
+
+void WriteSteps(CsvWriter& Csv, const std::vector<StepResult>& Steps)
+{
+	Csv.Text("start_s,duration_s,from,to,initial,rise_s,overshoot,settling_s,iae,ise");
+	Csv.EndRow();
+	for (const StepResult& R : Steps)
+	{
+		Csv.Number(R.Start);      Csv.Separator();
+		Csv.Number(R.Duration);   Csv.Separator();
+		Csv.Float(R.From);        Csv.Separator();
+		Csv.Float(R.To);          Csv.Separator();
+		Csv.Float(R.Initial);     Csv.Separator();
+		Csv.Float(R.RiseTime);    Csv.Separator();
+		Csv.Float(R.Overshoot);   Csv.Separator();
+		Csv.Float(R.SettlingTime); Csv.Separator();
+		Csv.Number(R.IAE);        Csv.Separator();
+		Csv.Number(R.ISE);
+		Csv.EndRow();
+	}
+}
+
+void PrintSummary(const Config& Cfg, const Counters& C, const std::vector<StepResult>& Steps)
+{
+	std::printf("bytes: %llu, frames: %llu, lost: %llu, text samples: %llu, other lines: %llu, noise bytes: %llu\n",
+			(unsigned long long)C.Bytes, (unsigned long long)C.Frames, (unsigned long long)C.LostFrames,
+			(unsigned long long)C.TextSamples, (unsigned long long)C.OtherLines, (unsigned long long)C.NoiseBytes);
+	std::printf("rejected frames: cobs %llu, length %llu, crc %llu, version %llu\n",
+			(unsigned long long)C.BadFrames[TELEMETRY_ERROR_COBS], (unsigned long long)C.BadFrames[TELEMETRY_ERROR_LENGTH],
+			(unsigned long long)C.BadFrames[TELEMETRY_ERROR_CRC], (unsigned long long)C.BadFrames[TELEMETRY_ERROR_VERSION]);
+	if (Steps.empty()) return;
+
+	std::printf("%10s %8s %8s %8s %9s %10s %11s %10s %10s\n", "start [s]", "from", "to", "rise [s]",
+			"over [C]", "over [%]", "settle [s]", "IAE", "ISE");
+	for (const StepResult& R : Steps)
+	{
+		float Amplitude = std::fabs(R.To - R.Initial);
+		double Percent = (Amplitude > 0.0f) ? 100.0 * R.Overshoot / Amplitude : Nan;
+		std::printf("%10.1f %8.2f %8.2f %8.1f %9.2f %10.1f %11.1f %10.1f %10.1f\n", R.Start, R.From, R.To,
+				R.RiseTime, R.Overshoot, Percent, R.SettlingTime, R.IAE, R.ISE);
+	}
+	std::printf("settling band: +-%.2f degC, nan = not reached before the next step\n", Cfg.Band);
+}
+
+void Usage(const char *Name)
+{
+	std::fprintf(stderr,
+		"usage: %s [-b baud] [-c samples.csv] [-s steps.csv] [-p text_period_s] [-B band] input\n"
+		"       input is a serial device, a recorded file or - for stdin\n", Name);
+}
+
+} // namespace
+
+/* Public functions ----------------------------------------------------------*/
+
+int main(int argc, char **argv)
+{
+	Config Cfg;
+	int Opt;
+
+	while ((Opt = getopt(argc, argv, "b:c:s:p:B:")) != -1)
+	{
+		switch (Opt)
+		{
+		case 'b': Cfg.Baud = (unsigned)std::strtoul(optarg, nullptr, 10); break;
+		case 'c': Cfg.CsvPath = optarg; break;
+		case 's': Cfg.StepsPath = optarg; break;
+		case 'p': Cfg.TextPeriod = std::atof(optarg); break;
+		case 'B': Cfg.Band = std::strtof(optarg, nullptr); break;
+		default: Usage(argv[0]); return 2;
+		}
+	}
+	if (optind != argc - 1)
+	{
+		Usage(argv[0]);
+		return 2;
+	}
+	Cfg.Input = argv[optind];
+
+	int Fd = OpenInput(Cfg);
+	if (Fd < 0)
+	{
+		std::perror(Cfg.Input);
+		return 1;
+	}
+
+	FILE *CsvFile = nullptr;
+	if (Cfg.CsvPath != nullptr)
+	{
+		CsvFile = std::fopen(Cfg.CsvPath, "w");
+		if (CsvFile == nullptr)
+		{
+			std::perror(Cfg.CsvPath);
+			return 1;
+		}
+	}
+
+	// A live device is read until Ctrl+C, which must still flush and print the analysis
+	struct sigaction Action = {};
+	Action.sa_handler = OnSignal;
+	sigaction(SIGINT, &Action, nullptr);
+	sigaction(SIGTERM, &Action, nullptr);
+
+	StreamDecoder Decoder(Cfg);
+	StepAnalyzer Analyzer(Cfg.Band);
+	{
+		CsvWriter Csv(CsvFile);
+		if (CsvFile != nullptr) WriteSampleHeader(Csv);
+
+		std::vector<uint8_t> Chunk(ReadChunk);
+		while (!StopRequested)
+		{
+			ssize_t n = read(Fd, Chunk.data(), Chunk.size());
+			if (n == 0) break;
+			if (n < 0)
+			{
+				if (errno == EINTR) continue;
+				std::perror(Cfg.Input);
+				break;
+			}
+			Decoder.Feed(Chunk.data(), (size_t)n, [&](const Sample& S) {
+				if (CsvFile != nullptr) WriteSample(Csv, S);
+				Analyzer.Add(S);
+			});
+		}
+		Analyzer.Finish();
+	}
+	if (CsvFile != nullptr) std::fclose(CsvFile);
+	if (Fd != STDIN_FILENO) close(Fd);
+
+	if (Cfg.StepsPath != nullptr)
+	{
+		FILE *StepsFile = std::fopen(Cfg.StepsPath, "w");
+		if (StepsFile == nullptr)
+		{
+			std::perror(Cfg.StepsPath);
+			return 1;
+		}
+		{
+			CsvWriter Csv(StepsFile);
+			WriteSteps(Csv, Analyzer.Results());
+		}
+		std::fclose(StepsFile);
+	}
+
+	PrintSummary(Cfg, Decoder.GetStats(), Analyzer.Results());
+	return 0;
+}
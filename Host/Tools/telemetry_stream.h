@@ -0,0 +1,212 @@
+/**
+  ******************************************************************************
+  * @file     : telemetry_stream.h
+  * @author   : MS    Mateusz.Stasiak@student.put.poznan.pl
+  * @version  : 1.0.0
+  * @date     : Oct 17, 2026
+  * @brief    : Splitter and decoder of the mixed COBS / text telemetry stream.
+  *
+  *             Shared by telemetry_log.cpp and its host test, so the test feeds
+  *             the exact splitter the logger uses.
+  *
+  ******************************************************************************
+  */
+
+#ifndef HOST_TOOLS_TELEMETRY_STREAM_H_
+#define HOST_TOOLS_TELEMETRY_STREAM_H_
+
+/* Public includes -----------------------------------------------------------*/
+#include <charconv>
+#include <cmath>
+#include <cstdint>
+#include <string_view>
+#include <vector>
+#include "telemetry.h"
+
+/* Public typedef ------------------------------------------------------------*/
+constexpr size_t PendingMax = 512;        // longer runs without a delimiter are noise
+constexpr float Nan = NAN;
+
+
+struct Config {
+	const char *Input = nullptr;
+	const char *CsvPath = nullptr;
+	const char *StepsPath = nullptr;
+	unsigned Baud = 115200;
+	double TextPeriod = 0.1; // [s], text lines carry no timestamp, one line per control period
+	float Band = 0.5f;       // [degC], settling band
+};
+
+/* One decoded sample; fields the source does not carry are NaN */
+struct Sample {
+	bool Binary = false;
+	double Time = 0.0;      // [s] since the first sample of the same kind
+	int64_t Sequence = -1;
+	int32_t AdcRaw = -1;
+	float Temperature = Nan, SetPoint = Nan;
+	int32_t Duty = -1;
+	float P = Nan, I = Nan, D = Nan;     // controller terms, binary frames only
+	float Kp = Nan, Ki = Nan, Kd = Nan;  // gains, text lines only
+};
+
+struct Counters {
+	uint64_t Bytes = 0;
+	uint64_t Frames = 0;
+	uint64_t BadFrames[TELEMETRY_ERROR_VERSION + 1] = {};
+	uint64_t LostFrames = 0;  // sequence gaps
+	uint64_t TextSamples = 0;
+	uint64_t OtherLines = 0;
+	uint64_t NoiseBytes = 0;  // discarded without a delimiter
+};
+
+/**
+ * @brief Splits the byte stream into COBS frames and text lines and decodes both.
+ *
+ * A 0x00 ends a binary frame. A '\n' ends a text line only if something is
+ * pending and all of it is printable; otherwise it is a byte inside a frame.
+ * A '\n' with nothing pending is either a blank line or the COBS code of a
+ * frame whose first zero is 9 bytes in. The byte after it decides: such a
+ * frame goes on with TELEMETRY_VERSION, anything else makes it a blank line.
+ */
+class StreamDecoder {
+public:
+	explicit StreamDecoder(const Config& Cfg) : Cfg(Cfg) { Pending.reserve(PendingMax); }
+
+	template <typename Sink> void Feed(const uint8_t *Data, size_t Length, Sink&& Emit)
+	{
+		Stats.Bytes += Length;
+		for (size_t i = 0; i < Length; i++)
+		{
+			uint8_t Byte = Data[i];
+			if (Pending.size() == 1U && Pending[0] == '\n' && Byte != TELEMETRY_VERSION) Pending.clear(); // blank line
+			if (Byte == TELEMETRY_DELIMITER)
+			{
+				Frame(Emit);
+			}
+			else if (Byte == '\n' && Printable && !Pending.empty())
+			{
+				Line(Emit);
+			}
+			else
+			{
+				if (Pending.size() == PendingMax) Discard();
+				if (Byte != '\r' && Byte != '\n' && (Byte < 0x20 || Byte > 0x7E)) Printable = false;
+				Pending.push_back(Byte);
+			}
+		}
+	}
+
+	const Counters& GetStats() const { return Stats; }
+
+private:
+	void Discard()
+	{
+		Stats.NoiseBytes += Pending.size();
+		Pending.clear();
+		Printable = true;
+	}
+
+	template <typename Sink> void Frame(Sink&& Emit)
+	{
+		if (Pending.empty()) return;
+		TELEMETRY_SampleTypeDef Raw;
+		TELEMETRY_StatusTypeDef Status = TELEMETRY_Decode(Pending.data(), Pending.size(), &Raw);
+		Pending.clear();
+		Printable = true;
+		if (Status != TELEMETRY_OK)
+		{
+			Stats.BadFrames[Status]++;
+			return;
+		}
+
+		// The 16-bit sequence is unwrapped from the distance to the previous frame
+		Stats.Frames++;
+		if (HaveSequence)
+		{
+			uint16_t Distance = (uint16_t)(Raw.Sequence - LastSequence);
+			Stats.LostFrames += Distance - 1U;
+			Sequence += Distance;
+		}
+		else Sequence = Raw.Sequence;
+		LastSequence = Raw.Sequence;
+		HaveSequence = true;
+
+		// HAL tick wraps after 49.7 days
+		if (HaveTime && Raw.TimeMs < LastTimeMs) TimeBase += 1ULL << 32;
+		if (!HaveTime) FirstTime = Raw.TimeMs;
+		LastTimeMs = Raw.TimeMs;
+		HaveTime = true;
+
+		Sample S;
+		S.Binary = true;
+		S.Time = (double)(TimeBase + Raw.TimeMs - FirstTime) * 1e-3;
+		S.Sequence = Sequence;
+		S.AdcRaw = Raw.AdcRaw;
+		S.Temperature = Raw.Temperature;
+		S.SetPoint = Raw.SetPoint;
+		S.Duty = Raw.Duty;
+		S.P = Raw.P;
+		S.I = Raw.I;
+		S.D = Raw.D;
+		Emit(S);
+	}
+
+	template <typename Sink> void Line(Sink&& Emit)
+	{
+		std::string_view Text(reinterpret_cast<const char*>(Pending.data()), Pending.size());
+		Sample S;
+		if (ParseText(Text, S))
+		{
+			S.Time = (double)Stats.TextSamples * Cfg.TextPeriod;
+			S.Sequence = (int64_t)Stats.TextSamples;
+			Stats.TextSamples++;
+			Emit(S);
+		}
+		else if (!Text.empty())
+		{
+			Stats.OtherLines++;
+		}
+		Pending.clear();
+		Printable = true;
+	}
+
+	/**
+	 * @brief Reads the number after Key, e.g. Key = "PWM: ".
+	 */
+	static bool Field(std::string_view Text, std::string_view Key, float& Value)
+	{
+		size_t Pos = Text.find(Key);
+		if (Pos == std::string_view::npos) return false;
+		const char *First = Text.data() + Pos + Key.size();
+		auto Result = std::from_chars(First, Text.data() + Text.size(), Value);
+		return Result.ec == std::errc();
+	}
+
+	/**
+	 * @brief Parses "T: 25.1, PWM: 40, S: 30.0, P: 60.000, I: 40.000, D: 0.800".
+	 */
+	static bool ParseText(std::string_view Text, Sample& S)
+	{
+		float Duty;
+		if (Text.substr(0, 3) != "T: ") return false;
+		if (!Field(Text, "T: ", S.Temperature) || !Field(Text, ", PWM: ", Duty) ||
+			!Field(Text, ", S: ", S.SetPoint)) return false;
+		S.Duty = (int32_t)Duty;
+		Field(Text, ", P: ", S.Kp);
+		Field(Text, ", I: ", S.Ki);
+		Field(Text, ", D: ", S.Kd);
+		return true;
+	}
+
+	const Config& Cfg;
+	std::vector<uint8_t> Pending;
+	bool Printable = true;
+	Counters Stats;
+	bool HaveSequence = false, HaveTime = false;
+	uint16_t LastSequence = 0;
+	int64_t Sequence = 0;
+	uint32_t FirstTime = 0, LastTimeMs = 0;
+	uint64_t TimeBase = 0;
+};
+
+#endif /* HOST_TOOLS_TELEMETRY_STREAM_H_ */